@@ -0,0 +1,47 @@
+// Reemplazo de operator new que cuenta las reservas y los bytes pedidos en
+// las estadísticas (stats.hpp). Solo lo enlazan los ejecutables: los
+// benchmarks que miden memoria enlazan live_memory.cpp.
+
+#include <cstdlib>
+#include <new>
+
+#include "stats.hpp"
+
+#if MUSIC_STATS
+
+static void* allocate(std::size_t size){
+    count(Counter::Allocation);
+    count(Counter::AllocatedBytes, size);
+
+    void* pointer = std::malloc(size != 0 ? size : 1);
+    if (pointer == nullptr){
+        throw std::bad_alloc{};
+    }
+    return pointer;
+}
+
+void* operator new(std::size_t size){
+    return allocate(size);
+}
+
+void* operator new[](std::size_t size){
+    return allocate(size);
+}
+
+void operator delete(void* pointer) noexcept{
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept{
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept{
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t) noexcept{
+    std::free(pointer);
+}
+
+#endif
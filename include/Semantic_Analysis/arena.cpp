@@ -0,0 +1,63 @@
+#include "arena.hpp"
+
+#include <cstdint>
+
+Arena::Arena(std::size_t _block_size) noexcept
+    : block_size(_block_size), last_finalizer(nullptr), cursor(nullptr), limit(nullptr), allocated(0)
+{
+}
+
+Arena::~Arena() noexcept
+{
+    release();
+}
+
+void* Arena::allocate(std::size_t size, std::size_t alignment) noexcept{
+    auto current = reinterpret_cast<std::uintptr_t>(cursor);
+    auto aligned = (current + alignment - 1) & ~(static_cast<std::uintptr_t>(alignment) - 1);
+
+    if (cursor == nullptr || aligned + size > reinterpret_cast<std::uintptr_t>(limit))
+    {
+        add_block(size + alignment);
+        current = reinterpret_cast<std::uintptr_t>(cursor);
+        aligned = (current + alignment - 1) & ~(static_cast<std::uintptr_t>(alignment) - 1);
+    }
+
+    cursor = reinterpret_cast<char*>(aligned + size);
+    allocated += size;
+    return reinterpret_cast<void*>(aligned);
+}
+
+void Arena::release() noexcept{
+    // Los destructores se ejecutan en orden inverso a la construcción
+    for (Finalizer* finalizer = last_finalizer; finalizer != nullptr; finalizer = finalizer->previous){
+        finalizer->destructor(finalizer->object);
+    }
+    last_finalizer = nullptr;
+
+    for (Block& block : blocks){
+        ::operator delete(block.data);
+    }
+    blocks.clear();
+
+    cursor = nullptr;
+    limit = nullptr;
+    allocated = 0;
+}
+
+std::size_t Arena::bytes_allocated() const noexcept{
+    return allocated;
+}
+
+std::size_t Arena::block_count() const noexcept{
+    return blocks.size();
+}
+
+void Arena::add_block(std::size_t min_size) noexcept{
+    std::size_t size = min_size > block_size ? min_size : block_size;
+    char* data = static_cast<char*>(::operator new(size));
+
+    blocks.push_back(Block{data, size});
+    cursor = data;
+    limit = data + size;
+}
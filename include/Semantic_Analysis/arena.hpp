@@ -0,0 +1,117 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Tipos con cuenta de referencias que la arena debe fijar al crearlos
+template <typename Type, typename = void>
+struct is_pinnable : std::false_type
+{
+};
+
+template <typename Type>
+struct is_pinnable<Type, std::void_t<decltype(std::declval<const Type&>().pin())>> : std::true_type
+{
+};
+
+// Asignador por bloques (bump allocator) dueño de todos los nodos del AST de
+// una unidad de compilación. Crear un nodo cuesta avanzar un puntero.
+//
+// La liberación solo es una operación en bloque para los tipos trivialmente
+// destructibles (por ejemplo, los Symbol de SymbolTable). Los nodos del AST
+// no lo son (destructor virtual; Body, ParamList y std::string como miembros),
+// así que make() encadena un finalizador por nodo y release() los recorre uno
+// a uno antes de soltar los bloques: se ahorra el delete de cada nodo, no el
+// recorrido. El parser y el análisis semántico construyen sus nodos con new.
+//
+// Los nodos creados con make() pertenecen a la arena, que los fija (pin()):
+// release(), destroy_body, replace_statement, replace_node y las estructuras
+// que retienen nodos (IncrementalAnalysis, NodeInterner) solo mueven su cuenta
+// de referencias y nunca llaman a destroy() ni a delete sobre ellos. NO se
+// debe llamar a destroy() ni a delete directamente. Se liberan todos juntos
+// con release() o al destruir la arena, así que todo lo que retenga un nodo
+// de la arena debe soltarlo antes. Sus hijos también deben ser de la arena:
+// un nodo fijado nunca suelta las referencias a sus hijos.
+class Arena
+{
+public:
+    static constexpr std::size_t default_block_size = 64 * 1024;
+
+    explicit Arena(std::size_t _block_size = default_block_size) noexcept;
+
+    ~Arena() noexcept;
+
+    Arena(const Arena&) = delete;
+
+    Arena& operator=(const Arena&) = delete;
+
+    // Reservar memoria cruda alineada dentro de la arena
+    void* allocate(std::size_t size, std::size_t alignment) noexcept;
+
+    // Construir un objeto dentro de la arena
+    template <typename Type, typename... Args>
+    Type* make(Args&&... args) noexcept
+    {
+        if constexpr (std::is_trivially_destructible_v<Type>)
+        {
+            void* memory = allocate(sizeof(Type), alignof(Type));
+            return new (memory) Type(std::forward<Args>(args)...);
+        }
+        else
+        {
+            // El finalizador se guarda justo antes del objeto, en la misma arena
+            auto finalizer = static_cast<Finalizer*>(allocate(sizeof(Finalizer), alignof(Finalizer)));
+            void* memory = allocate(sizeof(Type), alignof(Type));
+            Type* object = new (memory) Type(std::forward<Args>(args)...);
+
+            finalizer->object = object;
+            finalizer->destructor = [](void* ptr) noexcept {
+                static_cast<Type*>(ptr)->~Type();
+            };
+            finalizer->previous = last_finalizer;
+            last_finalizer = finalizer;
+            if constexpr (is_pinnable<Type>::value)
+            {
+                object->pin();
+            }
+            return object;
+        }
+    }
+
+    // Ejecutar los finalizadores pendientes y liberar todos los bloques
+    void release() noexcept;
+
+    // Bytes entregados por allocate (sin contar el relleno de los bloques)
+    std::size_t bytes_allocated() const noexcept;
+
+    std::size_t block_count() const noexcept;
+
+private:
+    using Destructor = void (*)(void*) noexcept;
+
+    struct Block
+    {
+        char* data;
+        std::size_t size;
+    };
+
+    // Lista enlazada intrusiva de destructores pendientes
+    struct Finalizer
+    {
+        void* object;
+        Destructor destructor;
+        Finalizer* previous;
+    };
+
+    void add_block(std::size_t min_size) noexcept;
+
+    std::size_t block_size;
+    std::vector<Block> blocks;
+    Finalizer* last_finalizer;
+    char* cursor;
+    char* limit;
+    std::size_t allocated;
+};
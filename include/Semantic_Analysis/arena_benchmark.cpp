@@ -0,0 +1,103 @@
+/*
+    Compilador Musical: Benchmark de la arena del AST
+
+    Genera una partitura de N notas (1M por defecto) como un Body de
+    DeclarationStatement -> NoteDeclaration y compara el tiempo de construcción
+    y de liberación entre:
+      - el camino actual (new por nodo + destroy_body)
+      - la arena (avance de puntero por nodo + release, que ejecuta un
+        finalizador por nodo y suelta los bloques)
+
+    Uso: ./arena_benchmark [cantidad_de_notas]
+*/
+
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "arena.hpp"
+#include "benchmark_support.hpp"
+#include "declaration.hpp"
+#include "statement.hpp"
+
+static const char pitches[] = {'C', 'D', 'E', 'F', 'G', 'A', 'B'};
+static const char* durations[] = {"Blanca", "Negra", "Corchea", "Semicorchea"};
+
+static void print_row(const std::string& label, double build_ms, double teardown_ms) {
+    print_label(label, 12);
+    print_ms(build_ms);
+    print_ms(teardown_ms);
+    print_ms(build_ms + teardown_ms);
+    print_end();
+}
+
+int main(int argc, char** argv){
+    long note_count = argc > 1 ? std::atol(argv[1]) : 1000000;
+    if (note_count <= 0) {
+        std::cerr << "Uso: " << argv[0] << " [cantidad_de_notas]" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "====== Benchmark de la arena del AST (" << note_count << " notas) ======" << std::endl;
+    print_label("modo", 12);
+    print_text(" construcción");
+    print_text("   liberación");
+    print_text("        total");
+    print_end();
+
+    // Los nombres se internan fuera de la medición para aislar el costo de asignación
+    std::vector<NameId> names;
+    names.reserve(note_count);
+    for (long i = 0; i < note_count; ++i) {
+        names.push_back(intern_name("nota" + std::to_string(i)));
+    }
+    NameId duration_ids[4];
+    for (int i = 0; i < 4; ++i) {
+        duration_ids[i] = intern_name(durations[i]);
+    }
+
+    // Camino actual: new por nodo y destroy_body recursivo
+    {
+        auto start = Clock::now();
+        Body program;
+        auto tail = program.before_begin();
+        for (long i = 0; i < note_count; ++i) {
+            auto note = new NoteDeclaration{
+                names[i], pitches[i % 7], static_cast<int>(i % 9), duration_ids[i % 4]
+            };
+            tail = program.insert_after(tail, new DeclarationStatement{note});
+        }
+        auto built = Clock::now();
+
+        destroy_body(program);
+        auto released = Clock::now();
+
+        print_row("new/delete", elapsed_ms(start, built), elapsed_ms(built, released));
+    }
+
+    // Arena: un avance de puntero por nodo; la liberación sigue recorriendo los
+    // finalizadores (los nodos no son trivialmente destructibles)
+    {
+        auto start = Clock::now();
+        Arena arena;
+        Body program;
+        auto tail = program.before_begin();
+        for (long i = 0; i < note_count; ++i) {
+            auto note = arena.make<NoteDeclaration>(
+                names[i], pitches[i % 7], static_cast<int>(i % 9), duration_ids[i % 4]
+            );
+            tail = program.insert_after(tail, arena.make<DeclarationStatement>(note));
+        }
+        auto built = Clock::now();
+
+        program.clear();
+        arena.release();
+        auto released = Clock::now();
+
+        print_row("arena", elapsed_ms(start, built), elapsed_ms(built, released));
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -1,40 +1,44 @@
 #include "ast_node_interface.hpp"
 
 #include "datatype.hpp"
+#include "declaration.hpp"
+#include "note_stream.hpp"
 #include "statement.hpp"
 #include "symbol_table.hpp"
 #include <algorithm>
-#include <unordered_set> 
-
-// Variable global para rastrear los nodos visitados 
-static std::unordered_set<void*> visited_nodes;
 
 void destroy_body(Body& body) noexcept{
     while (!body.empty()){
         Statement* statement = body.front();
         body.pop_front();
-        statement->destroy();
-        delete statement;
+        release(statement);
     }
 }
 
 Body copy_body(const Body& body) noexcept{
     Body result;
+    auto tail = result.before_begin();
 
     for (auto statement : body){
-        result.push_front(dynamic_cast<Statement*>(statement->copy()));
+        tail = result.insert_after(tail, cast<Statement>(statement->copy()));
     }
     
-    result.reverse(); // Para mantener el orden 
     return result;
 }
 
+void replace_statement(Body& body, Body::iterator position, Statement* statement) noexcept{
+    Statement* old = *position;
+    *position = statement;
+    release(old);
+}
+
 bool equal_body(const Body& body1, const Body& body2) noexcept{
     auto it1 = body1.begin();
     auto it2 = body2.begin();
     
     while (it1 != body1.end() && it2 != body2.end()) {
-        if (!(*it1)->equal(*it2)) 
+        // Dos sentencias con distinto hash se rechazan sin recorrerlas
+        if ((*it1)->hash() != (*it2)->hash() || !(*it1)->equal(*it2)) 
         {
             return false;
         }
@@ -46,17 +50,17 @@ bool equal_body(const Body& body1, const Body& body2) noexcept{
     return it1 == body1.end() && it2 == body2.end();
 }
 
+std::uint64_t body_hash(const Body& body) noexcept{
+    std::uint64_t hash = 0;
+    for (const Statement* statement : body){
+        hash = hash_mix(hash, statement->hash());
+    }
+    return hash;
+}
+
 std::pair<bool, Datatype*> body_type_check(const Body& body) noexcept{
     for (auto stmt : body){
-        auto stmt_type = stmt->type_check();
-
-        if (stmt_type.second != nullptr)
-        {
-            delete stmt_type.second;
-            stmt_type.second = nullptr;
-        }
-
-        if (!stmt_type.first)
+        if (!stmt->memoized_type_check())
         {
             return std::make_pair(false, nullptr);
         }
@@ -66,41 +70,37 @@ std::pair<bool, Datatype*> body_type_check(const Body& body) noexcept{
 }
 
 bool resolve_name_body(Body& body, SymbolTable& symbol_table) noexcept{ //registro de variables en la tabla de simbolos
-    static bool is_first_call = true;
-    if (is_first_call) { //recorrido de todos los statements en un bloque de codigo
-        visited_nodes.clear();
-        is_first_call = false;
-    }
-    
-    static int recursion_depth = 0;
-    constexpr int max_recursion_depth = 100;
-    
-    recursion_depth++;
-    if (recursion_depth > max_recursion_depth) {
-        recursion_depth--;
-        return false;
-    }
-    
-    bool result = true;
+    // Sin límite de anidamiento: los nodos pasan al motor de traversal.hpp
+    // cuando la recursión nativa se vuelve demasiado profunda. Una sentencia
+    // compartida (NodeInterner) se resuelve en cada posición en que aparece
     for (Statement* statement : body){
-        if (visited_nodes.find(statement) != visited_nodes.end()) {
-            continue;
-        }
-        
-        visited_nodes.insert(statement);
-        
         if (!statement->resolve_name(symbol_table))
         {
-            result = false;
-            break;
+            return false;
         }
     }
     
-    recursion_depth--;
-    if (recursion_depth == 0) {
-        is_first_call = true;
+    return true;
+}
+
+void lower_body_notes(const Body& body, NoteStream& stream) noexcept{
+    std::uint32_t index = 0;
+    for (Statement* statement : body){
+        auto decl_stmt = dyn_cast<DeclarationStatement>(statement);
+        auto note = decl_stmt ? dyn_cast<NoteDeclaration>(decl_stmt->get_declaration()) : nullptr;
+
+        if (note != nullptr)
+        {
+            stream.append(
+                pitch_class_from_letter(note->get_pitch()),
+                0,
+                note->get_octave(),
+                duration_ticks_from_name(note->get_duration()),
+                index
+            );
+        }
+        ++index;
     }
-    return result;
 }
 
 void destroy_param_list(ParamList& param_list) noexcept
@@ -108,20 +108,19 @@ void destroy_param_list(ParamList& param_list) noexcept
     while (!param_list.empty()){
         Param param = param_list.front();
         param_list.pop_front();
-        param.second->destroy();
-        delete param.second;
+        release(param.second);
         param.second = nullptr;
     }
 }
 
 ParamList copy_param_list(const ParamList& param_list) noexcept{
     ParamList result;
+    auto tail = result.before_begin();
 
     for (auto param : param_list){
-        result.push_front(std::make_pair(param.first, dynamic_cast<Datatype*>(param.second->copy())));
+        tail = result.insert_after(tail, std::make_pair(param.first, cast<Datatype>(param.second->copy())));
     }
     
-    result.reverse(); // Para mantener el orden 
     return result;
 }
 
@@ -142,14 +141,17 @@ bool equal_param_list(const ParamList& param_list1, const ParamList& param_list2
     return it1 == param_list1.end() && it2 == param_list2.end();
 }
 
+std::uint64_t param_list_hash(const ParamList& param_list) noexcept{
+    std::uint64_t hash = 0;
+    for (const Param& param : param_list){
+        hash = hash_mix(hash_mix(hash, param.first), param.second->hash());
+    }
+    return hash;
+}
+
 std::pair<bool, Datatype*> param_list_type_check(const ParamList& param_list) noexcept{
     for (const Param& param : param_list){
         auto param_type = param.second->type_check();
-        if (param_type.second != nullptr)
-        {
-            delete param_type.second;
-            param_type.second = nullptr;
-        }
 
         if (!param_type.first)
         {
@@ -162,7 +164,7 @@ std::pair<bool, Datatype*> param_list_type_check(const ParamList& param_list) no
 
 bool resolve_name_param_list(const ParamList& param_list, SymbolTable& symbol_table) noexcept{ //registro de parametros en la tabla de simbolos
     for (const Param& param : param_list){
-        auto symbol = Symbol::build(param.second, param.first);
+        Symbol* symbol = symbol_table.make_symbol(param.second, param.first);
 
         if (!symbol_table.bind(param.first, symbol)){
             return false;
@@ -172,4 +174,17 @@ bool resolve_name_param_list(const ParamList& param_list, SymbolTable& symbol_ta
     return true;
 }
 
-ASTNodeInterface::~ASTNodeInterface() noexcept {} 
\ No newline at end of file
+ASTNodeInterface::ASTNodeInterface(NodeKind _kind) noexcept
+    : kind(_kind), references(1), structural_hash(hash_mix(0, static_cast<std::uint64_t>(_kind)))
+{
+    count_node(static_cast<std::uint8_t>(_kind));
+}
+
+ASTNodeInterface::~ASTNodeInterface() noexcept {} 
+
+void release(ASTNodeInterface* node) noexcept{
+    if (node != nullptr && node->drop_reference()){
+        node->destroy();
+        delete node;
+    }
+}
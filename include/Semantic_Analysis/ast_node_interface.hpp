@@ -1,10 +1,17 @@
 #pragma once
 
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <forward_list>
 #include <string>
 #include <string_view>
 #include <utility>
 
+#include "stats.hpp"
+#include "string_interner.hpp"
+
+class ASTNodeInterface;
 class Declaration;
 class Expression;
 class Statement;
@@ -15,46 +22,284 @@ class Key;
 class Tempo;
 struct Symbol;
 class SymbolTable;
+class NoteStream;
 
 // Lista para representar el cuerpo de una composición musical
 using Body = std::forward_list<Statement*>;
 
 // Declaración de parámetros para funciones musicales
-using Param = std::pair<std::string, Datatype*>;
+using Param = std::pair<NameId, Datatype*>;
 using ParamList = std::forward_list<Param>;
 
 void destroy_body(Body& body) noexcept;
 
+// Copia del cuerpo que comparte sus sentencias: una referencia más por
+// sentencia, sin copiar ningún nodo
 Body copy_body(const Body& body) noexcept;
 
+// Poner statement (con su referencia) en la posición y soltar la sentencia que
+// había: las copias que la comparten no cambian
+void replace_statement(Body& body, Body::iterator position, Statement* statement) noexcept;
+
+// Copia de root en la que cada aparición de target pasa a ser replacement (se
+// toma la referencia del llamador). Solo se construyen de nuevo los nodos en el
+// camino de root a target; el resto se comparte. Si target no aparece, es
+// copy() de root. Recorre root sin límite de profundidad (ver traversal.hpp).
+ASTNodeInterface* replace_node(const ASTNodeInterface* root, const ASTNodeInterface* target,
+                               ASTNodeInterface* replacement) noexcept;
+
 bool equal_body(const Body& body1, const Body& body2) noexcept;
 
+// Hash estructural de un cuerpo (combina el hash de sus sentencias en orden)
+std::uint64_t body_hash(const Body& body) noexcept;
+
 std::pair<bool, Datatype*> body_type_check(const Body& body) noexcept;
 
 bool resolve_name_body(Body& body, SymbolTable& symbol_table) noexcept;
 
+// Copia las NoteDeclaration del cuerpo (en orden) a su representación plana
+void lower_body_notes(const Body& body, NoteStream& stream) noexcept;
+
 void destroy_param_list(ParamList& param_list) noexcept;
 
 ParamList copy_param_list(const ParamList& param_list) noexcept;
 
 bool equal_param_list(const ParamList& param_list1, const ParamList& param_list2) noexcept;
 
+std::uint64_t param_list_hash(const ParamList& param_list) noexcept;
+
 std::pair<bool, Datatype*> param_list_type_check(const ParamList& param_list) noexcept;
 
 bool resolve_name_param_list(const ParamList& param_list, SymbolTable& symbol_table) noexcept;
 
+// Identificador compacto del tipo concreto de cada nodo. Los rangos agrupan
+// las jerarquías (Datatype, Declaration, Expression, Statement) para que
+// classof, isa<> y dyn_cast<> sean una comparación de enteros.
+enum class NodeKind : std::uint8_t
+{
+    // Datatype
+    VoidDatatype,
+    BooleanDatatype,
+    CharacterDatatype,
+    IntegerDatatype,
+    StringDatatype,
+    NoteDatatype,
+    TempoDatatype,
+    KeyDatatype,
+    TimeSignatureDatatype,
+    ArrayDatatype,
+    FunctionDatatype,
+
+    // Declaration
+    VariableDeclaration,
+    TempoDeclaration,
+    KeyDeclaration,
+    TimeSignatureDeclaration,
+    NoteDeclaration,
+    FunctionDeclaration,
+
+    // Expression
+    BoolExpression,
+    IntExpression,
+    StrExpression,
+    NoteExpression,
+    KeyExpression,
+    TempoExpression,
+    TimeSignatureExpression,
+    NameExpression,
+    ArrayAccessExpression,
+    AssignmentExpression,
+    CallExpression,
+    ArgExpression,
+    SharpExpression,
+
+    // Statement
+    DeclarationStatement,
+    ExpressionStatement,
+    PrintStatement,
+
+    FirstDatatype = VoidDatatype,
+    FirstBasicDatatype = VoidDatatype,
+    LastBasicDatatype = TimeSignatureDatatype,
+    LastDatatype = FunctionDatatype,
+    FirstDeclaration = VariableDeclaration,
+    LastDeclaration = FunctionDeclaration,
+    FirstExpression = BoolExpression,
+    LastExpression = SharpExpression,
+    FirstUnaryExpression = SharpExpression,
+    LastUnaryExpression = SharpExpression,
+    FirstStatement = DeclarationStatement,
+    LastStatement = PrintStatement
+};
+
+// Combinar un hash con un valor: la mezcla de boost::hash_combine seguida del
+// final de splitmix64, para que valores cercanos den hashes lejanos
+inline std::uint64_t hash_mix(std::uint64_t seed, std::uint64_t value) noexcept
+{
+    std::uint64_t hash = seed ^ (value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2));
+    hash = (hash ^ (hash >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    hash = (hash ^ (hash >> 27)) * 0x94d049bb133111ebULL;
+    return hash ^ (hash >> 31);
+}
+
 class ASTNodeInterface
 {
 public:
     virtual ~ASTNodeInterface() noexcept;
 
+    NodeKind get_kind() const noexcept
+    {
+        return kind;
+    }
+
+    // Hash estructural: dos nodos iguales según equal() tienen el mismo hash.
+    // Cada constructor lo calcula a partir de sus campos y del hash ya guardado
+    // de sus hijos, así que consultarlo cuesta O(1) a cualquier profundidad.
+    // Los nodos no cambian después de construirse (destroy() solo los deja
+    // listos para delete); una operación que los modifique debe recalcularlo.
+    // Los nombres entran por su id: solo es comparable dentro del proceso.
+    std::uint64_t hash() const noexcept
+    {
+        return structural_hash;
+    }
+
+    // Cuenta de referencias: quien construye el nodo tiene la primera y cada
+    // estructura que lo comparte (NodeInterner, otro cuerpo) añade la suya con
+    // retain(). El último release() llama a destroy() y lo libera, así que un
+    // nodo compartido se libera una sola vez.
+    void add_reference() const noexcept
+    {
+        references.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Quitar una referencia; true si era la última y el nodo debe liberarse
+    bool drop_reference() const noexcept
+    {
+        return references.fetch_sub(1, std::memory_order_acq_rel) == 1;
+    }
+
+    bool is_shared() const noexcept
+    {
+        return references.load(std::memory_order_relaxed) > 1;
+    }
+
+    // Fijar el nodo: su memoria pertenece a otra estructura (Arena::make lo
+    // llama al construirlo). La cuenta nunca vuelve a 1, así que release() no
+    // llama a destroy() ni a delete; copy(), retain() y release() siguen
+    // funcionando y el nodo cuenta siempre como compartido.
+    void pin() const noexcept
+    {
+        references.fetch_add(pinned_references, std::memory_order_relaxed);
+    }
+
+    // Soltar las referencias a los hijos (release()); no libera el propio nodo
     virtual void destroy() noexcept = 0;
 
-    virtual ASTNodeInterface* copy() const noexcept = 0;
+    // Copia en O(1): los nodos no cambian después de construirse, así que la
+    // copia es el mismo nodo con una referencia más. Para cambiar algo en una
+    // copia se construye el camino hasta el cambio (replace_statement,
+    // replace_node) y lo demás sigue compartido con el original.
+    ASTNodeInterface* copy() const noexcept
+    {
+        add_reference();
+        return const_cast<ASTNodeInterface*>(this);
+    }
 
     virtual bool equal(ASTNodeInterface* other) const noexcept = 0;
 
+    // El tipo devuelto es canónico (ver TypeContext): no se debe liberar
     virtual std::pair<bool, Datatype*> type_check() const noexcept = 0;
 
     virtual bool resolve_name(SymbolTable& symbol_table) noexcept = 0;
-}; 
\ No newline at end of file
+
+protected:
+    explicit ASTNodeInterface(NodeKind _kind) noexcept;
+
+    // Combinar un campo propio o el hash de un hijo, en orden, en el hash del nodo
+    void hash_combine(std::uint64_t value) noexcept
+    {
+        structural_hash = hash_mix(structural_hash, value);
+    }
+
+    // Hash de un hijo opcional (0 si no está)
+    static std::uint64_t hash_of(const ASTNodeInterface* node) noexcept
+    {
+        return node != nullptr ? node->hash() : 0;
+    }
+
+private:
+    static constexpr std::uint32_t pinned_references = 1u << 30;
+
+    const NodeKind kind;
+    mutable std::atomic<std::uint32_t> references;
+    std::uint64_t structural_hash;
+};
+
+// Compartir un nodo: añade una referencia y lo devuelve
+template <typename Type>
+Type* retain(Type* node) noexcept
+{
+    node->add_reference();
+    return node;
+}
+
+// Soltar una referencia (nullptr se ignora); con la última se liberan el nodo
+// y, recursivamente, los hijos que nadie más comparte
+void release(ASTNodeInterface* node) noexcept;
+
+// Para contenedores de fragmentos del AST, por ejemplo
+// std::unordered_set<Statement*, ASTNodeHash, ASTNodeEqual>
+struct ASTNodeHash
+{
+    std::size_t operator()(const ASTNodeInterface* node) const noexcept
+    {
+        return static_cast<std::size_t>(node->hash());
+    }
+};
+
+struct ASTNodeEqual
+{
+    bool operator()(const ASTNodeInterface* node, const ASTNodeInterface* other) const noexcept
+    {
+        return node == other || node->equal(const_cast<ASTNodeInterface*>(other));
+    }
+};
+
+// Verifica si el nodo pertenece a Type comparando su NodeKind
+template <typename Type>
+bool isa(const ASTNodeInterface* node) noexcept
+{
+    count(Counter::KindCheck);
+    return Type::classof(node);
+}
+
+// Conversión comprobada: nullptr si el nodo no es de tipo Type
+template <typename Type>
+Type* dyn_cast(ASTNodeInterface* node) noexcept
+{
+    return const_cast<Type*>(dyn_cast<Type>(static_cast<const ASTNodeInterface*>(node)));
+}
+
+template <typename Type>
+const Type* dyn_cast(const ASTNodeInterface* node) noexcept
+{
+    count(Counter::DynCast);
+    if (node != nullptr && Type::classof(node))
+    {
+        return static_cast<const Type*>(node);
+    }
+    count(Counter::DynCastNull);
+    return nullptr;
+}
+
+// Conversión sin comprobar, para cuando el tipo ya es conocido (por ejemplo, copy())
+template <typename Type>
+Type* cast(ASTNodeInterface* node) noexcept
+{
+    return static_cast<Type*>(node);
+} 
+template <typename Type>
+const Type* cast(const ASTNodeInterface* node) noexcept
+{
+    return static_cast<const Type*>(node);
+}
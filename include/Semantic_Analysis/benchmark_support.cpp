@@ -0,0 +1,44 @@
+#include "benchmark_support.hpp"
+
+#include <iomanip>
+#include <iostream>
+
+double elapsed_ms(Clock::time_point start, Clock::time_point end) noexcept{
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+const char* verdict_text(bool success) noexcept{
+    return success ? "✓ ÉXITO" : "✗ ERROR";
+}
+
+void print_label(const std::string& label, int width){
+    // setw cuenta bytes: se compensan los de continuación de UTF-8 (á, ó, ...)
+    for (unsigned char byte : label){
+        width += (byte & 0xC0) == 0x80;
+    }
+    std::cout << std::setw(width) << std::left << label;
+}
+
+void print_ms(double ms, int width, int precision){
+    std::cout << " | " << std::setw(width) << std::right << std::fixed << std::setprecision(precision) << ms << " ms";
+}
+
+void print_kilobytes(double kilobytes, int width, int precision){
+    std::cout << " | " << std::setw(width) << std::right << std::fixed << std::setprecision(precision) << kilobytes << " KB";
+}
+
+void print_speedup(double baseline_ms, double ms){
+    std::cout << " | x" << std::setw(5) << std::right << std::fixed << std::setprecision(2) << baseline_ms / ms;
+}
+
+void print_text(const std::string& text){
+    std::cout << " | " << text;
+}
+
+void print_verdict(bool success){
+    std::cout << " | " << verdict_text(success) << std::endl;
+}
+
+void print_end(){
+    std::cout << std::endl;
+}
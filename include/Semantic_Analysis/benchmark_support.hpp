@@ -0,0 +1,40 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+
+// Utilidades compartidas por los *_benchmark.cpp: medición de tiempo y las
+// columnas de sus tablas. Cada benchmark arma su fila con print_label, las
+// columnas que necesita y print_verdict (o print_end) al final.
+
+using Clock = std::chrono::steady_clock;
+
+double elapsed_ms(Clock::time_point start, Clock::time_point end) noexcept;
+
+const char* verdict_text(bool success) noexcept;
+
+// Primera columna: la etiqueta alineada a la izquierda
+void print_label(const std::string& label, int width);
+
+// " | " y un tiempo en milisegundos
+void print_ms(double ms, int width = 10, int precision = 2);
+
+// " | " y una cantidad de memoria en kilobytes
+void print_kilobytes(double kilobytes, int width = 10, int precision = 1);
+
+// " | x" y la aceleración frente a baseline_ms
+void print_speedup(double baseline_ms, double ms);
+
+// " | " y un texto libre (por ejemplo, una suma de control)
+void print_text(const std::string& text);
+
+// " | ✓ ÉXITO" o " | ✗ ERROR" y fin de la fila
+void print_verdict(bool success);
+
+// Fin de la fila sin veredicto
+void print_end();
+
+// Memoria viva del proceso en bytes. La define live_memory.cpp, que reemplaza
+// operator new/delete: solo la enlazan los benchmarks que miden memoria.
+std::size_t live_bytes() noexcept;
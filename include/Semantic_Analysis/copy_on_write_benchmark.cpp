@@ -0,0 +1,192 @@
+/*
+    Compilador Musical: Benchmark de las copias compartidas del AST
+
+    Simula el generador de variaciones: copia una partitura base (notas,
+    sostenidos y motivos) muchas veces y en cada copia cambia la octava de
+    unas pocas notas del nivel superior (replace_statement) y de una nota
+    dentro de un motivo (replace_node, que reconstruye solo el camino hasta
+    ella). Mide el tiempo y la memoria de las copias frente a la base, el
+    análisis de las variantes (las sentencias compartidas se comprueban una
+    vez) y comprueba que las variantes sean iguales a las mismas partituras
+    construidas desde cero y que la base no cambie.
+
+    Uso: ./copy_on_write_benchmark [sentencias] [motivos] [variantes]
+*/
+
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "benchmark_support.hpp"
+#include "datatype.hpp"
+#include "declaration.hpp"
+#include "expression.hpp"
+#include "statement.hpp"
+#include "symbol_table.hpp"
+
+constexpr int statements_per_motif = 40;
+constexpr int tweaks_per_variation = 4;
+
+// kilobytes < 0: la fila no mide memoria
+static void print_row(const std::string& label, double ms, double kilobytes, bool success) {
+    print_label(label, 24);
+    print_ms(ms, 10, 3);
+    if (kilobytes >= 0) {
+        print_kilobytes(kilobytes);
+    }
+    else {
+        print_text(std::string(13, ' '));
+    }
+    print_verdict(success);
+}
+
+static Statement* make_note(NameId name, int index, int octave) {
+    return new DeclarationStatement{new NoteDeclaration{name, "CDEFGAB"[index % 7], octave, intern_name("Negra")}};
+}
+
+// Posiciones (notas del nivel superior) que cambia la variante, en orden
+static std::vector<int> tweaked_positions(int size, int variation) {
+    std::vector<int> positions;
+    for (int k = 0; k < tweaks_per_variation; ++k) {
+        int position = static_cast<int>((variation * 7919L + k * (size / tweaks_per_variation)) % size);
+        positions.push_back(position - (position % 4 == 3 ? 1 : 0));
+    }
+    std::sort(positions.begin(), positions.end());
+    positions.erase(std::unique(positions.begin(), positions.end()), positions.end());
+    return positions;
+}
+
+// Cada cuarta sentencia es un sostenido sobre la nota anterior; los motivos
+// declaran notas locales y las alteran. variation < 0 construye la base
+static Body make_score(int size, int motifs, int variation) {
+    std::vector<int> tweaks = variation >= 0 ? tweaked_positions(size, variation) : std::vector<int>{};
+    Body program;
+    auto tail = program.before_begin();
+    for (int i = 0; i < size; ++i) {
+        Statement* statement = nullptr;
+        if (i % 4 == 3) {
+            statement = new ExpressionStatement{new SharpExpression{new NameExpression{intern_name("nota" + std::to_string(i - 1))}}};
+        }
+        else {
+            bool tweaked = std::binary_search(tweaks.begin(), tweaks.end(), i);
+            statement = make_note(intern_name("nota" + std::to_string(i)), i, tweaked ? 5 : 4);
+        }
+        tail = program.insert_after(tail, statement);
+    }
+
+    for (int f = 0; f < motifs; ++f) {
+        Body body;
+        auto body_tail = body.before_begin();
+        for (int s = 0; s < statements_per_motif; ++s) {
+            NameId local = intern_name("local" + std::to_string(s / 2));
+            Statement* statement = nullptr;
+            if (s % 2 == 1) {
+                statement = new ExpressionStatement{new SharpExpression{new NameExpression{local}}};
+            }
+            else {
+                statement = make_note(local, s, s == 0 && variation >= 0 && variation % motifs == f ? 3 : 4);
+            }
+            body_tail = body.insert_after(body_tail, statement);
+        }
+        tail = program.insert_after(tail, new DeclarationStatement{new FunctionDeclaration{
+            intern_name("motivo" + std::to_string(f)), new FunctionDatatype{new VoidDatatype{}, ParamList{}}, body}});
+    }
+    return program;
+}
+
+// Copia de la base con los cambios de la variante
+static Body make_variation(const Body& base, int size, int motifs, int variation) {
+    Body copy = copy_body(base);
+
+    auto position = copy.begin();
+    int index = 0;
+    for (int tweak : tweaked_positions(size, variation)) {
+        std::advance(position, tweak - index);
+        index = tweak;
+        replace_statement(copy, position, make_note(intern_name("nota" + std::to_string(tweak)), tweak, 5));
+    }
+
+    // La primera nota del motivo: se reconstruyen la sentencia, la función y su cuerpo
+    const int motif = variation % motifs;
+    std::advance(position, size + motif - index);
+    auto function = cast<FunctionDeclaration>(cast<DeclarationStatement>(*position)->get_declaration());
+    Statement* note = make_note(intern_name("local0"), 0, 3);
+    replace_statement(copy, position, cast<Statement>(replace_node(*position, function->get_body().front(), note)));
+    return copy;
+}
+
+int main(int argc, char** argv){
+    int size = argc > 1 ? std::atoi(argv[1]) : 20000;
+    int motifs = argc > 2 ? std::atoi(argv[2]) : 50;
+    int variations = argc > 3 ? std::atoi(argv[3]) : 1000;
+    if (size < tweaks_per_variation * 4 || motifs <= 0 || variations <= 0) {
+        std::cerr << "Uso: " << argv[0] << " [sentencias] [motivos] [variantes]" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "====== Benchmark de las copias compartidas (" << size << " sentencias, " << motifs
+              << " motivos, " << variations << " variantes) ======" << std::endl;
+
+    // Una primera construcción interna los nombres, para no contarlos como memoria de la base
+    Body fresh_base = make_score(size, motifs, -1);
+
+    std::size_t before = live_bytes();
+    auto start = Clock::now();
+    Body base = make_score(size, motifs, -1);
+    auto end = Clock::now();
+    const double base_kb = (live_bytes() - before) / 1024.0;
+    const std::uint64_t base_hash = body_hash(base);
+    print_row("construir la base", elapsed_ms(start, end), base_kb, true);
+
+    // Todas las variantes vivas a la vez, como las deja el generador
+    before = live_bytes();
+    std::vector<Body> generated;
+    start = Clock::now();
+    for (int v = 0; v < variations; ++v) {
+        generated.push_back(make_variation(base, size, motifs, v));
+    }
+    end = Clock::now();
+    print_row("generar una variante", elapsed_ms(start, end) / variations, (live_bytes() - before) / 1024.0 / variations, true);
+
+    // Algunas variantes contra la misma partitura construida desde cero
+    start = Clock::now();
+    bool same = body_hash(base) == base_hash;
+    for (int v = 0; v < variations; v += std::max(1, variations / 8)) {
+        Body expected = make_score(size, motifs, v);
+        same = equal_body(generated[v], expected) && !equal_body(generated[v], base) && same;
+        destroy_body(expected);
+    }
+    same = equal_body(base, fresh_base) && same;
+    end = Clock::now();
+    print_row("comparar desde cero", elapsed_ms(start, end), -1, same);
+
+    start = Clock::now();
+    SymbolTable base_table;
+    bool expected = resolve_name_body(base, base_table) && body_type_check(base).first;
+    end = Clock::now();
+    print_row("analizar la base", elapsed_ms(start, end), -1, expected);
+
+    bool analyzed = true;
+    start = Clock::now();
+    for (Body& variation : generated) {
+        SymbolTable table;
+        analyzed = resolve_name_body(variation, table) && body_type_check(variation).first && analyzed;
+    }
+    end = Clock::now();
+    print_row("analizar una variante", elapsed_ms(start, end) / variations, -1, analyzed == expected);
+
+    start = Clock::now();
+    for (Body& variation : generated) {
+        destroy_body(variation);
+    }
+    end = Clock::now();
+    print_row("liberar una variante", elapsed_ms(start, end) / variations, -1, body_hash(base) == base_hash);
+
+    destroy_body(fresh_base);
+    destroy_body(base);
+    return same && expected && analyzed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -13,100 +13,110 @@ bool BasicDatatype::resolve_name(SymbolTable& symbol_table) noexcept{
     return true; // Los tipos básicos no tienen nombres que resolver
 }
 
-ASTNodeInterface* VoidDatatype::copy() const noexcept{
-    return new VoidDatatype();
+VoidDatatype::VoidDatatype() noexcept
+    : BasicDatatype(NodeKind::VoidDatatype)
+{
 }
 
 bool VoidDatatype::equal(ASTNodeInterface* other) const noexcept{
-    return dynamic_cast<VoidDatatype*>(other) != nullptr;
+    return dyn_cast<VoidDatatype>(other) != nullptr;
 }
 
-ASTNodeInterface* BooleanDatatype::copy() const noexcept{
-    return new BooleanDatatype();
+BooleanDatatype::BooleanDatatype() noexcept
+    : BasicDatatype(NodeKind::BooleanDatatype)
+{
 }
 
 bool BooleanDatatype::equal(ASTNodeInterface* other) const noexcept{
-    return dynamic_cast<BooleanDatatype*>(other) != nullptr;
+    return dyn_cast<BooleanDatatype>(other) != nullptr;
 }
 
-ASTNodeInterface* CharacterDatatype::copy() const noexcept{
-    return new CharacterDatatype();
+CharacterDatatype::CharacterDatatype() noexcept
+    : BasicDatatype(NodeKind::CharacterDatatype)
+{
 }
 
 bool CharacterDatatype::equal(ASTNodeInterface* other) const noexcept{
-    return dynamic_cast<CharacterDatatype*>(other) != nullptr;
+    return dyn_cast<CharacterDatatype>(other) != nullptr;
 }
 
-ASTNodeInterface* IntegerDatatype::copy() const noexcept{
-    return new IntegerDatatype();
+IntegerDatatype::IntegerDatatype() noexcept
+    : BasicDatatype(NodeKind::IntegerDatatype)
+{
 }
 
 bool IntegerDatatype::equal(ASTNodeInterface* other) const noexcept{
-    return dynamic_cast<IntegerDatatype*>(other) != nullptr;
+    return dyn_cast<IntegerDatatype>(other) != nullptr;
 }
 
-ASTNodeInterface* StringDatatype::copy() const noexcept{
-    return new StringDatatype();
+StringDatatype::StringDatatype() noexcept
+    : BasicDatatype(NodeKind::StringDatatype)
+{
 }
 
 bool StringDatatype::equal(ASTNodeInterface* other) const noexcept{
-    return dynamic_cast<StringDatatype*>(other) != nullptr;
+    return dyn_cast<StringDatatype>(other) != nullptr;
 }
 
 // Implementación de tipos musicales
-ASTNodeInterface* NoteDatatype::copy() const noexcept{
-    return new NoteDatatype();
+NoteDatatype::NoteDatatype() noexcept
+    : BasicDatatype(NodeKind::NoteDatatype)
+{
 }
 
 bool NoteDatatype::equal(ASTNodeInterface* other) const noexcept{
-    return dynamic_cast<NoteDatatype*>(other) != nullptr;
+    return dyn_cast<NoteDatatype>(other) != nullptr;
 }
 
-ASTNodeInterface* TempoDatatype::copy() const noexcept{
-    return new TempoDatatype();
+TempoDatatype::TempoDatatype() noexcept
+    : BasicDatatype(NodeKind::TempoDatatype)
+{
 }
 
 bool TempoDatatype::equal(ASTNodeInterface* other) const noexcept{
-    return dynamic_cast<TempoDatatype*>(other) != nullptr;
+    return dyn_cast<TempoDatatype>(other) != nullptr;
 }
 
-ASTNodeInterface* KeyDatatype::copy() const noexcept{
-    return new KeyDatatype();
+KeyDatatype::KeyDatatype() noexcept
+    : BasicDatatype(NodeKind::KeyDatatype)
+{
 }
 
 bool KeyDatatype::equal(ASTNodeInterface* other) const noexcept{
-    return dynamic_cast<KeyDatatype*>(other) != nullptr;
+    return dyn_cast<KeyDatatype>(other) != nullptr;
 }
 
-ASTNodeInterface* TimeSignatureDatatype::copy() const noexcept{
-    return new TimeSignatureDatatype();
+TimeSignatureDatatype::TimeSignatureDatatype() noexcept
+    : BasicDatatype(NodeKind::TimeSignatureDatatype)
+{
 }
 
 bool TimeSignatureDatatype::equal(ASTNodeInterface* other) const noexcept{
-    return dynamic_cast<TimeSignatureDatatype*>(other) != nullptr;
+    return dyn_cast<TimeSignatureDatatype>(other) != nullptr;
 }
 
 ArrayDatatype::ArrayDatatype(Datatype* _inner_datatype) noexcept
-    : inner_datatype(_inner_datatype)
+    : Datatype(NodeKind::ArrayDatatype), inner_datatype(_inner_datatype)
 {
+    hash_combine(hash_of(inner_datatype));
 }
 
 void ArrayDatatype::destroy() noexcept{
     if (inner_datatype != nullptr)
     {
-        inner_datatype->destroy();
-        delete inner_datatype;
+        release(inner_datatype);
         inner_datatype = nullptr;
     }
 }
 
-ASTNodeInterface* ArrayDatatype::copy() const noexcept{
-    return new ArrayDatatype(dynamic_cast<Datatype*>(inner_datatype->copy()));
-}
-
 bool ArrayDatatype::equal(ASTNodeInterface* other) const noexcept{
-    auto other_array = dynamic_cast<ArrayDatatype*>(other);
-    if (other_array == nullptr)
+    if (other == this)
+    {
+        return true;
+    }
+
+    auto other_array = dyn_cast<ArrayDatatype>(other);
+    if (other_array == nullptr || hash() != other->hash())
     {
         return false;
     }
@@ -123,31 +133,30 @@ Datatype* ArrayDatatype::get_inner_datatype() const noexcept{
 }
 
 FunctionDatatype::FunctionDatatype(Datatype* ret_type, const ParamList& params) noexcept
-    : return_type(ret_type), parameters(params){
+    : Datatype(NodeKind::FunctionDatatype), return_type(ret_type), parameters(params){
+    hash_combine(hash_of(return_type));
+    hash_combine(param_list_hash(parameters));
 }
 
 void FunctionDatatype::destroy() noexcept
 {
     if (return_type != nullptr)
     {
-        return_type->destroy();
-        delete return_type;
+        release(return_type);
         return_type = nullptr;
     }
     
     destroy_param_list(parameters);
 }
 
-ASTNodeInterface* FunctionDatatype::copy() const noexcept{
-    return new FunctionDatatype(
-        dynamic_cast<Datatype*>(return_type->copy()),
-        copy_param_list(parameters)
-    );
-}
-
 bool FunctionDatatype::equal(ASTNodeInterface* other) const noexcept{
-    auto other_function = dynamic_cast<FunctionDatatype*>(other);
-    if (other_function == nullptr)
+    if (other == this)
+    {
+        return true;
+    }
+
+    auto other_function = dyn_cast<FunctionDatatype>(other);
+    if (other_function == nullptr || hash() != other->hash())
     {
         return false;
     }
@@ -5,27 +5,49 @@
 class Datatype : public ASTNodeInterface
 {
 public:
+    static bool classof(const ASTNodeInterface* node) noexcept
+    {
+        return node->get_kind() >= NodeKind::FirstDatatype && node->get_kind() <= NodeKind::LastDatatype;
+    }
+
     template <typename Type>
     bool is() const noexcept
     {
-        return dynamic_cast<const Type*>(this) != nullptr;
+        count(Counter::KindCheck);
+        return Type::classof(this);
     }
 
     std::pair<bool, Datatype*> type_check() const noexcept override;
+
+protected:
+    using ASTNodeInterface::ASTNodeInterface;
 };
 
 class BasicDatatype : public Datatype
 {
 public:
+    static bool classof(const ASTNodeInterface* node) noexcept
+    {
+        return node->get_kind() >= NodeKind::FirstBasicDatatype && node->get_kind() <= NodeKind::LastBasicDatatype;
+    }
+
     void destroy() noexcept override;
 
     bool resolve_name(SymbolTable& symbol_table) noexcept override;
+
+protected:
+    using Datatype::Datatype;
 };
 
 class VoidDatatype : public BasicDatatype
 {
 public:
-    ASTNodeInterface* copy() const noexcept override;
+    VoidDatatype() noexcept;
+
+    static bool classof(const ASTNodeInterface* node) noexcept
+    {
+        return node->get_kind() == NodeKind::VoidDatatype;
+    }
 
     bool equal(ASTNodeInterface* other) const noexcept override;
 };
@@ -33,7 +55,12 @@ public:
 class BooleanDatatype : public BasicDatatype
 {
 public:
-    ASTNodeInterface* copy() const noexcept override;
+    BooleanDatatype() noexcept;
+
+    static bool classof(const ASTNodeInterface* node) noexcept
+    {
+        return node->get_kind() == NodeKind::BooleanDatatype;
+    }
 
     bool equal(ASTNodeInterface* other) const noexcept override;
 };
@@ -41,7 +68,12 @@ public:
 class CharacterDatatype : public BasicDatatype
 {
 public:
-    ASTNodeInterface* copy() const noexcept override;
+    CharacterDatatype() noexcept;
+
+    static bool classof(const ASTNodeInterface* node) noexcept
+    {
+        return node->get_kind() == NodeKind::CharacterDatatype;
+    }
 
     bool equal(ASTNodeInterface* other) const noexcept override;
 };
@@ -49,7 +81,12 @@ public:
 class IntegerDatatype : public BasicDatatype
 {
 public:
-    ASTNodeInterface* copy() const noexcept override;
+    IntegerDatatype() noexcept;
+
+    static bool classof(const ASTNodeInterface* node) noexcept
+    {
+        return node->get_kind() == NodeKind::IntegerDatatype;
+    }
 
     bool equal(ASTNodeInterface* other) const noexcept override;
 };
@@ -57,7 +94,12 @@ public:
 class StringDatatype : public BasicDatatype
 {
 public:
-    ASTNodeInterface* copy() const noexcept override;
+    StringDatatype() noexcept;
+
+    static bool classof(const ASTNodeInterface* node) noexcept
+    {
+        return node->get_kind() == NodeKind::StringDatatype;
+    }
 
     bool equal(ASTNodeInterface* other) const noexcept override;
 };
@@ -66,7 +108,12 @@ public:
 class NoteDatatype : public BasicDatatype
 {
 public:
-    ASTNodeInterface* copy() const noexcept override;
+    NoteDatatype() noexcept;
+
+    static bool classof(const ASTNodeInterface* node) noexcept
+    {
+        return node->get_kind() == NodeKind::NoteDatatype;
+    }
 
     bool equal(ASTNodeInterface* other) const noexcept override;
 };
@@ -74,7 +121,12 @@ public:
 class TempoDatatype : public BasicDatatype
 {
 public:
-    ASTNodeInterface* copy() const noexcept override;
+    TempoDatatype() noexcept;
+
+    static bool classof(const ASTNodeInterface* node) noexcept
+    {
+        return node->get_kind() == NodeKind::TempoDatatype;
+    }
 
     bool equal(ASTNodeInterface* other) const noexcept override;
 };
@@ -82,7 +134,12 @@ public:
 class KeyDatatype : public BasicDatatype
 {
 public:
-    ASTNodeInterface* copy() const noexcept override;
+    KeyDatatype() noexcept;
+
+    static bool classof(const ASTNodeInterface* node) noexcept
+    {
+        return node->get_kind() == NodeKind::KeyDatatype;
+    }
 
     bool equal(ASTNodeInterface* other) const noexcept override;
 };
@@ -90,7 +147,12 @@ public:
 class TimeSignatureDatatype : public BasicDatatype
 {
 public:
-    ASTNodeInterface* copy() const noexcept override;
+    TimeSignatureDatatype() noexcept;
+
+    static bool classof(const ASTNodeInterface* node) noexcept
+    {
+        return node->get_kind() == NodeKind::TimeSignatureDatatype;
+    }
 
     bool equal(ASTNodeInterface* other) const noexcept override;
 };
@@ -100,9 +162,12 @@ class ArrayDatatype : public Datatype
 public:
     ArrayDatatype(Datatype* _inner_datatype) noexcept;
 
-    void destroy() noexcept override;
+    static bool classof(const ASTNodeInterface* node) noexcept
+    {
+        return node->get_kind() == NodeKind::ArrayDatatype;
+    }
 
-    ASTNodeInterface* copy() const noexcept override;
+    void destroy() noexcept override;
 
     bool equal(ASTNodeInterface* other) const noexcept override;
 
@@ -118,9 +183,12 @@ class FunctionDatatype : public Datatype
 public:
     FunctionDatatype(Datatype* ret_type, const ParamList& params) noexcept;
 
-    void destroy() noexcept override;
+    static bool classof(const ASTNodeInterface* node) noexcept
+    {
+        return node->get_kind() == NodeKind::FunctionDatatype;
+    }
 
-    ASTNodeInterface* copy() const noexcept override;
+    void destroy() noexcept override;
 
     bool equal(ASTNodeInterface* other) const noexcept override;
 
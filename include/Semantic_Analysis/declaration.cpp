@@ -3,44 +3,56 @@
 #include "expression.hpp"
 #include "symbol_table.hpp"
 #include "statement.hpp"
+#include "traversal.hpp"
+#include "type_context.hpp"
 
 // Implementación de VariableDeclaration
 VariableDeclaration::VariableDeclaration(
-    const std::string& _name,
+    NameId _name,
     Datatype* _type,
     Expression* _initializer
 ) noexcept
-    : name(_name), type(_type), initializer(_initializer)
+    : Declaration(NodeKind::VariableDeclaration), name(_name), type(_type),
+      canonical_type(TypeContext::instance().intern(_type)), initializer(_initializer)
 {
+    hash_combine(name);
+    hash_combine(hash_of(type));
+    hash_combine(hash_of(initializer));
 }
 
 void VariableDeclaration::destroy() noexcept{
     if (type != nullptr)
     {
-        type->destroy();
-        delete type;
+        release(type);
         type = nullptr;
     }
 
+    NativeDepthGuard depth;
+    if (depth.exhausted()){
+        destroy_children(this);
+        initializer = nullptr;
+        return;
+    }
+
     if (initializer != nullptr)
     {
-        initializer->destroy();
-        delete initializer;
+        release(initializer);
         initializer = nullptr;
     }
 }
 
-ASTNodeInterface* VariableDeclaration::copy() const noexcept{
-    return new VariableDeclaration(
-        name,
-        dynamic_cast<Datatype*>(type->copy()),
-        initializer ? dynamic_cast<Expression*>(initializer->copy()) : nullptr
-    );
-}
-
 bool VariableDeclaration::equal(ASTNodeInterface* other) const noexcept{
-    auto other_var = dynamic_cast<VariableDeclaration*>(other);
-    if (other_var == nullptr){
+    NativeDepthGuard depth;
+    if (depth.exhausted()){
+        return equal_tree(this, other);
+    }
+
+    if (other == this){
+        return true;
+    }
+
+    auto other_var = dyn_cast<VariableDeclaration>(other);
+    if (other_var == nullptr || hash() != other->hash()){
         return false;
     }
 
@@ -60,32 +72,32 @@ bool VariableDeclaration::equal(ASTNodeInterface* other) const noexcept{
 }
 
 std::pair<bool, Datatype*> VariableDeclaration::type_check() const noexcept{
+    NativeDepthGuard depth;
+    if (depth.exhausted()){
+        return type_check_tree(this);
+    }
+
     if (initializer != nullptr){
         auto init_type = initializer->type_check();
         if (!init_type.first){
-            if (init_type.second != nullptr){
-                delete init_type.second;
-                init_type.second = nullptr;
-            }
             return std::make_pair(false, nullptr);
         }
 
         // Verificando que el tipo del inicializador sea compatible con el tipo declarado
-        if (init_type.second != nullptr){
-            bool type_match = init_type.second->equal(type);
-            delete init_type.second;
-            init_type.second = nullptr;
-
-            if (!type_match){
-                return std::make_pair(false, nullptr);
-            }
+        if (init_type.second != nullptr && init_type.second != canonical_type){
+            return std::make_pair(false, nullptr);
         }
     }
 
-    return std::make_pair(true, dynamic_cast<Datatype*>(type->copy()));
+    return std::make_pair(true, canonical_type);
 }
 
 bool VariableDeclaration::resolve_name(SymbolTable& symbol_table) noexcept{
+    NativeDepthGuard depth;
+    if (depth.exhausted()){
+        return resolve_name_tree(this, symbol_table);
+    }
+
     if (!type->resolve_name(symbol_table)){
         return false;
     }
@@ -94,11 +106,16 @@ bool VariableDeclaration::resolve_name(SymbolTable& symbol_table) noexcept{
         return false;
     }
 
-    auto symbol = Symbol::build(type, name);
+    Symbol* symbol = symbol_table.make_symbol(type, name);
     return symbol_table.bind(name, symbol);
 }
 
 std::string VariableDeclaration::get_name() const noexcept
+{
+    return std::string{name_text(name)};
+}
+
+NameId VariableDeclaration::get_name_id() const noexcept
 {
     return name;
 }
@@ -108,42 +125,58 @@ Datatype* VariableDeclaration::get_type() const noexcept
     return type;
 }
 
+Datatype* VariableDeclaration::get_canonical_type() const noexcept
+{
+    return canonical_type;
+}
+
 Expression* VariableDeclaration::get_initializer() const noexcept
 {
     return initializer;
 }
 
 FunctionDeclaration::FunctionDeclaration(
-    const std::string& _name,
+    NameId _name,
     FunctionDatatype* _type,
     const Body& _body
 ) noexcept
-    : name(_name), type(_type), body(_body)
+    : Declaration(NodeKind::FunctionDeclaration), name(_name), type(_type),
+      canonical_type(TypeContext::instance().intern(_type)), body(_body)
 {
+    hash_combine(name);
+    hash_combine(hash_of(type));
+    hash_combine(body_hash(body));
 }
 
 void FunctionDeclaration::destroy() noexcept{
     if (type != nullptr)
     {
-        type->destroy();
-        delete type;
+        release(type);
         type = nullptr;
     }
 
-    destroy_body(body);
-}
+    NativeDepthGuard depth;
+    if (depth.exhausted()){
+        destroy_children(this);
+        body.clear();
+        return;
+    }
 
-ASTNodeInterface* FunctionDeclaration::copy() const noexcept{
-    return new FunctionDeclaration(
-        name,
-        dynamic_cast<FunctionDatatype*>(type->copy()),
-        copy_body(body)
-    );
+    destroy_body(body);
 }
 
 bool FunctionDeclaration::equal(ASTNodeInterface* other) const noexcept{
-    auto other_func = dynamic_cast<FunctionDeclaration*>(other);
-    if (other_func == nullptr){
+    NativeDepthGuard depth;
+    if (depth.exhausted()){
+        return equal_tree(this, other);
+    }
+
+    if (other == this){
+        return true;
+    }
+
+    auto other_func = dyn_cast<FunctionDeclaration>(other);
+    if (other_func == nullptr || hash() != other->hash()){
         return false;
     }
 
@@ -153,6 +186,11 @@ bool FunctionDeclaration::equal(ASTNodeInterface* other) const noexcept{
 }
 
 std::pair<bool, Datatype*> FunctionDeclaration::type_check() const noexcept{
+    NativeDepthGuard depth;
+    if (depth.exhausted()){
+        return type_check_tree(this);
+    }
+
     // Verificamos que el cuerpo de la función sea correcto
     auto body_result = body_type_check(body);
     if (!body_result.first){
@@ -172,45 +210,52 @@ std::pair<bool, Datatype*> FunctionDeclaration::type_check() const noexcept{
         }
     }
 
-    return std::make_pair(true, dynamic_cast<Datatype*>(type->copy()));
+    return std::make_pair(true, canonical_type);
 }
 
 bool FunctionDeclaration::resolve_name(SymbolTable& symbol_table) noexcept{
-    static bool already_resolving = false;
-    if (already_resolving) {
+    NativeDepthGuard depth;
+    if (depth.exhausted()){
+        return resolve_name_tree(this, symbol_table);
+    }
+
+    // Las funciones anidadas no se resuelven mientras se resuelve otra
+    if (symbol_table.resolve_pass().in_function) {
         return true;
     }
-    
-    already_resolving = true;
 
+    return resolve_signature(symbol_table) && resolve_body(symbol_table);
+}
+
+bool FunctionDeclaration::resolve_signature(SymbolTable& symbol_table) noexcept{
     if (!type->resolve_name(symbol_table)){
-        already_resolving = false;
         return false;
     }
 
-    auto symbol = Symbol::build(type, name);
-    if (!symbol_table.bind(name, symbol)){
-        already_resolving = false;
-        return false;
-    }
+    Symbol* symbol = symbol_table.make_symbol(type, name);
+    return symbol_table.bind(name, symbol);
+}
 
-    symbol_table.enter_scope();
+bool FunctionDeclaration::resolve_body(SymbolTable& symbol_table) noexcept{
+    SymbolTable::ResolvePass& pass = symbol_table.resolve_pass();
+    pass.in_function = true;
 
-    if (!resolve_name_param_list(type->get_parameters(), symbol_table)){
-        symbol_table.exit_scope();
-        already_resolving = false;
-        return false;
-    }
+    symbol_table.enter_scope();
 
-    bool result = resolve_name_body(body, symbol_table);
+    bool result = resolve_name_param_list(type->get_parameters(), symbol_table) &&
+                  resolve_name_body(body, symbol_table);
     
     symbol_table.exit_scope();
     
-    already_resolving = false;
+    pass.in_function = false;
     return result;
 }
 
 std::string FunctionDeclaration::get_name() const noexcept{
+    return std::string{name_text(name)};
+}
+
+NameId FunctionDeclaration::get_name_id() const noexcept{
     return name;
 }
 
@@ -218,16 +263,22 @@ Datatype* FunctionDeclaration::get_type() const noexcept{
     return type;
 }
 
+Datatype* FunctionDeclaration::get_canonical_type() const noexcept{
+    return canonical_type;
+}
+
 const Body& FunctionDeclaration::get_body() const noexcept{
     return body;
 }
 
 TempoDeclaration::TempoDeclaration(
-    const std::string& _name,
+    NameId _name,
     int _bpm
 ) noexcept
-    : name(_name), bpm(_bpm)
+    : Declaration(NodeKind::TempoDeclaration), name(_name), bpm(_bpm)
 {
+    hash_combine(name);
+    hash_combine(static_cast<std::uint64_t>(bpm));
 }
 
 void TempoDeclaration::destroy() noexcept
@@ -235,13 +286,8 @@ void TempoDeclaration::destroy() noexcept
 
 }
 
-ASTNodeInterface* TempoDeclaration::copy() const noexcept
-{
-    return new TempoDeclaration(name, bpm);
-}
-
 bool TempoDeclaration::equal(ASTNodeInterface* other) const noexcept{
-    auto other_tempo = dynamic_cast<TempoDeclaration*>(other);
+    auto other_tempo = dyn_cast<TempoDeclaration>(other);
     if (other_tempo == nullptr){
         return false;
     }
@@ -255,20 +301,24 @@ std::pair<bool, Datatype*> TempoDeclaration::type_check() const noexcept{
         return std::make_pair(false, nullptr);
     }
 
-    return std::make_pair(true, new TempoDatatype());
+    return std::make_pair(true, TypeContext::get<TempoDatatype>());
 }
 
 bool TempoDeclaration::resolve_name(SymbolTable& symbol_table) noexcept{
-    auto symbol = Symbol::build(new TempoDatatype(), name);
+    Symbol* symbol = symbol_table.make_symbol(TypeContext::get<TempoDatatype>(), name);
     return symbol_table.bind(name, symbol);
 }
 
 std::string TempoDeclaration::get_name() const noexcept{
+    return std::string{name_text(name)};
+}
+
+NameId TempoDeclaration::get_name_id() const noexcept{
     return name;
 }
 
 Datatype* TempoDeclaration::get_type() const noexcept{
-    return new TempoDatatype();
+    return TypeContext::get<TempoDatatype>();
 }
 
 int TempoDeclaration::get_bpm() const noexcept{
@@ -276,12 +326,15 @@ int TempoDeclaration::get_bpm() const noexcept{
 }
 
 KeyDeclaration::KeyDeclaration(
-    const std::string& _name,
-    const std::string& _pitch,
-    const std::string& _mode
+    NameId _name,
+    NameId _pitch,
+    NameId _mode
 ) noexcept
-    : name(_name), pitch(_pitch), mode(_mode)
+    : Declaration(NodeKind::KeyDeclaration), name(_name), pitch(_pitch), mode(_mode)
 {
+    hash_combine(name);
+    hash_combine(pitch);
+    hash_combine(mode);
 }
 
 void KeyDeclaration::destroy() noexcept
@@ -289,13 +342,8 @@ void KeyDeclaration::destroy() noexcept
     
 }
 
-ASTNodeInterface* KeyDeclaration::copy() const noexcept
-{
-    return new KeyDeclaration(name, pitch, mode);
-}
-
 bool KeyDeclaration::equal(ASTNodeInterface* other) const noexcept{
-    auto other_key = dynamic_cast<KeyDeclaration*>(other);
+    auto other_key = dyn_cast<KeyDeclaration>(other);
     if (other_key == nullptr)
     {
         return false;
@@ -309,42 +357,50 @@ bool KeyDeclaration::equal(ASTNodeInterface* other) const noexcept{
 std::pair<bool, Datatype*> KeyDeclaration::type_check() const noexcept
 {
     // Verificar que pitch (Do, Re, etc.) y mode(M, m) sean válidos
-    return std::make_pair(true, new KeyDatatype());
+    return std::make_pair(true, TypeContext::get<KeyDatatype>());
 }
 
 bool KeyDeclaration::resolve_name(SymbolTable& symbol_table) noexcept
 {
-    auto symbol = Symbol::build(new KeyDatatype(), name);
+    Symbol* symbol = symbol_table.make_symbol(TypeContext::get<KeyDatatype>(), name);
     return symbol_table.bind(name, symbol);
 }
 
 std::string KeyDeclaration::get_name() const noexcept
+{
+    return std::string{name_text(name)};
+}
+
+NameId KeyDeclaration::get_name_id() const noexcept
 {
     return name;
 }
 
 Datatype* KeyDeclaration::get_type() const noexcept
 {
-    return new KeyDatatype();
+    return TypeContext::get<KeyDatatype>();
 }
 
-const std::string& KeyDeclaration::get_pitch() const noexcept
+std::string_view KeyDeclaration::get_pitch() const noexcept
 {
-    return pitch;
+    return name_text(pitch);
 }
 
-const std::string& KeyDeclaration::get_mode() const noexcept
+std::string_view KeyDeclaration::get_mode() const noexcept
 {
-    return mode;
+    return name_text(mode);
 }
 
 TimeSignatureDeclaration::TimeSignatureDeclaration(
-    const std::string& _name,
+    NameId _name,
     int _numerator,
     int _denominator
 ) noexcept
-    : name(_name), numerator(_numerator), denominator(_denominator)
+    : Declaration(NodeKind::TimeSignatureDeclaration), name(_name), numerator(_numerator), denominator(_denominator)
 {
+    hash_combine(name);
+    hash_combine(static_cast<std::uint64_t>(numerator));
+    hash_combine(static_cast<std::uint64_t>(denominator));
 }
 
 void TimeSignatureDeclaration::destroy() noexcept
@@ -352,13 +408,8 @@ void TimeSignatureDeclaration::destroy() noexcept
 
 }
 
-ASTNodeInterface* TimeSignatureDeclaration::copy() const noexcept
-{
-    return new TimeSignatureDeclaration(name, numerator, denominator);
-}
-
 bool TimeSignatureDeclaration::equal(ASTNodeInterface* other) const noexcept{
-    auto other_time = dynamic_cast<TimeSignatureDeclaration*>(other);
+    auto other_time = dyn_cast<TimeSignatureDeclaration>(other);
     if (other_time == nullptr)
     {
         return false;
@@ -376,23 +427,28 @@ std::pair<bool, Datatype*> TimeSignatureDeclaration::type_check() const noexcept
         return std::make_pair(false, nullptr);
     }
 
-    return std::make_pair(true, new TimeSignatureDatatype());
+    return std::make_pair(true, TypeContext::get<TimeSignatureDatatype>());
 }
 
 bool TimeSignatureDeclaration::resolve_name(SymbolTable& symbol_table) noexcept
 {
-    auto symbol = Symbol::build(new TimeSignatureDatatype(), name);
+    Symbol* symbol = symbol_table.make_symbol(TypeContext::get<TimeSignatureDatatype>(), name);
     return symbol_table.bind(name, symbol);
 }
 
 std::string TimeSignatureDeclaration::get_name() const noexcept
+{
+    return std::string{name_text(name)};
+}
+
+NameId TimeSignatureDeclaration::get_name_id() const noexcept
 {
     return name;
 }
 
 Datatype* TimeSignatureDeclaration::get_type() const noexcept
 {
-    return new TimeSignatureDatatype();
+    return TypeContext::get<TimeSignatureDatatype>();
 }
 
 int TimeSignatureDeclaration::get_numerator() const noexcept
@@ -406,13 +462,17 @@ int TimeSignatureDeclaration::get_denominator() const noexcept
 }
 
 NoteDeclaration::NoteDeclaration(
-    const std::string& _name,
+    NameId _name,
     char _pitch,
     int _octave,
-    const std::string& _duration
+    NameId _duration
 ) noexcept
-    : name(_name), pitch(_pitch), octave(_octave), duration(_duration)
+    : Declaration(NodeKind::NoteDeclaration), name(_name), pitch(_pitch), octave(_octave), duration(_duration)
 {
+    hash_combine(name);
+    hash_combine(static_cast<std::uint64_t>(pitch));
+    hash_combine(static_cast<std::uint64_t>(octave));
+    hash_combine(duration);
 }
 
 void NoteDeclaration::destroy() noexcept
@@ -420,13 +480,8 @@ void NoteDeclaration::destroy() noexcept
 
 }
 
-ASTNodeInterface* NoteDeclaration::copy() const noexcept
-{
-    return new NoteDeclaration(name, pitch, octave, duration);
-}
-
 bool NoteDeclaration::equal(ASTNodeInterface* other) const noexcept{
-    auto other_note = dynamic_cast<NoteDeclaration*>(other);
+    auto other_note = dyn_cast<NoteDeclaration>(other);
     if (other_note == nullptr)
     {
         return false;
@@ -447,29 +502,35 @@ std::pair<bool, Datatype*> NoteDeclaration::type_check() const noexcept{
     }
 
     // Verificar duración válida
-    if (duration != "Blanca" && duration != "Negra" && 
-        duration != "Corchea" && duration != "Semicorchea")
+    std::string_view duration_name = name_text(duration);
+    if (duration_name != "Blanca" && duration_name != "Negra" && 
+        duration_name != "Corchea" && duration_name != "Semicorchea")
     {
         return std::make_pair(false, nullptr);
     }
 
-    return std::make_pair(true, new NoteDatatype());
+    return std::make_pair(true, TypeContext::get<NoteDatatype>());
 }
 
 bool NoteDeclaration::resolve_name(SymbolTable& symbol_table) noexcept
 {
-    auto symbol = Symbol::build(new NoteDatatype(), name);
+    Symbol* symbol = symbol_table.make_symbol(TypeContext::get<NoteDatatype>(), name);
     return symbol_table.bind(name, symbol);
 }
 
 std::string NoteDeclaration::get_name() const noexcept
+{
+    return std::string{name_text(name)};
+}
+
+NameId NoteDeclaration::get_name_id() const noexcept
 {
     return name;
 }
 
 Datatype* NoteDeclaration::get_type() const noexcept
 {
-    return new NoteDatatype();
+    return TypeContext::get<NoteDatatype>();
 }
 
 char NoteDeclaration::get_pitch() const noexcept
@@ -482,7 +543,7 @@ int NoteDeclaration::get_octave() const noexcept
     return octave;
 }
 
-const std::string& NoteDeclaration::get_duration() const noexcept
+std::string_view NoteDeclaration::get_duration() const noexcept
 {
-    return duration;
+    return name_text(duration);
 } 
\ No newline at end of file
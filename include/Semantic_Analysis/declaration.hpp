@@ -6,23 +6,37 @@
 class Declaration : public ASTNodeInterface
 {
 public:
+    static bool classof(const ASTNodeInterface* node) noexcept
+    {
+        return node->get_kind() >= NodeKind::FirstDeclaration && node->get_kind() <= NodeKind::LastDeclaration;
+    }
+
     virtual std::string get_name() const noexcept = 0;
+
+    // Id internado del nombre (para comparar y buscar sin tocar la cadena)
+    virtual NameId get_name_id() const noexcept = 0;
     
     virtual Datatype* get_type() const noexcept = 0;
+
+protected:
+    using ASTNodeInterface::ASTNodeInterface;
 };
 
 class VariableDeclaration : public Declaration
 {
 public:
     VariableDeclaration(
-        const std::string& name,
+        NameId name,
         Datatype* type,
         Expression* initializer = nullptr
     ) noexcept;
 
-    void destroy() noexcept override;
+    static bool classof(const ASTNodeInterface* node) noexcept
+    {
+        return node->get_kind() == NodeKind::VariableDeclaration;
+    }
 
-    ASTNodeInterface* copy() const noexcept override;
+    void destroy() noexcept override;
 
     bool equal(ASTNodeInterface* other) const noexcept override;
 
@@ -31,14 +45,21 @@ public:
     bool resolve_name(SymbolTable& symbol_table) noexcept override;
     
     std::string get_name() const noexcept override;
+
+    NameId get_name_id() const noexcept override;
     
     Datatype* get_type() const noexcept override;
+
+    // get_type() en su versión canónica (ver TypeContext), internada al
+    // construir la declaración: la comprobación de tipos no la vuelve a buscar
+    Datatype* get_canonical_type() const noexcept;
     
     Expression* get_initializer() const noexcept;
 
 private:
-    std::string name;
+    NameId name;
     Datatype* type;
+    Datatype* canonical_type;
     Expression* initializer;
 };
 
@@ -47,13 +68,16 @@ class TempoDeclaration : public Declaration
 {
 public:
     TempoDeclaration(
-        const std::string& name,
+        NameId name,
         int bpm
     ) noexcept;
 
-    void destroy() noexcept override;
+    static bool classof(const ASTNodeInterface* node) noexcept
+    {
+        return node->get_kind() == NodeKind::TempoDeclaration;
+    }
 
-    ASTNodeInterface* copy() const noexcept override;
+    void destroy() noexcept override;
 
     bool equal(ASTNodeInterface* other) const noexcept override;
 
@@ -62,13 +86,15 @@ public:
     bool resolve_name(SymbolTable& symbol_table) noexcept override;
     
     std::string get_name() const noexcept override;
+
+    NameId get_name_id() const noexcept override;
     
     Datatype* get_type() const noexcept override;
     
     int get_bpm() const noexcept;
 
 private:
-    std::string name;
+    NameId name;
     int bpm;
 };
 
@@ -76,14 +102,17 @@ class KeyDeclaration : public Declaration
 {
 public:
     KeyDeclaration(
-        const std::string& name,
-        const std::string& pitch,
-        const std::string& mode
+        NameId name,
+        NameId pitch,
+        NameId mode
     ) noexcept;
 
-    void destroy() noexcept override;
+    static bool classof(const ASTNodeInterface* node) noexcept
+    {
+        return node->get_kind() == NodeKind::KeyDeclaration;
+    }
 
-    ASTNodeInterface* copy() const noexcept override;
+    void destroy() noexcept override;
 
     bool equal(ASTNodeInterface* other) const noexcept override;
 
@@ -92,30 +121,35 @@ public:
     bool resolve_name(SymbolTable& symbol_table) noexcept override;
     
     std::string get_name() const noexcept override;
+
+    NameId get_name_id() const noexcept override;
     
     Datatype* get_type() const noexcept override;
     
-    const std::string& get_pitch() const noexcept;
-    const std::string& get_mode() const noexcept;
+    std::string_view get_pitch() const noexcept;
+    std::string_view get_mode() const noexcept;
 
 private:
-    std::string name;
-    std::string pitch;  // Nota base (Do, Re, etc.)
-    std::string mode;   // Modo (M, m)
+    NameId name;
+    NameId pitch;  // Nota base (Do, Re, etc.)
+    NameId mode;   // Modo (M, m)
 };
 
 class TimeSignatureDeclaration : public Declaration
 {
 public:
     TimeSignatureDeclaration(
-        const std::string& name,
+        NameId name,
         int numerator,
         int denominator
     ) noexcept;
 
-    void destroy() noexcept override;
+    static bool classof(const ASTNodeInterface* node) noexcept
+    {
+        return node->get_kind() == NodeKind::TimeSignatureDeclaration;
+    }
 
-    ASTNodeInterface* copy() const noexcept override;
+    void destroy() noexcept override;
 
     bool equal(ASTNodeInterface* other) const noexcept override;
 
@@ -124,6 +158,8 @@ public:
     bool resolve_name(SymbolTable& symbol_table) noexcept override;
     
     std::string get_name() const noexcept override;
+
+    NameId get_name_id() const noexcept override;
     
     Datatype* get_type() const noexcept override;
     
@@ -131,7 +167,7 @@ public:
     int get_denominator() const noexcept;
 
 private:
-    std::string name;
+    NameId name;
     int numerator;
     int denominator;
 };
@@ -140,15 +176,18 @@ class NoteDeclaration : public Declaration
 {
 public:
     NoteDeclaration(
-        const std::string& name,
+        NameId name,
         char pitch,
         int octave,
-        const std::string& duration
+        NameId duration
     ) noexcept;
 
-    void destroy() noexcept override;
+    static bool classof(const ASTNodeInterface* node) noexcept
+    {
+        return node->get_kind() == NodeKind::NoteDeclaration;
+    }
 
-    ASTNodeInterface* copy() const noexcept override;
+    void destroy() noexcept override;
 
     bool equal(ASTNodeInterface* other) const noexcept override;
 
@@ -157,47 +196,64 @@ public:
     bool resolve_name(SymbolTable& symbol_table) noexcept override;
     
     std::string get_name() const noexcept override;
+
+    NameId get_name_id() const noexcept override;
     
     Datatype* get_type() const noexcept override;
     
     char get_pitch() const noexcept;
     int get_octave() const noexcept;
-    const std::string& get_duration() const noexcept;
+    std::string_view get_duration() const noexcept;
 
 private:
-    std::string name;
+    NameId name;
     char pitch;          // C, D, E, F, G, A, B
     int octave;          // 0-8
-    std::string duration; // Blanca, Negra, Corchea, Semicorchea
+    NameId duration;     // Blanca, Negra, Corchea, Semicorchea
 };
 
 class FunctionDeclaration : public Declaration
 {
 public:
     FunctionDeclaration(
-        const std::string& name,
+        NameId name,
         FunctionDatatype* type,
         const Body& body
     ) noexcept;
 
-    void destroy() noexcept override;
+    static bool classof(const ASTNodeInterface* node) noexcept
+    {
+        return node->get_kind() == NodeKind::FunctionDeclaration;
+    }
 
-    ASTNodeInterface* copy() const noexcept override;
+    void destroy() noexcept override;
 
     bool equal(ASTNodeInterface* other) const noexcept override;
 
     std::pair<bool, Datatype*> type_check() const noexcept override;
 
     bool resolve_name(SymbolTable& symbol_table) noexcept override;
+
+    // Las dos mitades de resolve_name: resolver el tipo y enlazar el nombre en
+    // el ámbito actual, y resolver parámetros y cuerpo en un ámbito propio
+    bool resolve_signature(SymbolTable& symbol_table) noexcept;
+
+    bool resolve_body(SymbolTable& symbol_table) noexcept;
     
     std::string get_name() const noexcept override;
+
+    NameId get_name_id() const noexcept override;
     
     Datatype* get_type() const noexcept override;
+
+    // get_type() en su versión canónica, internada al construir la declaración
+    Datatype* get_canonical_type() const noexcept;
     
     const Body& get_body() const noexcept;
 
 private:
-    std::string name;
+    NameId name;
     FunctionDatatype* type;
+    Datatype* canonical_type;
     Body body;
 }; 
\ No newline at end of file
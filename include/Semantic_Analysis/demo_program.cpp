@@ -32,10 +32,14 @@
 
 #include <iostream>
 #include <iomanip>
+#include <string>
 
 #include "datatype.hpp"
 #include "declaration.hpp"
 #include "expression.hpp"
+#include "note_stream.hpp"
+#include "pass_manager.hpp"
+#include "stats.hpp"
 #include "statement.hpp"
 #include "symbol_table.hpp"
 
@@ -45,268 +49,346 @@ void print_validation_result(const std::string& node_name, bool success) {
               << " | " << (success ? "✓ ÉXITO" : "✗ ERROR") << std::endl;
 }
 
-int main(){
-    try {
-        std::cout << "====== Compilador Musical: Demo de Análisis Semántico ======" << std::endl;
-        
-        // Declaración de variables globales (configuración musical)
-        auto tempo_declaration = new TempoDeclaration{
-            "tempo", 120
-        };
-        
-        auto key_declaration = new KeyDeclaration{
-            "tonalidad", "Si", "M"
-        };
-        
-        auto time_declaration = new TimeSignatureDeclaration{
-            "compas", 7, 8
-        };
-        
-        // Comentario para la primera secuencia
-        auto comment1 = new PrintStatement{
-            new StrExpression{"// Patrones rítmicos en 7/8 (agrupados 2+2+3)"}
-        };
-        
-        // Primera secuencia de notas: patrón 2+2+3 en corcheas
-        auto nota1 = new NoteDeclaration{
-            "nota1", 'G', 4, "Corchea"
-        };
-        
-        auto nota2 = new NoteDeclaration{
-            "nota2", 'G', 4, "Corchea"
-        };
-        
-        auto nota3 = new NoteDeclaration{
-            "nota3", 'A', 4, "Corchea"
-        };
-        
-        auto nota4 = new NoteDeclaration{
-            "nota4", 'A', 4, "Corchea"
-        };
-        
-        auto nota5 = new NoteDeclaration{
-            "nota5", 'B', 4, "Corchea"
-        };
-        
-        auto nota6 = new NoteDeclaration{
-            "nota6", 'B', 4, "Corchea"
-        };
-        
-        auto nota7 = new NoteDeclaration{
-            "nota7", 'B', 4, "Corchea"
-        };
-        
-        // Comentario para la segunda secuencia
-        auto comment2 = new PrintStatement{
-            new StrExpression{"// Otro patrón rítmico (3+2+2)"}
-        };
-        
-        // Segunda secuencia de notas: notas con alteraciones
-        auto nota8 = new NoteDeclaration{
-            "nota8", 'C', 5, "Corchea"
-        };
-        
-        auto nota9 = new NoteDeclaration{
-            "nota9", 'C', 5, "Corchea"
-        };
-        
-        auto nota10 = new NoteDeclaration{
-            "nota10", 'C', 5, "Corchea"
-        };
-        
-        // Aplicar sostenidos
-        auto sharp_nota8 = new SharpExpression{
-            new NameExpression{"nota8"}
-        };
-        
-        auto sharp_nota9 = new SharpExpression{
-            new NameExpression{"nota9"}
-        };
-        
-        auto sharp_nota10 = new SharpExpression{
-            new NameExpression{"nota10"}
-        };
-        
-        // Comentario para la tercera secuencia
-        auto comment3 = new PrintStatement{
-            new StrExpression{"// Mezcla de duraciones"}
-        };
-        
-        // Tercera secuencia: mezcla de duraciones
-        auto nota11 = new NoteDeclaration{
-            "nota11", 'F', 4, "Negra"
-        };
-        
-        auto nota12 = new NoteDeclaration{
-            "nota12", 'B', 4, "Negra"
-        };
-        
-        auto nota13 = new NoteDeclaration{
-            "nota13", 'C', 5, "Semicorchea"
-        };
-        
-        // Aplicar sostenido a F4 y C5
-        auto sharp_nota11 = new SharpExpression{
-            new NameExpression{"nota11"}
-        };
-        
-        auto sharp_nota13 = new SharpExpression{
-            new NameExpression{"nota13"}
-        };
+// Descripción de una sentencia en la tabla de resolución de nombres
+std::string describe_for_resolution(Statement* statement) {
+    std::string node_description;
+    
+    // Determinar el tipo de nodo para mostrar información específica
+    if (auto decl_stmt = dyn_cast<DeclarationStatement>(statement)) {
+        if (auto var_decl = dyn_cast<VariableDeclaration>(decl_stmt->get_declaration())) {
+            node_description = "Variable: " + var_decl->get_name();
+        } else if (auto tempo_decl = dyn_cast<TempoDeclaration>(decl_stmt->get_declaration())) {
+            node_description = "Tempo: " + tempo_decl->get_name() + " (" + std::to_string(tempo_decl->get_bpm()) + " BPM)";
+        } else if (auto key_decl = dyn_cast<KeyDeclaration>(decl_stmt->get_declaration())) {
+            node_description = "Tonalidad: " + key_decl->get_name() + " (" + std::string(key_decl->get_pitch()) + " " + std::string(key_decl->get_mode()) + ")";
+        } else if (auto time_decl = dyn_cast<TimeSignatureDeclaration>(decl_stmt->get_declaration())) {
+            node_description = "Compás: " + time_decl->get_name() + " (" + 
+                             std::to_string(time_decl->get_numerator()) + "/" + 
+                             std::to_string(time_decl->get_denominator()) + ")";
+        } else if (auto note_decl = dyn_cast<NoteDeclaration>(decl_stmt->get_declaration())) {
+            node_description = "Nota: " + note_decl->get_name() + " (" + 
+                             std::string(1, note_decl->get_pitch()) + 
+                             std::to_string(note_decl->get_octave()) + " " + 
+                             std::string(note_decl->get_duration()) + ")";
+        } else {
+            node_description = "Declaración";
+        }
+    } else if (auto expr_stmt = dyn_cast<ExpressionStatement>(statement)) {
+        if (dyn_cast<SharpExpression>(expr_stmt->get_expression())) {
+            node_description = "Sostenido";
+        } else {
+            node_description = "Expresión";
+        }
+    } else if (dyn_cast<PrintStatement>(statement)) {
+        node_description = "Comentario";
+    } else {
+        node_description = "Nodo desconocido";
+    }
+    
+    return node_description;
+}
+
+// Descripción de una sentencia en la tabla de comprobación de tipos
+std::string describe_for_type_check(Statement* statement) {
+    std::string node_description;
+    
+    // Determinar el tipo de nodo para mostrar información específica 
+    if (auto decl_stmt = dyn_cast<DeclarationStatement>(statement)) {
+        if (auto var_decl = dyn_cast<VariableDeclaration>(decl_stmt->get_declaration())) {
+            node_description = "Variable: " + var_decl->get_name();
+        } else if (auto tempo_decl = dyn_cast<TempoDeclaration>(decl_stmt->get_declaration())) {
+            node_description = "Tempo: " + tempo_decl->get_name();
+        } else if (auto key_decl = dyn_cast<KeyDeclaration>(decl_stmt->get_declaration())) {
+            node_description = "Tonalidad: " + key_decl->get_name();
+        } else if (auto time_decl = dyn_cast<TimeSignatureDeclaration>(decl_stmt->get_declaration())) {
+            node_description = "Compás: " + time_decl->get_name();
+        } else if (auto note_decl = dyn_cast<NoteDeclaration>(decl_stmt->get_declaration())) {
+            node_description = "Nota: " + note_decl->get_name();
+        } else {
+            node_description = "Declaración";
+        }
+    } else if (auto expr_stmt = dyn_cast<ExpressionStatement>(statement)) {
+        if (dyn_cast<SharpExpression>(expr_stmt->get_expression())) {
+            node_description = "Sostenido";
+        } else {
+            node_description = "Expresión";
+        }
+    } else if (dyn_cast<PrintStatement>(statement)) {
+        node_description = "Comentario";
+    } else {
+        node_description = "Nodo desconocido";
+    }
+    
+    return node_description;
+}
+
+// Construir el AST del programa de ejemplo (el demo no tiene texto fuente:
+// este pase ocupa el lugar de lex y parse)
+Body build_program() {
+    // Declaración de variables globales (configuración musical)
+    auto tempo_declaration = new TempoDeclaration{
+        intern_name("tempo"), 120
+    };
+    
+    auto key_declaration = new KeyDeclaration{
+        intern_name("tonalidad"), intern_name("Si"), intern_name("M")
+    };
+    
+    auto time_declaration = new TimeSignatureDeclaration{
+        intern_name("compas"), 7, 8
+    };
+    
+    // Comentario para la primera secuencia
+    auto comment1 = new PrintStatement{
+        new StrExpression{"// Patrones rítmicos en 7/8 (agrupados 2+2+3)"}
+    };
+    
+    // Primera secuencia de notas: patrón 2+2+3 en corcheas
+    auto nota1 = new NoteDeclaration{
+        intern_name("nota1"), 'G', 4, intern_name("Corchea")
+    };
+    
+    auto nota2 = new NoteDeclaration{
+        intern_name("nota2"), 'G', 4, intern_name("Corchea")
+    };
+    
+    auto nota3 = new NoteDeclaration{
+        intern_name("nota3"), 'A', 4, intern_name("Corchea")
+    };
+    
+    auto nota4 = new NoteDeclaration{
+        intern_name("nota4"), 'A', 4, intern_name("Corchea")
+    };
+    
+    auto nota5 = new NoteDeclaration{
+        intern_name("nota5"), 'B', 4, intern_name("Corchea")
+    };
+    
+    auto nota6 = new NoteDeclaration{
+        intern_name("nota6"), 'B', 4, intern_name("Corchea")
+    };
+    
+    auto nota7 = new NoteDeclaration{
+        intern_name("nota7"), 'B', 4, intern_name("Corchea")
+    };
+    
+    // Comentario para la segunda secuencia
+    auto comment2 = new PrintStatement{
+        new StrExpression{"// Otro patrón rítmico (3+2+2)"}
+    };
+    
+    // Segunda secuencia de notas: notas con alteraciones
+    auto nota8 = new NoteDeclaration{
+        intern_name("nota8"), 'C', 5, intern_name("Corchea")
+    };
+    
+    auto nota9 = new NoteDeclaration{
+        intern_name("nota9"), 'C', 5, intern_name("Corchea")
+    };
+    
+    auto nota10 = new NoteDeclaration{
+        intern_name("nota10"), 'C', 5, intern_name("Corchea")
+    };
+    
+    // Aplicar sostenidos
+    auto sharp_nota8 = new SharpExpression{
+        new NameExpression{intern_name("nota8")}
+    };
+    
+    auto sharp_nota9 = new SharpExpression{
+        new NameExpression{intern_name("nota9")}
+    };
+    
+    auto sharp_nota10 = new SharpExpression{
+        new NameExpression{intern_name("nota10")}
+    };
+    
+    // Comentario para la tercera secuencia
+    auto comment3 = new PrintStatement{
+        new StrExpression{"// Mezcla de duraciones"}
+    };
+    
+    // Tercera secuencia: mezcla de duraciones
+    auto nota11 = new NoteDeclaration{
+        intern_name("nota11"), 'F', 4, intern_name("Negra")
+    };
+    
+    auto nota12 = new NoteDeclaration{
+        intern_name("nota12"), 'B', 4, intern_name("Negra")
+    };
+    
+    auto nota13 = new NoteDeclaration{
+        intern_name("nota13"), 'C', 5, intern_name("Semicorchea")
+    };
+    
+    // Aplicar sostenido a F4 y C5
+    auto sharp_nota11 = new SharpExpression{
+        new NameExpression{intern_name("nota11")}
+    };
+    
+    auto sharp_nota13 = new SharpExpression{
+        new NameExpression{intern_name("nota13")}
+    };
+    
+    // programa completo
+    return Body{
+        // Configuración
+        new DeclarationStatement{tempo_declaration},
+        new DeclarationStatement{key_declaration},
+        new DeclarationStatement{time_declaration},
+        
+        // Primera secuencia
+        comment1,
+        new DeclarationStatement{nota1},
+        new DeclarationStatement{nota2},
+        new DeclarationStatement{nota3},
+        new DeclarationStatement{nota4},
+        new DeclarationStatement{nota5},
+        new DeclarationStatement{nota6},
+        new DeclarationStatement{nota7},
+        
+        // Segunda secuencia
+        comment2,
+        new DeclarationStatement{nota8},
+        new ExpressionStatement{sharp_nota8},
+        new DeclarationStatement{nota9},
+        new ExpressionStatement{sharp_nota9},
+        new DeclarationStatement{nota10},
+        new ExpressionStatement{sharp_nota10},
+        
+        // Tercera secuencia
+        comment3,
+        new DeclarationStatement{nota11},
+        new ExpressionStatement{sharp_nota11},
+        new DeclarationStatement{nota12},
+        new DeclarationStatement{nota13},
+        new ExpressionStatement{sharp_nota13}
+    };
+}
+
+// Resolver los nombres sentencia por sentencia e imprimir los resultados
+bool resolve_program(Body& program, SymbolTable& symbol_table) {
+    std::cout << "\n=== Resolución de nombres ===\n" << std::endl;
+    std::cout << std::setw(40) << std::left << "NODO" << " | RESULTADO" << std::endl;
+    std::cout << std::string(60, '-') << std::endl;
+    
+    bool all_names_resolved = true;
+    
+    // Procesar cada nodo individualmente e imprimir resultados
+    for (Statement* statement : program) {
+        bool success = statement->resolve_name(symbol_table);
+        print_validation_result(describe_for_resolution(statement), success);
         
-        // programa completo
-        auto program = Body{
-            // Configuración
-            new DeclarationStatement{tempo_declaration},
-            new DeclarationStatement{key_declaration},
-            new DeclarationStatement{time_declaration},
-            
-            // Primera secuencia
-            comment1,
-            new DeclarationStatement{nota1},
-            new DeclarationStatement{nota2},
-            new DeclarationStatement{nota3},
-            new DeclarationStatement{nota4},
-            new DeclarationStatement{nota5},
-            new DeclarationStatement{nota6},
-            new DeclarationStatement{nota7},
-            
-            // Segunda secuencia
-            comment2,
-            new DeclarationStatement{nota8},
-            new ExpressionStatement{sharp_nota8},
-            new DeclarationStatement{nota9},
-            new ExpressionStatement{sharp_nota9},
-            new DeclarationStatement{nota10},
-            new ExpressionStatement{sharp_nota10},
-            
-            // Tercera secuencia
-            comment3,
-            new DeclarationStatement{nota11},
-            new ExpressionStatement{sharp_nota11},
-            new DeclarationStatement{nota12},
-            new DeclarationStatement{nota13},
-            new ExpressionStatement{sharp_nota13}
-        };
+        if (!success) {
+            all_names_resolved = false;
+        }
+    }
+    
+    std::cout << "\nResultado final de resolución de nombres: " 
+             << (all_names_resolved ? "✓ ÉXITO" : "✗ ERROR") << std::endl;
+    return all_names_resolved;
+}
+
+// Comprobar los tipos sentencia por sentencia e imprimir los resultados
+bool type_check_program(const Body& program) {
+    std::cout << "\n=== Comprobación de tipos ===\n" << std::endl;
+    std::cout << std::setw(40) << std::left << "NODO" << " | RESULTADO" << std::endl;
+    std::cout << std::string(60, '-') << std::endl;
+    
+    bool all_types_valid = true;
+    
+    // Procesar cada nodo individualmente para comprobación de tipos
+    for (Statement* statement : program) {
+        // El tipo devuelto es canónico y no se libera
+        auto type_result = statement->type_check();
+        bool success = type_result.first;
         
-        // Realizar análisis semántico 
-        std::cout << "\n=== Resolución de nombres ===\n" << std::endl;
-        std::cout << std::setw(40) << std::left << "NODO" << " | RESULTADO" << std::endl;
-        std::cout << std::string(60, '-') << std::endl;
+        print_validation_result(describe_for_type_check(statement), success);
         
+        if (!success) {
+            all_types_valid = false;
+        }
+    }
+    
+    std::cout << "\nResultado final de comprobación de tipos: " 
+             << (all_types_valid ? "✓ ÉXITO" : "✗ ERROR") << std::endl;
+    return all_types_valid;
+}
+
+// Comprobación lineal sobre la representación plana de las notas
+bool lower_program(const Body& program) {
+    std::cout << "\n=== Flujo de notas (NoteStream) ===\n" << std::endl;
+    NoteStream note_stream;
+    lower_body_notes(program, note_stream);
+    std::cout << "Notas en el flujo: " << note_stream.size() << std::endl;
+    
+    bool success = note_stream.type_check();
+    std::cout << "Resultado de comprobación del flujo: " 
+             << (success ? "✓ ÉXITO" : "✗ ERROR") << std::endl;
+    return success;
+}
+
+void print_help() {
+    std::cout << "Uso: musical_semantic_analyzer [--time-passes] [--stats] [--disable-pass PASE] [--enable-pass PASE]" << std::endl;
+    std::cout << "Construye y analiza el programa musical de ejemplo." << std::endl;
+    std::cout << "Pases: build, resolve, type-check, lowering. Un pase que falla detiene los siguientes." << std::endl;
+}
+
+int main(int argc, char** argv){
+    PassOptions options;
+    for (int i = 1; i < argc; i++) {
+        std::string error;
+        if (std::string(argv[i]) == "--help" || std::string(argv[i]) == "-h") {
+            print_help();
+            return EXIT_SUCCESS;
+        }
+        if (!parse_pass_option(argc, argv, i, options, error)) {
+            error = std::string("opción desconocida ") + argv[i];
+        }
+        if (!error.empty()) {
+            std::cerr << "ERROR: " << error << std::endl;
+            print_help();
+            return EXIT_FAILURE;
+        }
+    }
+
+    try {
+        Body program;
         SymbolTable symbol_table;
-        bool all_names_resolved = true;
         
-        // Procesar cada nodo individualmente e imprimir resultados
-        for (Statement* statement : program) {
-            std::string node_description;
-            
-            // Determinar el tipo de nodo para mostrar información específica
-            if (auto decl_stmt = dynamic_cast<DeclarationStatement*>(statement)) {
-                if (auto var_decl = dynamic_cast<VariableDeclaration*>(decl_stmt->get_declaration())) {
-                    node_description = "Variable: " + var_decl->get_name();
-                } else if (auto tempo_decl = dynamic_cast<TempoDeclaration*>(decl_stmt->get_declaration())) {
-                    node_description = "Tempo: " + tempo_decl->get_name() + " (" + std::to_string(tempo_decl->get_bpm()) + " BPM)";
-                } else if (auto key_decl = dynamic_cast<KeyDeclaration*>(decl_stmt->get_declaration())) {
-                    node_description = "Tonalidad: " + key_decl->get_name() + " (" + key_decl->get_pitch() + " " + key_decl->get_mode() + ")";
-                } else if (auto time_decl = dynamic_cast<TimeSignatureDeclaration*>(decl_stmt->get_declaration())) {
-                    node_description = "Compás: " + time_decl->get_name() + " (" + 
-                                     std::to_string(time_decl->get_numerator()) + "/" + 
-                                     std::to_string(time_decl->get_denominator()) + ")";
-                } else if (auto note_decl = dynamic_cast<NoteDeclaration*>(decl_stmt->get_declaration())) {
-                    node_description = "Nota: " + note_decl->get_name() + " (" + 
-                                     std::string(1, note_decl->get_pitch()) + 
-                                     std::to_string(note_decl->get_octave()) + " " + 
-                                     note_decl->get_duration() + ")";
-                } else {
-                    node_description = "Declaración";
-                }
-            } else if (auto expr_stmt = dynamic_cast<ExpressionStatement*>(statement)) {
-                if (dynamic_cast<SharpExpression*>(expr_stmt->get_expression())) {
-                    node_description = "Sostenido";
-                } else {
-                    node_description = "Expresión";
-                }
-            } else if (dynamic_cast<PrintStatement*>(statement)) {
-                node_description = "Comentario";
-            } else {
-                node_description = "Nodo desconocido";
-            }
-            
-            bool success = statement->resolve_name(symbol_table);
-            print_validation_result(node_description, success);
-            
-            if (!success) {
-                all_names_resolved = false;
-            }
+        PassManager passes;
+        passes.add_pass("build", [&]() {
+            program = build_program();
+            return true;
+        });
+        passes.add_pass("resolve", [&]() { return resolve_program(program, symbol_table); });
+        passes.add_pass("type-check", [&]() { return type_check_program(program); });
+        passes.add_pass("lowering", [&]() { return lower_program(program); });
+        
+        std::string unknown;
+        if (!passes.configure(options, unknown)) {
+            std::cerr << "ERROR: pase desconocido " << unknown << " (pases: " << passes.get_pass_names() << ")" << std::endl;
+            return EXIT_FAILURE;
         }
         
-        std::cout << "\nResultado final de resolución de nombres: " 
-                 << (all_names_resolved ? "✓ ÉXITO" : "✗ ERROR") << std::endl;
+        std::cout << "====== Compilador Musical: Demo de Análisis Semántico ======" << std::endl;
         
-        if (all_names_resolved) {
-            std::cout << "\n=== Comprobación de tipos ===\n" << std::endl;
-            std::cout << std::setw(40) << std::left << "NODO" << " | RESULTADO" << std::endl;
-            std::cout << std::string(60, '-') << std::endl;
-            
-            bool all_types_valid = true;
-            
-            // Procesar cada nodo individualmente para comprobación de tipos
-            for (Statement* statement : program) {
-                std::string node_description;
-                
-                // Determinar el tipo de nodo para mostrar información específica 
-                if (auto decl_stmt = dynamic_cast<DeclarationStatement*>(statement)) {
-                    if (auto var_decl = dynamic_cast<VariableDeclaration*>(decl_stmt->get_declaration())) {
-                        node_description = "Variable: " + var_decl->get_name();
-                    } else if (auto tempo_decl = dynamic_cast<TempoDeclaration*>(decl_stmt->get_declaration())) {
-                        node_description = "Tempo: " + tempo_decl->get_name();
-                    } else if (auto key_decl = dynamic_cast<KeyDeclaration*>(decl_stmt->get_declaration())) {
-                        node_description = "Tonalidad: " + key_decl->get_name();
-                    } else if (auto time_decl = dynamic_cast<TimeSignatureDeclaration*>(decl_stmt->get_declaration())) {
-                        node_description = "Compás: " + time_decl->get_name();
-                    } else if (auto note_decl = dynamic_cast<NoteDeclaration*>(decl_stmt->get_declaration())) {
-                        node_description = "Nota: " + note_decl->get_name();
-                    } else {
-                        node_description = "Declaración";
-                    }
-                } else if (auto expr_stmt = dynamic_cast<ExpressionStatement*>(statement)) {
-                    if (dynamic_cast<SharpExpression*>(expr_stmt->get_expression())) {
-                        node_description = "Sostenido";
-                    } else {
-                        node_description = "Expresión";
-                    }
-                } else if (dynamic_cast<PrintStatement*>(statement)) {
-                    node_description = "Comentario";
-                } else {
-                    node_description = "Nodo desconocido";
-                }
-                
-                auto type_result = statement->type_check();
-                bool success = type_result.first;
-                
-                // Limpiar el tipo devuelto si existe
-                if (type_result.second != nullptr) {
-                    type_result.second->destroy();
-                    delete type_result.second;
-                }
-                
-                print_validation_result(node_description, success);
-                
-                if (!success) {
-                    all_types_valid = false;
-                }
-            }
-            
-            std::cout << "\nResultado final de comprobación de tipos: " 
-                     << (all_types_valid ? "✓ ÉXITO" : "✗ ERROR") << std::endl;
-        }
+        // Realizar análisis semántico 
+        passes.run();
         
         // Liberar memoria
         std::cout << "\n=== Liberando recursos ===" << std::endl;
         destroy_body(program);
         std::cout << "Análisis semántico completado." << std::endl;
         
+        if (options.time_passes) {
+            passes.print_report(std::cout);
+        }
+        if (options.stats) {
+            print_stats(std::cout, stats_ast | stats_symbols | stats_memory);
+            passes.print_memory_report(std::cout);
+        }
+        
         return EXIT_SUCCESS;
     } 
     catch (const std::exception& e) {
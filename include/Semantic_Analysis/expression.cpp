@@ -1,11 +1,14 @@
 #include "expression.hpp"
 #include "datatype.hpp"
 #include "symbol_table.hpp"
+#include "traversal.hpp"
+#include "type_context.hpp"
 
 // Implementación de BoolExpression
 BoolExpression::BoolExpression(bool _value) noexcept
-    : value(_value)
+    : Expression(NodeKind::BoolExpression), value(_value)
 {
+    hash_combine(value);
 }
 
 void BoolExpression::destroy() noexcept
@@ -13,13 +16,8 @@ void BoolExpression::destroy() noexcept
     
 }
 
-ASTNodeInterface* BoolExpression::copy() const noexcept
-{
-    return new BoolExpression(value);
-}
-
 bool BoolExpression::equal(ASTNodeInterface* other) const noexcept{
-    auto other_bool = dynamic_cast<BoolExpression*>(other);
+    auto other_bool = dyn_cast<BoolExpression>(other);
     if (other_bool == nullptr)
     {
         return false;
@@ -30,7 +28,7 @@ bool BoolExpression::equal(ASTNodeInterface* other) const noexcept{
 
 std::pair<bool, Datatype*> BoolExpression::type_check() const noexcept
 {
-    return std::make_pair(true, new BooleanDatatype());
+    return std::make_pair(true, TypeContext::get<BooleanDatatype>());
 }
 
 bool BoolExpression::resolve_name(SymbolTable& symbol_table) noexcept
@@ -44,8 +42,9 @@ bool BoolExpression::get_value() const noexcept
 }
 
 IntExpression::IntExpression(int _value) noexcept
-    : value(_value)
+    : Expression(NodeKind::IntExpression), value(_value)
 {
+    hash_combine(static_cast<std::uint64_t>(value));
 }
 
 void IntExpression::destroy() noexcept
@@ -53,14 +52,9 @@ void IntExpression::destroy() noexcept
    
 }
 
-ASTNodeInterface* IntExpression::copy() const noexcept
-{
-    return new IntExpression(value);
-}
-
 bool IntExpression::equal(ASTNodeInterface* other) const noexcept
 {
-    auto other_int = dynamic_cast<IntExpression*>(other);
+    auto other_int = dyn_cast<IntExpression>(other);
     if (other_int == nullptr)
     {
         return false;
@@ -71,7 +65,7 @@ bool IntExpression::equal(ASTNodeInterface* other) const noexcept
 
 std::pair<bool, Datatype*> IntExpression::type_check() const noexcept
 {
-    return std::make_pair(true, new IntegerDatatype());
+    return std::make_pair(true, TypeContext::get<IntegerDatatype>());
 }
 
 bool IntExpression::resolve_name(SymbolTable& symbol_table) noexcept
@@ -85,8 +79,9 @@ int IntExpression::get_value() const noexcept
 }
 
 StrExpression::StrExpression(const std::string& _value) noexcept
-    : value(_value)
+    : Expression(NodeKind::StrExpression), value(_value)
 {
+    hash_combine(std::hash<std::string>{}(value));
 }
 
 void StrExpression::destroy() noexcept
@@ -94,14 +89,9 @@ void StrExpression::destroy() noexcept
 
 }
 
-ASTNodeInterface* StrExpression::copy() const noexcept
-{
-    return new StrExpression(value);
-}
-
 bool StrExpression::equal(ASTNodeInterface* other) const noexcept
 {
-    auto other_str = dynamic_cast<StrExpression*>(other);
+    auto other_str = dyn_cast<StrExpression>(other);
     if (other_str == nullptr)
     {
         return false;
@@ -112,7 +102,7 @@ bool StrExpression::equal(ASTNodeInterface* other) const noexcept
 
 std::pair<bool, Datatype*> StrExpression::type_check() const noexcept
 {
-    return std::make_pair(true, new StringDatatype());
+    return std::make_pair(true, TypeContext::get<StringDatatype>());
 }
 
 bool StrExpression::resolve_name(SymbolTable& symbol_table) noexcept
@@ -126,9 +116,12 @@ const std::string& StrExpression::get_value() const noexcept
 }
 
 // Implementación de expresiones musicales específicas
-NoteExpression::NoteExpression(const std::string& _pitch, int _octave, int _duration) noexcept
-    : pitch(_pitch), octave(_octave), duration(_duration)
+NoteExpression::NoteExpression(NameId _pitch, int _octave, int _duration) noexcept
+    : Expression(NodeKind::NoteExpression), pitch(_pitch), octave(_octave), duration(_duration)
 {
+    hash_combine(pitch);
+    hash_combine(static_cast<std::uint64_t>(octave));
+    hash_combine(static_cast<std::uint64_t>(duration));
 }
 
 void NoteExpression::destroy() noexcept
@@ -136,14 +129,9 @@ void NoteExpression::destroy() noexcept
 
 }
 
-ASTNodeInterface* NoteExpression::copy() const noexcept
-{
-    return new NoteExpression(pitch, octave, duration);
-}
-
 bool NoteExpression::equal(ASTNodeInterface* other) const noexcept
 {
-    auto other_note = dynamic_cast<NoteExpression*>(other);
+    auto other_note = dyn_cast<NoteExpression>(other);
     if (other_note == nullptr)
     {
         return false;
@@ -157,14 +145,15 @@ bool NoteExpression::equal(ASTNodeInterface* other) const noexcept
 std::pair<bool, Datatype*> NoteExpression::type_check() const noexcept
 {
     // Validación básica de pitch: debe ser una nota válida (C, D, E, F, G, A, B, posiblemente con # o b)
+    std::string_view pitch_name = name_text(pitch);
     std::string valid_pitches = "CDEFGAB";
-    if (pitch.empty() || valid_pitches.find(pitch[0]) == std::string::npos){
+    if (pitch_name.empty() || valid_pitches.find(pitch_name[0]) == std::string::npos){
         return std::make_pair(false, nullptr);
     }
 
     // Validación de alteraciones (si existen)
-    if (pitch.length() > 1){
-        char alt = pitch[1];
+    if (pitch_name.length() > 1){
+        char alt = pitch_name[1];
         if (alt != '#' && alt != 'b')
         {
             return std::make_pair(false, nullptr);
@@ -181,7 +170,7 @@ std::pair<bool, Datatype*> NoteExpression::type_check() const noexcept
         return std::make_pair(false, nullptr);
     }
 
-    return std::make_pair(true, new NoteDatatype());
+    return std::make_pair(true, TypeContext::get<NoteDatatype>());
 }
 
 bool NoteExpression::resolve_name(SymbolTable& symbol_table) noexcept
@@ -189,9 +178,9 @@ bool NoteExpression::resolve_name(SymbolTable& symbol_table) noexcept
     return true; 
 }
 
-const std::string& NoteExpression::get_pitch() const noexcept
+std::string_view NoteExpression::get_pitch() const noexcept
 {
-    return pitch;
+    return name_text(pitch);
 }
 
 int NoteExpression::get_octave() const noexcept
@@ -204,9 +193,10 @@ int NoteExpression::get_duration() const noexcept
     return duration;
 }
 
-KeyExpression::KeyExpression(const std::string& _key) noexcept
-    : key(_key)
+KeyExpression::KeyExpression(NameId _key) noexcept
+    : Expression(NodeKind::KeyExpression), key(_key)
 {
+    hash_combine(key);
 }
 
 void KeyExpression::destroy() noexcept
@@ -214,14 +204,9 @@ void KeyExpression::destroy() noexcept
     
 }
 
-ASTNodeInterface* KeyExpression::copy() const noexcept
-{
-    return new KeyExpression(key);
-}
-
 bool KeyExpression::equal(ASTNodeInterface* other) const noexcept
 {
-    auto other_key = dynamic_cast<KeyExpression*>(other);
+    auto other_key = dyn_cast<KeyExpression>(other);
     if (other_key == nullptr){
         return false;
     }
@@ -232,22 +217,23 @@ bool KeyExpression::equal(ASTNodeInterface* other) const noexcept
 std::pair<bool, Datatype*> KeyExpression::type_check() const noexcept
 {
     // Validación básica de tonalidad
+    std::string_view key_name = name_text(key);
     std::string valid_roots = "CDEFGAB";
     
-    if (key.empty() || valid_roots.find(key[0]) == std::string::npos){
+    if (key_name.empty() || valid_roots.find(key_name[0]) == std::string::npos){
         return std::make_pair(false, nullptr);
     }
 
     // Si hay más caracteres, validar el segundo (puede ser #, b, m para menor)
-    if (key.length() > 1){
-        char modifier = key[1];
+    if (key_name.length() > 1){
+        char modifier = key_name[1];
         if (modifier != '#' && modifier != 'b' && modifier != 'm')
         {
             return std::make_pair(false, nullptr);
         }
     }
 
-    return std::make_pair(true, new KeyDatatype());
+    return std::make_pair(true, TypeContext::get<KeyDatatype>());
 }
 
 bool KeyExpression::resolve_name(SymbolTable& symbol_table) noexcept
@@ -255,14 +241,15 @@ bool KeyExpression::resolve_name(SymbolTable& symbol_table) noexcept
     return true; 
 }
 
-const std::string& KeyExpression::get_key() const noexcept
+std::string_view KeyExpression::get_key() const noexcept
 {
-    return key;
+    return name_text(key);
 }
 
 TempoExpression::TempoExpression(int _bpm) noexcept
-    : bpm(_bpm)
+    : Expression(NodeKind::TempoExpression), bpm(_bpm)
 {
+    hash_combine(static_cast<std::uint64_t>(bpm));
 }
 
 void TempoExpression::destroy() noexcept
@@ -270,14 +257,9 @@ void TempoExpression::destroy() noexcept
    
 }
 
-ASTNodeInterface* TempoExpression::copy() const noexcept
-{
-    return new TempoExpression(bpm);
-}
-
 bool TempoExpression::equal(ASTNodeInterface* other) const noexcept
 {
-    auto other_tempo = dynamic_cast<TempoExpression*>(other);
+    auto other_tempo = dyn_cast<TempoExpression>(other);
     if (other_tempo == nullptr){
         return false;
     }
@@ -292,7 +274,7 @@ std::pair<bool, Datatype*> TempoExpression::type_check() const noexcept
         return std::make_pair(false, nullptr);
     }
 
-    return std::make_pair(true, new TempoDatatype());
+    return std::make_pair(true, TypeContext::get<TempoDatatype>());
 }
 
 bool TempoExpression::resolve_name(SymbolTable& symbol_table) noexcept
@@ -306,8 +288,10 @@ int TempoExpression::get_bpm() const noexcept
 }
 
 TimeSignatureExpression::TimeSignatureExpression(int _numerator, int _denominator) noexcept
-    : numerator(_numerator), denominator(_denominator)
+    : Expression(NodeKind::TimeSignatureExpression), numerator(_numerator), denominator(_denominator)
 {
+    hash_combine(static_cast<std::uint64_t>(numerator));
+    hash_combine(static_cast<std::uint64_t>(denominator));
 }
 
 void TimeSignatureExpression::destroy() noexcept
@@ -315,14 +299,9 @@ void TimeSignatureExpression::destroy() noexcept
 
 }
 
-ASTNodeInterface* TimeSignatureExpression::copy() const noexcept
-{
-    return new TimeSignatureExpression(numerator, denominator);
-}
-
 bool TimeSignatureExpression::equal(ASTNodeInterface* other) const noexcept
 {
-    auto other_ts = dynamic_cast<TimeSignatureExpression*>(other);
+    auto other_ts = dyn_cast<TimeSignatureExpression>(other);
     if (other_ts == nullptr){
         return false;
     }
@@ -343,7 +322,7 @@ std::pair<bool, Datatype*> TimeSignatureExpression::type_check() const noexcept
         return std::make_pair(false, nullptr);
     }
 
-    return std::make_pair(true, new TimeSignatureDatatype());
+    return std::make_pair(true, TypeContext::get<TimeSignatureDatatype>());
 }
 
 bool TimeSignatureExpression::resolve_name(SymbolTable& symbol_table) noexcept
@@ -361,9 +340,10 @@ int TimeSignatureExpression::get_denominator() const noexcept
     return denominator;
 }
 
-NameExpression::NameExpression(const std::string& _name) noexcept
-    : name(_name)
+NameExpression::NameExpression(NameId _name) noexcept
+    : Expression(NodeKind::NameExpression), name(_name)
 {
+    hash_combine(name);
 }
 
 void NameExpression::destroy() noexcept
@@ -371,14 +351,9 @@ void NameExpression::destroy() noexcept
 
 }
 
-ASTNodeInterface* NameExpression::copy() const noexcept
-{
-    return new NameExpression(name);
-}
-
 bool NameExpression::equal(ASTNodeInterface* other) const noexcept
 {
-    auto other_name = dynamic_cast<NameExpression*>(other);
+    auto other_name = dyn_cast<NameExpression>(other);
     if (other_name == nullptr){
         return false;
     }
@@ -394,47 +369,60 @@ std::pair<bool, Datatype*> NameExpression::type_check() const noexcept
 
 bool NameExpression::resolve_name(SymbolTable& symbol_table) noexcept
 {
-    auto symbol = symbol_table.lookup(name);
-    return symbol != nullptr;
+    return symbol_table.lookup(name) != nullptr;
 }
 
-const std::string& NameExpression::get_name() const noexcept
+std::string_view NameExpression::get_name() const noexcept
+{
+    return name_text(name);
+}
+
+NameId NameExpression::get_name_id() const noexcept
 {
     return name;
 }
 
 ArrayAccessExpression::ArrayAccessExpression(Expression* _array, Expression* _index) noexcept
-    : array(_array), index(_index)
+    : Expression(NodeKind::ArrayAccessExpression), array(_array), index(_index)
 {
+    hash_combine(hash_of(array));
+    hash_combine(hash_of(index));
 }
 
 void ArrayAccessExpression::destroy() noexcept
 {
+    NativeDepthGuard depth;
+    if (depth.exhausted()){
+        destroy_children(this);
+        array = nullptr;
+        index = nullptr;
+        return;
+    }
+
     if (array != nullptr){
-        array->destroy();
-        delete array;
+        release(array);
         array = nullptr;
     }
 
     if (index != nullptr){
-        index->destroy();
-        delete index;
+        release(index);
         index = nullptr;
     }
 }
 
-ASTNodeInterface* ArrayAccessExpression::copy() const noexcept
-{
-    return new ArrayAccessExpression(
-        dynamic_cast<Expression*>(array->copy()),
-        dynamic_cast<Expression*>(index->copy())
-    );
-}
-
 bool ArrayAccessExpression::equal(ASTNodeInterface* other) const noexcept
 {
-    auto other_array_access = dynamic_cast<ArrayAccessExpression*>(other);
-    if (other_array_access == nullptr){
+    NativeDepthGuard depth;
+    if (depth.exhausted()){
+        return equal_tree(this, other);
+    }
+
+    if (other == this){
+        return true;
+    }
+
+    auto other_array_access = dyn_cast<ArrayAccessExpression>(other);
+    if (other_array_access == nullptr || hash() != other->hash()){
         return false;
     }
 
@@ -444,39 +432,39 @@ bool ArrayAccessExpression::equal(ASTNodeInterface* other) const noexcept
 
 std::pair<bool, Datatype*> ArrayAccessExpression::type_check() const noexcept
 {
+    NativeDepthGuard depth;
+    if (depth.exhausted()){
+        return type_check_tree(this);
+    }
+
     // Verificar que array sea de tipo array
     auto array_type = array->type_check();
     if (!array_type.first || array_type.second == nullptr){
         return std::make_pair(false, nullptr);
     }
 
-    auto* array_datatype = dynamic_cast<ArrayDatatype*>(array_type.second);
+    auto* array_datatype = dyn_cast<ArrayDatatype>(array_type.second);
     if (array_datatype == nullptr){
-        delete array_type.second;
         return std::make_pair(false, nullptr);
     }
 
     // Verificar que el índice sea de tipo entero
     auto index_type = index->type_check();
-    if (!index_type.first || index_type.second == nullptr){
-        delete array_type.second;
-        return std::make_pair(false, nullptr);
-    }
-
-    bool is_int = index_type.second->is<IntegerDatatype>();
-    delete index_type.second;
-
-    if (!is_int){
-        delete array_type.second;
+    if (!index_type.first || index_type.second != TypeContext::get<IntegerDatatype>()){
         return std::make_pair(false, nullptr);
     }
 
-    // El tipo del resultado es el tipo interno del array
-    return std::make_pair(true, dynamic_cast<Datatype*>(array_datatype->get_inner_datatype()->copy()));
+    // El tipo del resultado es el tipo interno del array (ya canónico)
+    return std::make_pair(true, array_datatype->get_inner_datatype());
 }
 
 bool ArrayAccessExpression::resolve_name(SymbolTable& symbol_table) noexcept
 {
+    NativeDepthGuard depth;
+    if (depth.exhausted()){
+        return resolve_name_tree(this, symbol_table);
+    }
+
     return array->resolve_name(symbol_table) && index->resolve_name(symbol_table);
 }
 
@@ -491,37 +479,46 @@ Expression* ArrayAccessExpression::get_index() const noexcept
 }
 
 AssignmentExpression::AssignmentExpression(Expression* _target, Expression* _value) noexcept
-    : target(_target), value(_value)
+    : Expression(NodeKind::AssignmentExpression), target(_target), value(_value)
 {
+    hash_combine(hash_of(target));
+    hash_combine(hash_of(value));
 }
 
 void AssignmentExpression::destroy() noexcept
 {
+    NativeDepthGuard depth;
+    if (depth.exhausted()){
+        destroy_children(this);
+        target = nullptr;
+        value = nullptr;
+        return;
+    }
+
     if (target != nullptr){
-        target->destroy();
-        delete target;
+        release(target);
         target = nullptr;
     }
 
     if (value != nullptr){
-        value->destroy();
-        delete value;
+        release(value);
         value = nullptr;
     }
 }
 
-ASTNodeInterface* AssignmentExpression::copy() const noexcept
-{
-    return new AssignmentExpression(
-        dynamic_cast<Expression*>(target->copy()),
-        dynamic_cast<Expression*>(value->copy())
-    );
-}
-
 bool AssignmentExpression::equal(ASTNodeInterface* other) const noexcept
 {
-    auto other_assign = dynamic_cast<AssignmentExpression*>(other);
-    if (other_assign == nullptr){
+    NativeDepthGuard depth;
+    if (depth.exhausted()){
+        return equal_tree(this, other);
+    }
+
+    if (other == this){
+        return true;
+    }
+
+    auto other_assign = dyn_cast<AssignmentExpression>(other);
+    if (other_assign == nullptr || hash() != other->hash()){
         return false;
     }
 
@@ -530,48 +527,23 @@ bool AssignmentExpression::equal(ASTNodeInterface* other) const noexcept
 
 std::pair<bool, Datatype*> AssignmentExpression::type_check() const noexcept
 {
+    NativeDepthGuard depth;
+    if (depth.exhausted()){
+        return type_check_tree(this);
+    }
+
     auto target_type = target->type_check();
     if (!target_type.first){
-        if (target_type.second != nullptr)
-        {
-            delete target_type.second;
-            target_type.second = nullptr;
-        }
         return std::make_pair(false, nullptr);
     }
 
     auto value_type = value->type_check();
     if (!value_type.first){
-        if (target_type.second != nullptr)
-        {
-            delete target_type.second;
-            target_type.second = nullptr;
-        }
-        if (value_type.second != nullptr)
-        {
-            delete value_type.second;
-            value_type.second = nullptr;
-        }
         return std::make_pair(false, nullptr);
     }
 
-    // Verificar que los tipos sean compatibles
-    bool compatible = false;
-    if (target_type.second != nullptr && value_type.second != nullptr){
-        compatible = target_type.second->equal(value_type.second);
-    }
-
-    if (target_type.second != nullptr){
-        delete target_type.second;
-        target_type.second = nullptr;
-    }
-
-    if (!compatible){
-        if (value_type.second != nullptr)
-        {
-            delete value_type.second;
-            value_type.second = nullptr;
-        }
+    // Verificar que los tipos sean compatibles (los tipos canónicos se comparan por puntero)
+    if (target_type.second == nullptr || target_type.second != value_type.second){
         return std::make_pair(false, nullptr);
     }
 
@@ -580,6 +552,11 @@ std::pair<bool, Datatype*> AssignmentExpression::type_check() const noexcept
 
 bool AssignmentExpression::resolve_name(SymbolTable& symbol_table) noexcept
 {
+    NativeDepthGuard depth;
+    if (depth.exhausted()){
+        return resolve_name_tree(this, symbol_table);
+    }
+
     return target->resolve_name(symbol_table) && value->resolve_name(symbol_table);
 }
 
@@ -594,51 +571,72 @@ Expression* AssignmentExpression::get_value() const noexcept
 }
 
 // Implementación de expresiones unarias
-UnaryExpression::UnaryExpression(Expression* _operand) noexcept
-    : operand(_operand)
+UnaryExpression::UnaryExpression(NodeKind _kind, Expression* _operand) noexcept
+    : Expression(_kind), operand(_operand)
 {
+    hash_combine(hash_of(operand));
 }
 
 void UnaryExpression::destroy() noexcept
 {
+    NativeDepthGuard depth;
+    if (depth.exhausted()){
+        destroy_children(this);
+        operand = nullptr;
+        return;
+    }
+
     if (operand != nullptr){
-        operand->destroy();
-        delete operand;
+        release(operand);
         operand = nullptr;
     }
 }
 
+Expression* UnaryExpression::get_operand() const noexcept
+{
+    return operand;
+}
+
 CallExpression::CallExpression(Expression* _function, Expression* _arguments) noexcept
-    : function(_function), arguments(_arguments)
+    : Expression(NodeKind::CallExpression), function(_function), arguments(_arguments)
 {
+    hash_combine(hash_of(function));
+    hash_combine(hash_of(arguments));
 }
 
 void CallExpression::destroy() noexcept
 {
+    NativeDepthGuard depth;
+    if (depth.exhausted()){
+        destroy_children(this);
+        function = nullptr;
+        arguments = nullptr;
+        return;
+    }
+
     if (function != nullptr){
-        function->destroy();
-        delete function;
+        release(function);
         function = nullptr;
     }
 
     if (arguments != nullptr){
-        arguments->destroy();
-        delete arguments;
+        release(arguments);
         arguments = nullptr;
     }
 }
 
-ASTNodeInterface* CallExpression::copy() const noexcept
-{
-    return new CallExpression(
-        dynamic_cast<Expression*>(function->copy()),
-        arguments ? dynamic_cast<Expression*>(arguments->copy()) : nullptr
-    );
-}
-
 bool CallExpression::equal(ASTNodeInterface* other) const noexcept{
-    auto other_call = dynamic_cast<CallExpression*>(other);
-    if (other_call == nullptr){
+    NativeDepthGuard depth;
+    if (depth.exhausted()){
+        return equal_tree(this, other);
+    }
+
+    if (other == this){
+        return true;
+    }
+
+    auto other_call = dyn_cast<CallExpression>(other);
+    if (other_call == nullptr || hash() != other->hash()){
         return false;
     }
 
@@ -658,6 +656,11 @@ bool CallExpression::equal(ASTNodeInterface* other) const noexcept{
 }
 
 std::pair<bool, Datatype*> CallExpression::type_check() const noexcept{
+    NativeDepthGuard depth;
+    if (depth.exhausted()){
+        return type_check_tree(this);
+    }
+
     // Verificar que function sea una función
     auto func_type = function->type_check();
     if (!func_type.first || func_type.second == nullptr){
@@ -665,9 +668,8 @@ std::pair<bool, Datatype*> CallExpression::type_check() const noexcept{
     }
     
     // Comprobar que el tipo obtenido sea un FunctionDatatype
-    auto* function_type = dynamic_cast<FunctionDatatype*>(func_type.second);
+    auto* function_type = dyn_cast<FunctionDatatype>(func_type.second);
     if (function_type == nullptr){
-        delete func_type.second;
         return std::make_pair(false, nullptr);
     }
     
@@ -685,7 +687,7 @@ std::pair<bool, Datatype*> CallExpression::type_check() const noexcept{
         }
         
         // Obtener el argumento actual
-        ArgExpression* arg_expr = dynamic_cast<ArgExpression*>(current_arg);
+        ArgExpression* arg_expr = dyn_cast<ArgExpression>(current_arg);
         if (arg_expr == nullptr){
             args_valid = false;
             break;
@@ -698,10 +700,8 @@ std::pair<bool, Datatype*> CallExpression::type_check() const noexcept{
             break;
         }
         
-        bool compatible = arg_type.second->equal(param.second);
-        delete arg_type.second;
-        
-        if (!compatible){
+        // Los parámetros de un tipo canónico también son canónicos
+        if (arg_type.second != param.second){
             args_valid = false;
             break;
         }
@@ -716,15 +716,19 @@ std::pair<bool, Datatype*> CallExpression::type_check() const noexcept{
     }
     
     if (!args_valid){
-        delete func_type.second;
         return std::make_pair(false, nullptr);
     }
     
     // retornar el tipo return de la función
-    return std::make_pair(true, dynamic_cast<Datatype*>(function_type->get_return_type()->copy()));
+    return std::make_pair(true, function_type->get_return_type());
 }
 
 bool CallExpression::resolve_name(SymbolTable& symbol_table) noexcept{
+    NativeDepthGuard depth;
+    if (depth.exhausted()){
+        return resolve_name_tree(this, symbol_table);
+    }
+
     if (!function->resolve_name(symbol_table)){
         return false;
     }
@@ -747,34 +751,44 @@ Expression* CallExpression::get_arguments() const noexcept
 }
 
 ArgExpression::ArgExpression(Expression* _value, Expression* _next) noexcept
-    : value(_value), next(_next)
+    : Expression(NodeKind::ArgExpression), value(_value), next(_next)
 {
+    hash_combine(hash_of(value));
+    hash_combine(hash_of(next));
 }
 
 void ArgExpression::destroy() noexcept{
+    NativeDepthGuard depth;
+    if (depth.exhausted()){
+        destroy_children(this);
+        value = nullptr;
+        next = nullptr;
+        return;
+    }
+
     if (value != nullptr){
-        value->destroy();
-        delete value;
+        release(value);
         value = nullptr;
     }
 
     if (next != nullptr){
-        next->destroy();
-        delete next;
+        release(next);
         next = nullptr;
     }
 }
 
-ASTNodeInterface* ArgExpression::copy() const noexcept{
-    return new ArgExpression(
-        dynamic_cast<Expression*>(value->copy()),
-        next ? dynamic_cast<Expression*>(next->copy()) : nullptr
-    );
-}
-
 bool ArgExpression::equal(ASTNodeInterface* other) const noexcept{
-    auto other_arg = dynamic_cast<ArgExpression*>(other);
-    if (other_arg == nullptr){
+    NativeDepthGuard depth;
+    if (depth.exhausted()){
+        return equal_tree(this, other);
+    }
+
+    if (other == this){
+        return true;
+    }
+
+    auto other_arg = dyn_cast<ArgExpression>(other);
+    if (other_arg == nullptr || hash() != other->hash()){
         return false;
     }
 
@@ -795,6 +809,11 @@ bool ArgExpression::equal(ASTNodeInterface* other) const noexcept{
 
 std::pair<bool, Datatype*> ArgExpression::type_check() const noexcept
 {
+    NativeDepthGuard depth;
+    if (depth.exhausted()){
+        return type_check_tree(this);
+    }
+
     auto value_type = value->type_check();
     if (!value_type.first){
         return std::make_pair(false, nullptr);
@@ -804,10 +823,6 @@ std::pair<bool, Datatype*> ArgExpression::type_check() const noexcept
         auto next_type = next->type_check();
         if (!next_type.first)
         {
-            if (value_type.second != nullptr)
-            {
-                delete value_type.second;
-            }
             return std::make_pair(false, nullptr);
         }
     }
@@ -816,6 +831,11 @@ std::pair<bool, Datatype*> ArgExpression::type_check() const noexcept
 }
 
 bool ArgExpression::resolve_name(SymbolTable& symbol_table) noexcept{
+    NativeDepthGuard depth;
+    if (depth.exhausted()){
+        return resolve_name_tree(this, symbol_table);
+    }
+
     if (!value->resolve_name(symbol_table)){
         return false;
     }
@@ -836,13 +856,23 @@ Expression* ArgExpression::get_next() const noexcept{
 }
 
 // implementacion operador sostenido
-ASTNodeInterface* SharpExpression::copy() const noexcept{
-    return new SharpExpression(dynamic_cast<Expression*>(operand->copy()));
+SharpExpression::SharpExpression(Expression* _operand) noexcept
+    : UnaryExpression(NodeKind::SharpExpression, _operand)
+{
 }
 
 bool SharpExpression::equal(ASTNodeInterface* other) const noexcept{
-    auto other_sharp = dynamic_cast<SharpExpression*>(other);
-    if (other_sharp == nullptr){
+    NativeDepthGuard depth;
+    if (depth.exhausted()){
+        return equal_tree(this, other);
+    }
+
+    if (other == this){
+        return true;
+    }
+
+    auto other_sharp = dyn_cast<SharpExpression>(other);
+    if (other_sharp == nullptr || hash() != other->hash()){
         return false;
     }
 
@@ -850,14 +880,18 @@ bool SharpExpression::equal(ASTNodeInterface* other) const noexcept{
 }
 
 std::pair<bool, Datatype*> SharpExpression::type_check() const noexcept{
+    NativeDepthGuard depth;
+    if (depth.exhausted()){
+        return type_check_tree(this);
+    }
+
     auto operand_type = operand->type_check();
     if (!operand_type.first){
         return std::make_pair(false, nullptr);
     }
 
     // Verificar que el operando sea una nota musical
-    if (operand_type.second && !operand_type.second->is<NoteDatatype>()){
-        delete operand_type.second;
+    if (operand_type.second && operand_type.second != TypeContext::get<NoteDatatype>()){
         return std::make_pair(false, nullptr);
     }
 
@@ -866,6 +900,11 @@ std::pair<bool, Datatype*> SharpExpression::type_check() const noexcept{
 
 bool SharpExpression::resolve_name(SymbolTable& symbol_table) noexcept
 {
+    NativeDepthGuard depth;
+    if (depth.exhausted()){
+        return resolve_name_tree(this, symbol_table);
+    }
+
     return operand->resolve_name(symbol_table);
 }
 
@@ -4,6 +4,14 @@
 
 class Expression : public ASTNodeInterface
 {
+public:
+    static bool classof(const ASTNodeInterface* node) noexcept
+    {
+        return node->get_kind() >= NodeKind::FirstExpression && node->get_kind() <= NodeKind::LastExpression;
+    }
+
+protected:
+    using ASTNodeInterface::ASTNodeInterface;
 };
 
 // Expresiones de valores literales básicos
@@ -12,9 +20,12 @@ class BoolExpression : public Expression
 public:
     explicit BoolExpression(bool _value) noexcept;
 
-    void destroy() noexcept override;
+    static bool classof(const ASTNodeInterface* node) noexcept
+    {
+        return node->get_kind() == NodeKind::BoolExpression;
+    }
 
-    ASTNodeInterface* copy() const noexcept override;
+    void destroy() noexcept override;
 
     bool equal(ASTNodeInterface* other) const noexcept override;
 
@@ -33,9 +44,12 @@ class IntExpression : public Expression
 public:
     explicit IntExpression(int _value) noexcept;
 
-    void destroy() noexcept override;
+    static bool classof(const ASTNodeInterface* node) noexcept
+    {
+        return node->get_kind() == NodeKind::IntExpression;
+    }
 
-    ASTNodeInterface* copy() const noexcept override;
+    void destroy() noexcept override;
 
     bool equal(ASTNodeInterface* other) const noexcept override;
 
@@ -54,9 +68,12 @@ class StrExpression : public Expression
 public:
     explicit StrExpression(const std::string& _value) noexcept;
 
-    void destroy() noexcept override;
+    static bool classof(const ASTNodeInterface* node) noexcept
+    {
+        return node->get_kind() == NodeKind::StrExpression;
+    }
 
-    ASTNodeInterface* copy() const noexcept override;
+    void destroy() noexcept override;
 
     bool equal(ASTNodeInterface* other) const noexcept override;
 
@@ -74,11 +91,14 @@ private:
 class NoteExpression : public Expression
 {
 public:
-    NoteExpression(const std::string& _pitch, int _octave, int _duration) noexcept;
+    NoteExpression(NameId _pitch, int _octave, int _duration) noexcept;
 
-    void destroy() noexcept override;
+    static bool classof(const ASTNodeInterface* node) noexcept
+    {
+        return node->get_kind() == NodeKind::NoteExpression;
+    }
 
-    ASTNodeInterface* copy() const noexcept override;
+    void destroy() noexcept override;
 
     bool equal(ASTNodeInterface* other) const noexcept override;
 
@@ -86,12 +106,12 @@ public:
 
     bool resolve_name(SymbolTable& symbol_table) noexcept override;
 
-    const std::string& get_pitch() const noexcept;
+    std::string_view get_pitch() const noexcept;
     int get_octave() const noexcept;
     int get_duration() const noexcept;
 
 private:
-    std::string pitch;  // C, D, E, F, G, A, B (posiblemente con # o b)
+    NameId pitch;       // C, D, E, F, G, A, B (posiblemente con # o b)
     int octave;         // número de octava
     int duration;       // duración (negra, corchea, etc.)
 };
@@ -99,11 +119,14 @@ private:
 class KeyExpression : public Expression
 {
 public:
-    explicit KeyExpression(const std::string& _key) noexcept;
+    explicit KeyExpression(NameId _key) noexcept;
 
-    void destroy() noexcept override;
+    static bool classof(const ASTNodeInterface* node) noexcept
+    {
+        return node->get_kind() == NodeKind::KeyExpression;
+    }
 
-    ASTNodeInterface* copy() const noexcept override;
+    void destroy() noexcept override;
 
     bool equal(ASTNodeInterface* other) const noexcept override;
 
@@ -111,10 +134,10 @@ public:
 
     bool resolve_name(SymbolTable& symbol_table) noexcept override;
 
-    const std::string& get_key() const noexcept;
+    std::string_view get_key() const noexcept;
 
 private:
-    std::string key; // Tonalidad (C, Dm, etc.)
+    NameId key; // Tonalidad (C, Dm, etc.)
 };
 
 class TempoExpression : public Expression
@@ -122,9 +145,12 @@ class TempoExpression : public Expression
 public:
     explicit TempoExpression(int _bpm) noexcept;
 
-    void destroy() noexcept override;
+    static bool classof(const ASTNodeInterface* node) noexcept
+    {
+        return node->get_kind() == NodeKind::TempoExpression;
+    }
 
-    ASTNodeInterface* copy() const noexcept override;
+    void destroy() noexcept override;
 
     bool equal(ASTNodeInterface* other) const noexcept override;
 
@@ -143,9 +169,12 @@ class TimeSignatureExpression : public Expression
 public:
     TimeSignatureExpression(int _numerator, int _denominator) noexcept;
 
-    void destroy() noexcept override;
+    static bool classof(const ASTNodeInterface* node) noexcept
+    {
+        return node->get_kind() == NodeKind::TimeSignatureExpression;
+    }
 
-    ASTNodeInterface* copy() const noexcept override;
+    void destroy() noexcept override;
 
     bool equal(ASTNodeInterface* other) const noexcept override;
 
@@ -165,11 +194,14 @@ private:
 class NameExpression : public Expression
 {
 public:
-    explicit NameExpression(const std::string& _name) noexcept;
+    explicit NameExpression(NameId _name) noexcept;
 
-    void destroy() noexcept override;
+    static bool classof(const ASTNodeInterface* node) noexcept
+    {
+        return node->get_kind() == NodeKind::NameExpression;
+    }
 
-    ASTNodeInterface* copy() const noexcept override;
+    void destroy() noexcept override;
 
     bool equal(ASTNodeInterface* other) const noexcept override;
 
@@ -177,10 +209,12 @@ public:
 
     bool resolve_name(SymbolTable& symbol_table) noexcept override;
 
-    const std::string& get_name() const noexcept;
+    std::string_view get_name() const noexcept;
+
+    NameId get_name_id() const noexcept;
 
 private:
-    std::string name;
+    NameId name;
 };
 
 // Expresión para acceso a arrays
@@ -189,9 +223,12 @@ class ArrayAccessExpression : public Expression
 public:
     ArrayAccessExpression(Expression* _array, Expression* _index) noexcept;
 
-    void destroy() noexcept override;
+    static bool classof(const ASTNodeInterface* node) noexcept
+    {
+        return node->get_kind() == NodeKind::ArrayAccessExpression;
+    }
 
-    ASTNodeInterface* copy() const noexcept override;
+    void destroy() noexcept override;
 
     bool equal(ASTNodeInterface* other) const noexcept override;
 
@@ -213,9 +250,12 @@ class AssignmentExpression : public Expression
 public:
     AssignmentExpression(Expression* _target, Expression* _value) noexcept;
 
-    void destroy() noexcept override;
+    static bool classof(const ASTNodeInterface* node) noexcept
+    {
+        return node->get_kind() == NodeKind::AssignmentExpression;
+    }
 
-    ASTNodeInterface* copy() const noexcept override;
+    void destroy() noexcept override;
 
     bool equal(ASTNodeInterface* other) const noexcept override;
 
@@ -237,9 +277,12 @@ class CallExpression : public Expression
 public:
     CallExpression(Expression* _function, Expression* _arguments) noexcept;
 
-    void destroy() noexcept override;
+    static bool classof(const ASTNodeInterface* node) noexcept
+    {
+        return node->get_kind() == NodeKind::CallExpression;
+    }
 
-    ASTNodeInterface* copy() const noexcept override;
+    void destroy() noexcept override;
 
     bool equal(ASTNodeInterface* other) const noexcept override;
 
@@ -261,9 +304,12 @@ class ArgExpression : public Expression
 public:
     ArgExpression(Expression* _value, Expression* _next) noexcept;
 
-    void destroy() noexcept override;
+    static bool classof(const ASTNodeInterface* node) noexcept
+    {
+        return node->get_kind() == NodeKind::ArgExpression;
+    }
 
-    ASTNodeInterface* copy() const noexcept override;
+    void destroy() noexcept override;
 
     bool equal(ASTNodeInterface* other) const noexcept override;
 
@@ -283,11 +329,18 @@ private:
 class UnaryExpression : public Expression
 {
 public:
-    explicit UnaryExpression(Expression* _operand) noexcept;
+    static bool classof(const ASTNodeInterface* node) noexcept
+    {
+        return node->get_kind() >= NodeKind::FirstUnaryExpression && node->get_kind() <= NodeKind::LastUnaryExpression;
+    }
 
     void destroy() noexcept override;
 
+    Expression* get_operand() const noexcept;
+
 protected:
+    UnaryExpression(NodeKind _kind, Expression* _operand) noexcept;
+
     Expression* operand;
 };
 
@@ -295,9 +348,12 @@ protected:
 class SharpExpression : public UnaryExpression
 {
 public:
-    using UnaryExpression::UnaryExpression;
+    explicit SharpExpression(Expression* _operand) noexcept;
 
-    ASTNodeInterface* copy() const noexcept override;
+    static bool classof(const ASTNodeInterface* node) noexcept
+    {
+        return node->get_kind() == NodeKind::SharpExpression;
+    }
 
     bool equal(ASTNodeInterface* other) const noexcept override;
 
@@ -0,0 +1,239 @@
+#include "fused_analysis.hpp"
+
+#include <cstdint>
+#include <utility>
+
+#include "node_visitor.hpp"
+#include "symbol_table.hpp"
+#include "traversal.hpp"
+#include "type_context.hpp"
+
+using TypeResult = std::pair<bool, Datatype*>;
+
+// Cada visit_node resuelve el nodo y devuelve su tipo; un fallo en cualquiera
+// de las dos comprobaciones devuelve failure y aborta el análisis
+class FusedAnalyzer : public NodeVisitor<FusedAnalyzer, TypeResult>
+{
+public:
+    explicit FusedAnalyzer(SymbolTable& _symbol_table) noexcept
+        : symbol_table(_symbol_table), pass(_symbol_table.resolve_pass()), depth(0)
+    {
+    }
+
+    // La profundidad se cuenta en el analizador: es su única recursión
+    TypeResult analyze(ASTNodeInterface* node) noexcept{
+        if (depth >= max_native_depth && is_composite(node->get_kind())){
+            // Demasiado profundo: el subárbol pasa al motor, en dos recorridos
+            return resolve_name_tree(node, symbol_table) ? type_check_tree(node) : failure;
+        }
+
+        ++depth;
+        TypeResult result = visit(node);
+        --depth;
+        return result;
+    }
+
+    // Hojas (y tipos): sus métodos se llaman sin despacho virtual
+    template <typename Leaf>
+    TypeResult visit_node(Leaf* node) noexcept{
+        if (!node->Leaf::resolve_name(symbol_table)){
+            return failure;
+        }
+        return node->Leaf::type_check();
+    }
+
+    TypeResult visit_node(VariableDeclaration* variable) noexcept{
+        if (!variable->get_type()->resolve_name(symbol_table)){
+            return failure;
+        }
+
+        Datatype* type = variable->get_canonical_type();
+        if (variable->get_initializer() != nullptr){
+            TypeResult init_type = analyze(variable->get_initializer());
+            // Verificando que el tipo del inicializador sea compatible con el tipo declarado
+            if (!init_type.first || (init_type.second != nullptr && init_type.second != type)){
+                return failure;
+            }
+        }
+
+        // El nombre se enlaza después de resolver el inicializador
+        Symbol* symbol = symbol_table.make_symbol(variable->get_type(), variable->get_name_id());
+        if (!symbol_table.bind(variable->get_name_id(), symbol)){
+            return failure;
+        }
+        return {true, type};
+    }
+
+    TypeResult visit_node(FunctionDeclaration* function) noexcept{
+        Datatype* canonical = function->get_canonical_type();
+
+        // Las funciones anidadas no se resuelven mientras se resuelve otra,
+        // pero su cuerpo se comprueba igual
+        if (pass.in_function){
+            return body_type_check(function->get_body()).first ? TypeResult{true, canonical} : failure;
+        }
+
+        auto type = cast<FunctionDatatype>(function->get_type());
+        if (!type->resolve_name(symbol_table)){
+            return failure;
+        }
+
+        Symbol* symbol = symbol_table.make_symbol(type, function->get_name_id());
+        if (!symbol_table.bind(function->get_name_id(), symbol)){
+            return failure;
+        }
+
+        symbol_table.enter_scope();
+        pass.in_function = true;
+
+        bool result = resolve_name_param_list(type->get_parameters(), symbol_table);
+        for (auto statement = function->get_body().begin(); result && statement != function->get_body().end(); ++statement){
+            result = analyze(*statement).first;
+        }
+
+        symbol_table.exit_scope();
+        pass.in_function = false;
+        return result ? TypeResult{true, canonical} : failure;
+    }
+
+    TypeResult visit_node(ArrayAccessExpression* access) noexcept{
+        TypeResult array_type = analyze(access->get_array());
+        if (!array_type.first){
+            return failure;
+        }
+
+        TypeResult index_type = analyze(access->get_index());
+        if (!index_type.first){
+            return failure;
+        }
+
+        // Verificar que array sea de tipo array y el índice, entero
+        auto array_datatype = dyn_cast<ArrayDatatype>(array_type.second);
+        if (array_datatype == nullptr || index_type.second != TypeContext::get<IntegerDatatype>()){
+            return failure;
+        }
+
+        // El tipo del resultado es el tipo interno del array (ya canónico)
+        return {true, array_datatype->get_inner_datatype()};
+    }
+
+    TypeResult visit_node(AssignmentExpression* assignment) noexcept{
+        TypeResult target_type = analyze(assignment->get_target());
+        if (!target_type.first){
+            return failure;
+        }
+
+        TypeResult value_type = analyze(assignment->get_value());
+        if (!value_type.first){
+            return failure;
+        }
+
+        // Los tipos canónicos se comparan por puntero
+        if (target_type.second == nullptr || target_type.second != value_type.second){
+            return failure;
+        }
+        return value_type;
+    }
+
+    TypeResult visit_node(CallExpression* call) noexcept{
+        TypeResult function_result = analyze(call->get_function());
+        if (!function_result.first){
+            return failure;
+        }
+
+        auto function_type = dyn_cast<FunctionDatatype>(function_result.second);
+        if (function_type == nullptr){
+            return failure;
+        }
+
+        // Cada argumento se resuelve y se compara con su parámetro en la misma
+        // vuelta; la lista se sigue en un bucle y no en recursión
+        const ParamList& params = function_type->get_parameters();
+        auto param = params.begin();
+        Expression* current = call->get_arguments();
+        while (auto arg = dyn_cast<ArgExpression>(current)){
+            TypeResult arg_type = analyze(arg->get_value());
+            if (!arg_type.first || param == params.end()){
+                return failure;
+            }
+
+            // Los parámetros de un tipo canónico también son canónicos
+            if (arg_type.second == nullptr || arg_type.second != param->second){
+                return failure;
+            }
+
+            ++param;
+            current = arg->get_next();
+        }
+
+        // Verificar que no falten ni sobren argumentos
+        if (current != nullptr || param != params.end()){
+            return failure;
+        }
+
+        return {true, function_type->get_return_type()};
+    }
+
+    TypeResult visit_node(ArgExpression* arg) noexcept{
+        // El tipo de la lista es el de su primer valor
+        TypeResult first = analyze(arg->get_value());
+        if (!first.first){
+            return failure;
+        }
+
+        Expression* current = arg->get_next();
+        while (auto next = dyn_cast<ArgExpression>(current)){
+            if (!analyze(next->get_value()).first){
+                return failure;
+            }
+            current = next->get_next();
+        }
+
+        if (current != nullptr && !analyze(current).first){
+            return failure;
+        }
+        return first;
+    }
+
+    TypeResult visit_node(SharpExpression* sharp) noexcept{
+        TypeResult operand_type = analyze(sharp->get_operand());
+        if (!operand_type.first){
+            return failure;
+        }
+
+        // Verificar que el operando sea una nota musical
+        if (operand_type.second != nullptr && operand_type.second != TypeContext::get<NoteDatatype>()){
+            return failure;
+        }
+        return operand_type;
+    }
+
+    TypeResult visit_node(DeclarationStatement* statement) noexcept{
+        return analyze(statement->get_declaration());
+    }
+
+    TypeResult visit_node(ExpressionStatement* statement) noexcept{
+        return analyze(statement->get_expression()).first ? TypeResult{true, nullptr} : failure;
+    }
+
+    TypeResult visit_node(PrintStatement* statement) noexcept{
+        return analyze(statement->get_value()).first ? TypeResult{true, nullptr} : failure;
+    }
+
+private:
+    static constexpr TypeResult failure{false, nullptr};
+
+    SymbolTable& symbol_table;
+    SymbolTable::ResolvePass& pass;
+    std::uint32_t depth;
+};
+
+bool analyze_body_fused(Body& body, SymbolTable& symbol_table) noexcept{
+    FusedAnalyzer analyzer{symbol_table};
+    for (Statement* statement : body){
+        if (!analyzer.analyze(statement).first){
+            return false;
+        }
+    }
+    return true;
+}
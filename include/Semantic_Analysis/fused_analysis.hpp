@@ -0,0 +1,20 @@
+#pragma once
+
+#include "ast_node_interface.hpp"
+
+// Resolución de nombres y comprobación de tipos en un solo recorrido.
+//
+// resolve_name_body seguido de body_type_check recorre el programa dos veces
+// con una llamada virtual por nodo en cada una. La comprobación de tipos no
+// depende de la tabla de símbolos, así que se puede hacer al volver de cada
+// nodo mientras se resuelve: analyze_body_fused visita cada nodo una vez con
+// NodeVisitor (node_visitor.hpp), resuelve sus nombres y calcula su tipo con
+// los de sus hijos, que todavía están en caché.
+//
+// El veredicto es el mismo que el de resolve_name_body(body, symbol_table) &&
+// body_type_check(body).first, y si es correcto también los enlaces de
+// symbol_table. Se detiene en la primera sentencia que falla en cualquiera de
+// las dos comprobaciones. Las funciones anidadas no se resuelven (como en
+// FunctionDeclaration::resolve_name) pero sí se comprueba su cuerpo, y los
+// subárboles demasiado profundos pasan al motor de traversal.hpp.
+bool analyze_body_fused(Body& body, SymbolTable& symbol_table) noexcept;
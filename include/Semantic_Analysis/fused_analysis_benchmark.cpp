@@ -0,0 +1,211 @@
+/*
+    Compilador Musical: Benchmark del análisis fusionado
+
+    Genera partituras grandes (notas, tempos, variables, sostenidos, prints y
+    motivos con parámetros y variables locales) y compara las dos pasadas
+    virtuales (resolve_name_body + body_type_check) con analyze_body_fused.
+    Los dos caminos deben dar el mismo veredicto y los mismos enlaces, también
+    en variantes con un nombre sin declarar o un error de tipos al final, en
+    un motivo o en la primera sentencia, y en una cadena muy profunda de
+    sostenidos que pasa al motor de traversal.hpp.
+
+    Uso: ./fused_analysis_benchmark [sentencias] [motivos] [repeticiones] [profundidad]
+*/
+
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "benchmark_support.hpp"
+#include "datatype.hpp"
+#include "declaration.hpp"
+#include "expression.hpp"
+#include "fused_analysis.hpp"
+#include "statement.hpp"
+#include "symbol_table.hpp"
+
+constexpr int statements_per_motif = 64;
+
+static void print_row(const std::string& label, double two_pass_ms, double fused_ms, bool success) {
+    print_label(label, 30);
+    print_ms(two_pass_ms, 9);
+    print_ms(fused_ms, 9);
+    print_speedup(two_pass_ms, fused_ms);
+    print_verdict(success);
+}
+
+// Fallo que se inserta en una variante
+enum class Fault
+{
+    None,
+    UnknownName,    // Sostenido sobre un nombre sin declarar
+    TypeError       // Tempo fuera de rango
+};
+
+static Statement* make_fault(Fault fault) {
+    if (fault == Fault::UnknownName) {
+        return new ExpressionStatement{new SharpExpression{new NameExpression{intern_name("sin_declarar")}}};
+    }
+    return new PrintStatement{new TempoExpression{1000}};
+}
+
+static Statement* make_global(int index) {
+    const NameId note = intern_name("nota" + std::to_string(index / 8 * 8));
+    switch (index % 8) {
+        case 0:
+            return new DeclarationStatement{new NoteDeclaration{note, "CDEFGAB"[index % 7], 4, intern_name("Negra")}};
+        case 1:
+        case 4:
+            return new ExpressionStatement{new SharpExpression{new SharpExpression{new NameExpression{note}}}};
+        case 2:
+            return new DeclarationStatement{new VariableDeclaration{
+                intern_name("v" + std::to_string(index)), new IntegerDatatype{}, new IntExpression{index}}};
+        case 3:
+            return new PrintStatement{new NameExpression{note}};
+        case 5:
+            return new DeclarationStatement{new TempoDeclaration{intern_name("tempo" + std::to_string(index)), 60 + index % 120}};
+        case 6:
+            return new ExpressionStatement{new SharpExpression{new NoteExpression{intern_name("D"), 4, 1 + index % 4}}};
+        default:
+            return new PrintStatement{new TimeSignatureExpression{3, 4}};
+    }
+}
+
+static Statement* make_motif_statement(int index) {
+    const NameId local = intern_name("local" + std::to_string(index / 4));
+    switch (index % 4) {
+        case 0:
+            return new DeclarationStatement{new NoteDeclaration{local, 'E', 5, intern_name("Corchea")}};
+        case 1:
+            return new ExpressionStatement{new SharpExpression{new NameExpression{local}}};
+        case 2:
+            return new PrintStatement{new NameExpression{intern_name("motivo")}};
+        default:
+            return new ExpressionStatement{new SharpExpression{new NameExpression{intern_name("nota0")}}};
+    }
+}
+
+// fault_at: posición de la sentencia de nivel superior que se sustituye por el
+// fallo (-1: ninguna); fault_in_motif pone el fallo al final del último motivo
+static Body make_score(int size, int motifs, Fault fault, int fault_at, bool fault_in_motif) {
+    Body program;
+    auto tail = program.before_begin();
+    for (int i = 0; i < size; ++i) {
+        tail = program.insert_after(tail, i == fault_at ? make_fault(fault) : make_global(i));
+    }
+
+    for (int f = 0; f < motifs; ++f) {
+        Body body;
+        auto body_tail = body.before_begin();
+        for (int s = 0; s < statements_per_motif; ++s) {
+            body_tail = body.insert_after(body_tail, make_motif_statement(s));
+        }
+        if (fault_in_motif && f == motifs - 1) {
+            body.insert_after(body_tail, make_fault(fault));
+        }
+
+        ParamList params;
+        params.push_front({intern_name("motivo"), new NoteDatatype{}});
+        tail = program.insert_after(tail, new DeclarationStatement{new FunctionDeclaration{
+            intern_name("motivo" + std::to_string(f)), new FunctionDatatype{new VoidDatatype{}, params}, body}});
+    }
+    return program;
+}
+
+// Enlaces que deben quedar iguales con los dos caminos
+static bool same_bindings(SymbolTable& two_pass, SymbolTable& fused, int size, int motifs) {
+    std::vector<std::string> names = {"nota0", "v2", "tempo5", "motivo0", "motivo" + std::to_string(motifs - 1),
+                                      "nota" + std::to_string((size - 1) / 8 * 8), "local0", "sin_declarar"};
+    for (const std::string& name : names) {
+        if ((two_pass.lookup(name) == nullptr) != (fused.lookup(name) == nullptr)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Analizar con los dos caminos, comparar y devolver los tiempos medios
+static bool measure(const std::string& label, Body& program, int size, int motifs, int repetitions, bool expected) {
+    bool two_pass_verdict = false;
+    auto start = Clock::now();
+    for (int r = 0; r < repetitions; ++r) {
+        SymbolTable table;
+        two_pass_verdict = resolve_name_body(program, table) && body_type_check(program).first;
+    }
+    auto end = Clock::now();
+    const double two_pass_ms = elapsed_ms(start, end) / repetitions;
+
+    bool fused_verdict = false;
+    start = Clock::now();
+    for (int r = 0; r < repetitions; ++r) {
+        SymbolTable table;
+        fused_verdict = analyze_body_fused(program, table);
+    }
+    end = Clock::now();
+    const double fused_ms = elapsed_ms(start, end) / repetitions;
+
+    SymbolTable two_pass_table;
+    SymbolTable fused_table;
+    resolve_name_body(program, two_pass_table);
+    analyze_body_fused(program, fused_table);
+
+    // Si falla, el análisis fusionado se detiene antes de enlazar el resto
+    const bool success = two_pass_verdict == expected && fused_verdict == expected &&
+                         (!expected || same_bindings(two_pass_table, fused_table, size, motifs));
+    print_row(label, two_pass_ms, fused_ms, success);
+    return success;
+}
+
+int main(int argc, char** argv){
+    int size = argc > 1 ? std::atoi(argv[1]) : 200000;
+    int motifs = argc > 2 ? std::atoi(argv[2]) : 2000;
+    int repetitions = argc > 3 ? std::atoi(argv[3]) : 5;
+    int depth = argc > 4 ? std::atoi(argv[4]) : 100000;
+    if (size < 8 || motifs <= 0 || repetitions <= 0 || depth <= 0) {
+        std::cerr << "Uso: " << argv[0] << " [sentencias] [motivos] [repeticiones] [profundidad]" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "====== Benchmark del análisis fusionado (" << size << " sentencias, " << motifs
+              << " motivos, " << repetitions << " repeticiones) ======" << std::endl;
+    std::cout << std::setw(30) << std::left << "partitura" << " | " << std::setw(12) << std::right << "dos pasadas"
+              << " | " << std::setw(12) << "fusionado" << " | " << std::setw(6) << "mejora" << " | resultado" << std::endl;
+
+    struct Variant
+    {
+        std::string label;
+        Fault fault;
+        int fault_at;
+        bool fault_in_motif;
+    };
+    const std::vector<Variant> variants = {
+        {"correcta", Fault::None, -1, false},
+        {"nombre sin declarar al final", Fault::UnknownName, size - 1, false},
+        {"error de tipos al final", Fault::TypeError, size - 1, false},
+        {"nombre sin declarar en motivo", Fault::UnknownName, -1, true},
+        {"error de tipos en motivo", Fault::TypeError, -1, true},
+        {"error de tipos al principio", Fault::TypeError, 0, false},
+    };
+
+    bool success = true;
+    for (const Variant& variant : variants) {
+        Body program = make_score(size, motifs, variant.fault, variant.fault_at, variant.fault_in_motif);
+        success = measure(variant.label, program, size, motifs, repetitions, variant.fault == Fault::None) && success;
+        destroy_body(program);
+    }
+
+    // Un sostenido con `depth` niveles: el análisis fusionado delega en el motor
+    Expression* chain = new NameExpression{intern_name("nota0")};
+    for (int i = 0; i < depth; ++i) {
+        chain = new SharpExpression{chain};
+    }
+    Body deep;
+    deep.push_front(new ExpressionStatement{chain});
+    deep.push_front(new DeclarationStatement{new NoteDeclaration{intern_name("nota0"), 'C', 4, intern_name("Negra")}});
+    success = measure("sostenidos x" + std::to_string(depth), deep, 8, 1, 1, true) && success;
+    destroy_body(deep);
+
+    return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
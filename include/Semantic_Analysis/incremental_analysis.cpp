@@ -0,0 +1,324 @@
+#include "incremental_analysis.hpp"
+
+#include <algorithm>
+#include <functional>
+
+#include "declaration.hpp"
+#include "expression.hpp"
+#include "statement.hpp"
+#include "symbol_table.hpp"
+#include "traversal.hpp"
+
+// Nombres que busca un subárbol (las NameExpression)
+class NameCollector
+{
+public:
+    explicit NameCollector(std::vector<NameId>& _names) noexcept
+        : names(_names)
+    {
+    }
+
+    Visit enter(const ASTNodeInterface* node) noexcept{
+        if (auto name = dyn_cast<NameExpression>(node)){
+            names.push_back(name->get_name_id());
+        }
+        return is_composite(node->get_kind()) ? Visit::Children : Visit::Skip;
+    }
+
+    bool leave(const ASTNodeInterface*) noexcept{
+        return true;
+    }
+
+    void cancel(const ASTNodeInterface*) noexcept{
+    }
+
+    template <typename Function>
+    void children(const ASTNodeInterface* node, Function&& function) noexcept{
+        for_each_child(node, function);
+    }
+
+private:
+    std::vector<NameId>& names;
+};
+
+IncrementalAnalysis::IncrementalAnalysis() noexcept
+    : round(0), checked(0)
+{
+}
+
+IncrementalAnalysis::~IncrementalAnalysis() noexcept{
+    for (std::uint32_t id : sequence){
+        release(records[id].statement);
+    }
+}
+
+const AnalysisReport& IncrementalAnalysis::analyze(Body& program) noexcept{
+    current.clear();
+    for (Statement* statement : program){
+        current.push_back(statement);
+    }
+
+    // El tramo editado es lo que queda entre el prefijo y el sufijo comunes
+    const std::size_t old_size = sequence.size();
+    const std::size_t new_size = current.size();
+    const std::size_t common = std::min(old_size, new_size);
+    std::size_t prefix = 0;
+    while (prefix < common && matches(current[prefix], sequence[prefix])){
+        ++prefix;
+    }
+    std::size_t suffix = 0;
+    while (prefix + suffix < common && matches(current[new_size - 1 - suffix], sequence[old_size - 1 - suffix])){
+        ++suffix;
+    }
+
+    return replace_range(prefix, old_size - suffix - prefix, current.data() + prefix, new_size - suffix - prefix);
+}
+
+const AnalysisReport& IncrementalAnalysis::analyze_edit(std::size_t position, std::size_t removed,
+                                                        Body::iterator first, std::size_t count) noexcept{
+    current.clear();
+    for (std::size_t i = 0; i < count; ++i){
+        current.push_back(*first++);
+    }
+    return replace_range(position, removed, current.data(), count);
+}
+
+const AnalysisReport& IncrementalAnalysis::replace_range(std::size_t position, std::size_t removed,
+                                                         Statement* const* inserted, std::size_t count) noexcept{
+    ++round;
+    checked = 0;
+
+    // Los nombres que enlazaba el tramo viejo pueden cambiar de dueño
+    released.clear();
+    for (std::size_t i = position; i < position + removed; ++i){
+        const Record& record = records[sequence[i]];
+        if (record.bound){
+            released.push_back(record.declared);
+        }
+        release_record(sequence[i]);
+    }
+
+    added.clear();
+    for (std::size_t i = 0; i < count; ++i){
+        added.push_back(create_record(inserted[i]));
+    }
+
+    sequence.erase(sequence.begin() + position, sequence.begin() + (position + removed));
+    sequence.insert(sequence.begin() + position, added.begin(), added.end());
+
+    // Las posiciones posteriores a la edición solo se mueven si cambió la longitud
+    const std::size_t moved_end = removed == count ? position + count : sequence.size();
+    for (std::size_t i = position; i < moved_end; ++i){
+        records[sequence[i]].order = static_cast<std::uint32_t>(i);
+    }
+
+    for (std::uint32_t record : added){
+        enqueue(record);
+    }
+    for (NameId name : released){
+        invalidate(name, static_cast<std::uint32_t>(position));
+    }
+
+    // En orden de programa: cuando se comprueba una sentencia, los enlaces
+    // anteriores a ella ya son definitivos
+    SymbolTable scope;
+    while (!queue.empty()){
+        std::pop_heap(queue.begin(), queue.end(), std::greater<>{});
+        const std::uint32_t record = queue.back().second;
+        queue.pop_back();
+        check(record, scope);
+    }
+
+    rebuild_report();
+    return report;
+}
+
+const AnalysisReport& IncrementalAnalysis::get_report() const noexcept{
+    return report;
+}
+
+std::size_t IncrementalAnalysis::get_checked_count() const noexcept{
+    return checked;
+}
+
+bool IncrementalAnalysis::matches(Statement* statement, std::uint32_t record) noexcept{
+    // El registro retiene su sentencia: la misma dirección es la misma sentencia
+    Record& entry = records[record];
+    if (entry.statement == statement){
+        return true;
+    }
+
+    // Sustituida por una sentencia con el mismo contenido: hereda el resultado.
+    // El hash solo descarta; equal() confirma contra la sentencia retenida
+    if (statement->hash() != entry.hash || !entry.statement->equal(statement)){
+        return false;
+    }
+    release(entry.statement);
+    entry.statement = retain(statement);
+    return true;
+}
+
+std::uint32_t IncrementalAnalysis::create_record(Statement* statement) noexcept{
+    std::uint32_t id;
+    if (!free_records.empty()){
+        id = free_records.back();
+        free_records.pop_back();
+    }
+    else {
+        id = static_cast<std::uint32_t>(records.size());
+        records.emplace_back();
+    }
+
+    Record& record = records[id];
+    record.statement = retain(statement);
+    record.hash = statement->hash();
+    record.declared = StringInterner::invalid_id;
+    record.function = StringInterner::invalid_id;
+    record.order = 0;
+    record.queued = 0;
+    record.bound = false;
+    record.outcome = Outcome::Ok;
+
+    record.names.clear();
+    NameCollector collector{record.names};
+    traverse(static_cast<const ASTNodeInterface*>(statement), collector);
+
+    if (auto decl_stmt = dyn_cast<DeclarationStatement>(statement)){
+        Declaration* declaration = decl_stmt->get_declaration();
+        record.declared = declaration->get_name_id();
+        record.names.push_back(record.declared);
+        if (isa<FunctionDeclaration>(declaration)){
+            record.function = record.declared;
+        }
+    }
+
+    std::sort(record.names.begin(), record.names.end());
+    record.names.erase(std::unique(record.names.begin(), record.names.end()), record.names.end());
+    for (NameId name : record.names){
+        dependents[name].push_back(id);
+    }
+    return id;
+}
+
+void IncrementalAnalysis::release_record(std::uint32_t id) noexcept{
+    Record& record = records[id];
+    if (record.bound){
+        remove_from(declarations[record.declared], id);
+    }
+    for (NameId name : record.names){
+        remove_from(dependents[name], id);
+    }
+    if (record.outcome != Outcome::Ok){
+        failures.erase(id);
+    }
+
+    release(record.statement);
+    record.statement = nullptr;
+    free_records.push_back(id);
+}
+
+const IncrementalAnalysis::Record* IncrementalAnalysis::visible_declaration(NameId name, std::uint32_t order) const noexcept{
+    auto it = declarations.find(name);
+    if (it == declarations.end()){
+        return nullptr;
+    }
+    for (std::uint32_t id : it->second){
+        if (records[id].order < order){
+            return &records[id];
+        }
+    }
+    return nullptr;
+}
+
+void IncrementalAnalysis::invalidate(NameId name, std::uint32_t order) noexcept{
+    auto it = dependents.find(name);
+    if (it == dependents.end()){
+        return;
+    }
+    for (std::uint32_t id : it->second){
+        if (records[id].order >= order){
+            enqueue(id);
+        }
+    }
+}
+
+void IncrementalAnalysis::enqueue(std::uint32_t id) noexcept{
+    Record& record = records[id];
+    if (record.queued == round){
+        return;
+    }
+    record.queued = round;
+    queue.emplace_back(record.order, id);
+    std::push_heap(queue.begin(), queue.end(), std::greater<>{});
+}
+
+void IncrementalAnalysis::check(std::uint32_t id, SymbolTable& scope) noexcept{
+    Record& record = records[id];
+    Statement* statement = record.statement;
+    ++checked;
+
+    // Un ámbito con los nombres que la sentencia usa o declara y que ya estaban
+    // enlazados antes que ella: ve lo mismo que en el análisis completo
+    scope.enter_scope();
+    for (NameId name : record.names){
+        if (const Record* declaration = visible_declaration(name, record.order)){
+            Datatype* type = cast<DeclarationStatement>(declaration->statement)->get_declaration()->get_type();
+            scope.bind(name, scope.make_symbol(type, name));
+        }
+    }
+
+    const std::size_t visible = scope.binding_count();
+    const bool resolved = statement->resolve_name(scope);
+    // Lo que quede enlazado en el ámbito es su propia declaración
+    const bool bound = scope.binding_count() > visible;
+    scope.exit_scope();
+
+    if (!resolved){
+        set_outcome(id, Outcome::Unresolved);
+    }
+    else {
+        set_outcome(id, statement->memoized_type_check() ? Outcome::Ok : Outcome::IllTyped);
+    }
+
+    if (bound != record.bound){
+        record.bound = bound;
+        if (bound){
+            declarations[record.declared].push_back(id);
+        }
+        else {
+            remove_from(declarations[record.declared], id);
+        }
+        invalidate(record.declared, record.order + 1);
+    }
+}
+
+void IncrementalAnalysis::set_outcome(std::uint32_t id, Outcome outcome) noexcept{
+    Record& record = records[id];
+    if (outcome != Outcome::Ok){
+        failures.insert(id);
+    }
+    else if (record.outcome != Outcome::Ok){
+        failures.erase(id);
+    }
+    record.outcome = outcome;
+}
+
+void IncrementalAnalysis::rebuild_report() noexcept{
+    report.diagnostics.clear();
+    for (std::uint32_t id : failures){
+        const Record& record = records[id];
+        AnalysisStage stage = record.outcome == Outcome::Unresolved ? AnalysisStage::ResolveName : AnalysisStage::TypeCheck;
+        report.diagnostics.push_back(Diagnostic{record.order, record.function, stage});
+    }
+    std::sort(report.diagnostics.begin(), report.diagnostics.end(), [](const Diagnostic& a, const Diagnostic& b) {
+        return a.statement < b.statement;
+    });
+}
+
+void IncrementalAnalysis::remove_from(std::vector<std::uint32_t>& list, std::uint32_t record) noexcept{
+    auto it = std::find(list.begin(), list.end(), record);
+    if (it != list.end()){
+        *it = list.back();
+        list.pop_back();
+    }
+}
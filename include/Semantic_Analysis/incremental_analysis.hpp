@@ -0,0 +1,134 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "ast_node_interface.hpp"
+#include "parallel_analysis.hpp"
+
+// Análisis semántico incremental de un programa que se edita.
+//
+// Cada sentencia de nivel superior tiene un registro con su hash estructural
+// (ASTNodeInterface::hash) y su último resultado. analyze() compara el
+// programa con el de la llamada anterior: las sentencias que siguen en su
+// sitio, o que se sustituyeron por otras con el mismo hash, conservan su
+// resultado. Solo se vuelven a comprobar las nuevas y las que usan o declaran
+// un nombre cuyo enlace global cambió; se comprueban en orden de programa y,
+// si cambia su propio enlace, el cambio se propaga a las que vienen después.
+//
+// El resultado de una sentencia depende solo de su contenido y de qué nombres
+// estaban enlazados antes que ella, así que el informe es el mismo que daría
+// analyze_program sobre el programa completo. El trabajo semántico es
+// proporcional a la edición y a sus dependientes, no al tamaño de la
+// partitura. Para localizar la edición, analyze() recorre la lista del
+// programa (unos nanosegundos por sentencia, pero lineal); el editor que ya
+// sabe qué cambió lo indica con analyze_edit() y se ahorra ese recorrido.
+//
+// Cada registro retiene su sentencia (retain()), así que el llamador puede
+// liberar las que quita del programa en cuanto las retira: la dirección de una
+// sentencia registrada no se reutiliza mientras el registro exista.
+class IncrementalAnalysis
+{
+public:
+    IncrementalAnalysis() noexcept;
+
+    ~IncrementalAnalysis() noexcept;
+
+    IncrementalAnalysis(const IncrementalAnalysis&) = delete;
+
+    IncrementalAnalysis& operator=(const IncrementalAnalysis&) = delete;
+
+    // Analizar el programa (completo la primera vez) y devolver el informe
+    const AnalysisReport& analyze(Body& program) noexcept;
+
+    // Como analyze(), pero el llamador indica la edición: desde la posición
+    // position se quitaron removed sentencias y se pusieron las count que
+    // empiezan en first
+    const AnalysisReport& analyze_edit(std::size_t position, std::size_t removed,
+                                       Body::iterator first, std::size_t count) noexcept;
+
+    const AnalysisReport& get_report() const noexcept;
+
+    // Sentencias comprobadas por la última llamada a analyze()
+    std::size_t get_checked_count() const noexcept;
+
+private:
+    enum class Outcome : std::uint8_t
+    {
+        Ok,
+        Unresolved,
+        IllTyped
+    };
+
+    struct Record
+    {
+        Statement* statement;       // Retenida mientras el registro esté en uso
+        std::uint64_t hash;         // Hash estructural de la sentencia
+        std::vector<NameId> names;  // Nombres que usa o declara, sin repetir
+        NameId declared;            // Nombre que declara en el nivel superior o invalid_id
+        NameId function;            // Para los diagnósticos (invalid_id si no es una función)
+        std::uint32_t order;        // Posición en el programa
+        std::uint32_t queued;       // Última llamada que la puso en la cola
+        bool bound;                 // Enlazó declared en el ámbito global
+        Outcome outcome;
+    };
+
+    // La sentencia es la misma del registro o una con el mismo contenido
+    // (mismo hash y equal()); en ese caso el registro pasa a retener la nueva
+    bool matches(Statement* statement, std::uint32_t record) noexcept;
+
+    // Sustituir los registros [position, position + removed) por los de las
+    // sentencias de inserted, volver a comprobar lo afectado y rehacer el informe
+    const AnalysisReport& replace_range(std::size_t position, std::size_t removed,
+                                        Statement* const* inserted, std::size_t count) noexcept;
+
+    std::uint32_t create_record(Statement* statement) noexcept;
+
+    // Quitar el registro de los índices y devolverlo a la lista libre
+    void release_record(std::uint32_t record) noexcept;
+
+    // Registro que enlazó name antes de la posición order, o nullptr
+    const Record* visible_declaration(NameId name, std::uint32_t order) const noexcept;
+
+    // Encolar las sentencias desde la posición order que usan o declaran name
+    void invalidate(NameId name, std::uint32_t order) noexcept;
+
+    void enqueue(std::uint32_t record) noexcept;
+
+    // Comprobar la sentencia con los enlaces globales anteriores a ella
+    void check(std::uint32_t record, SymbolTable& scope) noexcept;
+
+    void set_outcome(std::uint32_t record, Outcome outcome) noexcept;
+
+    void rebuild_report() noexcept;
+
+    static void remove_from(std::vector<std::uint32_t>& list, std::uint32_t record) noexcept;
+
+    std::uint32_t round;
+
+    std::vector<Record> records;
+    std::vector<std::uint32_t> free_records;
+
+    // Registros en el orden del programa analizado por última vez
+    std::vector<std::uint32_t> sequence;
+
+    // Registros que enlazaron cada nombre y registros que lo usan o declaran
+    std::unordered_map<NameId, std::vector<std::uint32_t>> declarations;
+    std::unordered_map<NameId, std::vector<std::uint32_t>> dependents;
+
+    // Cola de comprobación: montículo de mínimos por posición
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> queue;
+
+    // Registros con diagnóstico, para rehacer el informe sin recorrer el programa
+    std::unordered_set<std::uint32_t> failures;
+    std::size_t checked;
+    AnalysisReport report;
+
+    // Vectores de trabajo reutilizados entre llamadas
+    std::vector<Statement*> current;
+    std::vector<std::uint32_t> added;
+    std::vector<NameId> released;
+};
@@ -0,0 +1,201 @@
+/*
+    Compilador Musical: Benchmark del análisis semántico incremental
+
+    Genera partituras de tamaño creciente (notas, sostenidos sobre la nota
+    anterior y algún motivo que imprime una nota) y mide el análisis completo
+    (resolve_name_body + body_type_check) frente a IncrementalAnalysis después
+    de editar una nota en mitad de la partitura. La columna "analyze" localiza
+    el cambio de octava recorriendo el programa; las siguientes indican la
+    edición con analyze_edit(): cambiar la octava, cambiarle el nombre (la
+    sentencia que la usa deja de resolver) e insertar una nota nueva detrás.
+    Los informes se comparan con analyze_program sobre el programa editado.
+
+    Uso: ./incremental_analysis_benchmark [notas_máximas] [repeticiones]
+*/
+
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "benchmark_support.hpp"
+#include "datatype.hpp"
+#include "declaration.hpp"
+#include "expression.hpp"
+#include "incremental_analysis.hpp"
+#include "parallel_analysis.hpp"
+#include "statement.hpp"
+#include "symbol_table.hpp"
+#include "work_stealing_pool.hpp"
+
+static NameId note_name(int index) {
+    return intern_name("nota" + std::to_string(index));
+}
+
+static Statement* make_note(NameId name, int index, int octave) {
+    return new DeclarationStatement{new NoteDeclaration{name, "CDEFGAB"[index % 7], octave, intern_name("Negra")}};
+}
+
+// Cada 16 sentencias, un sostenido sobre la nota anterior; cada 1000, un
+// motivo que imprime una nota global
+static Body make_score(int size) {
+    Body program;
+    auto tail = program.before_begin();
+    for (int i = 0; i < size; ++i) {
+        Statement* statement = nullptr;
+        if (i % 1000 == 999) {
+            Body body;
+            body.push_front(new PrintStatement{new NameExpression{note_name(i - 2)}});
+            ParamList params;
+            params.push_front({intern_name("motivo"), new NoteDatatype{}});
+            statement = new DeclarationStatement{new FunctionDeclaration{
+                intern_name("motivo" + std::to_string(i)), new FunctionDatatype{new VoidDatatype{}, params}, body}};
+        }
+        else if (i % 16 == 15) {
+            statement = new ExpressionStatement{new SharpExpression{new NameExpression{note_name(i - 1)}}};
+        }
+        else {
+            statement = make_note(note_name(i), i, 4);
+        }
+        tail = program.insert_after(tail, statement);
+    }
+    return program;
+}
+
+static bool same_report(const AnalysisReport& report, const AnalysisReport& expected) {
+    if (report.diagnostics.size() != expected.diagnostics.size()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < report.diagnostics.size(); ++i) {
+        const Diagnostic& a = report.diagnostics[i];
+        const Diagnostic& b = expected.diagnostics[i];
+        if (a.statement != b.statement || a.function != b.function || a.stage != b.stage) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool matches_full_analysis(Body& program, const AnalysisReport& report, WorkStealingPool& pool) {
+    SymbolTable table;
+    return same_report(report, analyze_program(program, table, pool));
+}
+
+// Sustituir la sentencia de la posición y liberar la anterior antes de analizar
+static void replace(Body::iterator position, Statement* statement) {
+    Statement* old = *position;
+    *position = statement;
+    release(old);
+}
+
+int main(int argc, char** argv){
+    int max_size = argc > 1 ? std::atoi(argv[1]) : 200000;
+    int repetitions = argc > 2 ? std::atoi(argv[2]) : 20;
+    if (max_size <= 0 || repetitions <= 0) {
+        std::cerr << "Uso: " << argv[0] << " [notas_máximas] [repeticiones]" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "====== Benchmark del análisis incremental (" << repetitions << " ediciones por fila) ======" << std::endl;
+    std::cout << std::setw(9) << "sentencias" << " | " << std::setw(10) << "completo"
+              << " | " << std::setw(10) << "inicial" << " | " << std::setw(10) << "analyze"
+              << " | " << std::setw(10) << "octava"
+              << " | " << std::setw(10) << "renombrar" << " | " << std::setw(10) << "insertar"
+              << " | comprobadas | resultado" << std::endl;
+
+    WorkStealingPool pool{1};
+    bool success = true;
+
+    for (int size = max_size / 8; size <= max_size; size *= 2) {
+        Body program = make_score(size);
+
+        auto start = Clock::now();
+        SymbolTable table;
+        bool full = resolve_name_body(program, table) && body_type_check(program).first;
+        auto end = Clock::now();
+        const double full_ms = elapsed_ms(start, end);
+
+        IncrementalAnalysis analysis;
+        start = Clock::now();
+        bool same = analysis.analyze(program).success() == full;
+        end = Clock::now();
+        const double initial_ms = elapsed_ms(start, end);
+        same = matches_full_analysis(program, analysis.get_report(), pool) && same;
+
+        // Una nota usada por el sostenido que la sigue, en mitad de la partitura
+        int edited = size / 2;
+        edited += 14 - edited % 16;
+        auto position = program.begin();
+        std::advance(position, edited);
+
+        // analyze() localiza la edición recorriendo el programa; analyze_edit()
+        // recibe la posición, como haría un editor
+        double diff_ms = 0, octave_ms = 0, rename_ms = 0, insert_ms = 0;
+        std::size_t checked = 0;
+        for (int r = 0; r < repetitions; ++r) {
+            replace(position, make_note(note_name(edited), edited, 5));
+            start = Clock::now();
+            analysis.analyze(program);
+            end = Clock::now();
+            diff_ms += elapsed_ms(start, end);
+            checked = std::max(checked, analysis.get_checked_count());
+            same = same && analysis.get_report().success() == full;
+
+            replace(position, make_note(note_name(edited), edited, 4));
+            start = Clock::now();
+            analysis.analyze_edit(edited, 1, position, 1);
+            end = Clock::now();
+            octave_ms += elapsed_ms(start, end);
+            checked = std::max(checked, analysis.get_checked_count());
+            same = same && analysis.get_report().success() == full;
+
+            replace(position, make_note(intern_name("renombrada"), edited, 4));
+            start = Clock::now();
+            analysis.analyze_edit(edited, 1, position, 1);
+            end = Clock::now();
+            rename_ms += elapsed_ms(start, end);
+            checked = std::max(checked, analysis.get_checked_count());
+            if (r == 0) {
+                same = matches_full_analysis(program, analysis.get_report(), pool) && same;
+            }
+            same = same && analysis.get_report().diagnostics.size() == (full ? 1 : 2);
+
+            replace(position, make_note(note_name(edited), edited, 4));
+            analysis.analyze_edit(edited, 1, position, 1);
+            auto inserted = program.insert_after(position, make_note(intern_name("insertada"), edited, 4));
+            start = Clock::now();
+            analysis.analyze_edit(edited + 1, 0, inserted, 1);
+            end = Clock::now();
+            insert_ms += elapsed_ms(start, end);
+            checked = std::max(checked, analysis.get_checked_count());
+            if (r == 0) {
+                same = matches_full_analysis(program, analysis.get_report(), pool) && same;
+            }
+
+            // Quitar la nota insertada localizando la edición con analyze()
+            Statement* statement = *inserted;
+            program.erase_after(position);
+            release(statement);
+            analysis.analyze(program);
+            same = same && analysis.get_report().success() == full;
+        }
+        same = matches_full_analysis(program, analysis.get_report(), pool) && same;
+
+        std::cout << std::setw(10) << size << " | " << std::setw(7) << std::fixed << std::setprecision(2) << full_ms << " ms"
+                  << " | " << std::setw(7) << initial_ms << " ms"
+                  << " | " << std::setw(7) << std::setprecision(3) << diff_ms / repetitions << " ms"
+                  << " | " << std::setw(7) << octave_ms / repetitions << " ms"
+                  << " | " << std::setw(7) << rename_ms / repetitions << " ms"
+                  << " | " << std::setw(7) << insert_ms / repetitions << " ms"
+                  << " | " << std::setw(11) << checked
+                  << " | " << verdict_text(same) << std::endl;
+        success = success && same;
+
+        destroy_body(program);
+    }
+
+    return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,160 @@
+/*
+    Compilador Musical: Benchmark de despacho por NodeKind
+
+    Construye un Body de N sentencias (1M por defecto) que mezcla
+    DeclarationStatement -> NoteDeclaration, ExpressionStatement -> SharpExpression
+    y PrintStatement, y mide:
+      - la clasificación de cada nodo con dynamic_cast (camino anterior)
+      - la misma clasificación con dyn_cast<> (comparación de NodeKind)
+      - la misma clasificación con un switch sobre get_kind()
+      - equal_body entre el programa y otro igual construido por separado
+
+    Uso: ./kind_dispatch_benchmark [cantidad_de_sentencias]
+*/
+
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include "benchmark_support.hpp"
+#include "declaration.hpp"
+#include "expression.hpp"
+#include "statement.hpp"
+
+struct Counts
+{
+    long notes = 0;
+    long sharps = 0;
+    long prints = 0;
+};
+
+static void print_row(const std::string& label, double ms, long checksum) {
+    print_label(label, 22);
+    print_ms(ms);
+    print_text("control " + std::to_string(checksum));
+    print_end();
+}
+
+static Counts classify_dynamic_cast(const Body& program) {
+    Counts counts;
+    for (Statement* statement : program) {
+        if (auto decl_stmt = dynamic_cast<DeclarationStatement*>(statement)) {
+            if (dynamic_cast<NoteDeclaration*>(decl_stmt->get_declaration())) {
+                ++counts.notes;
+            }
+        } else if (auto expr_stmt = dynamic_cast<ExpressionStatement*>(statement)) {
+            if (dynamic_cast<SharpExpression*>(expr_stmt->get_expression())) {
+                ++counts.sharps;
+            }
+        } else if (dynamic_cast<PrintStatement*>(statement)) {
+            ++counts.prints;
+        }
+    }
+    return counts;
+}
+
+static Counts classify_dyn_cast(const Body& program) {
+    Counts counts;
+    for (Statement* statement : program) {
+        if (auto decl_stmt = dyn_cast<DeclarationStatement>(statement)) {
+            if (isa<NoteDeclaration>(decl_stmt->get_declaration())) {
+                ++counts.notes;
+            }
+        } else if (auto expr_stmt = dyn_cast<ExpressionStatement>(statement)) {
+            if (isa<SharpExpression>(expr_stmt->get_expression())) {
+                ++counts.sharps;
+            }
+        } else if (isa<PrintStatement>(statement)) {
+            ++counts.prints;
+        }
+    }
+    return counts;
+}
+
+static Counts classify_switch(const Body& program) {
+    Counts counts;
+    for (Statement* statement : program) {
+        switch (statement->get_kind()) {
+            case NodeKind::DeclarationStatement:
+                if (cast<DeclarationStatement>(statement)->get_declaration()->get_kind() == NodeKind::NoteDeclaration) {
+                    ++counts.notes;
+                }
+                break;
+            case NodeKind::ExpressionStatement:
+                if (cast<ExpressionStatement>(statement)->get_expression()->get_kind() == NodeKind::SharpExpression) {
+                    ++counts.sharps;
+                }
+                break;
+            case NodeKind::PrintStatement:
+                ++counts.prints;
+                break;
+            default:
+                break;
+        }
+    }
+    return counts;
+}
+
+static Body make_program(long statement_count) {
+    Body program;
+    auto tail = program.before_begin();
+    for (long i = 0; i < statement_count; ++i) {
+        Statement* statement = nullptr;
+        switch (i % 3) {
+            case 0:
+                statement = new DeclarationStatement{new NoteDeclaration{intern_name("nota"), 'C', 4, intern_name("Negra")}};
+                break;
+            case 1:
+                statement = new ExpressionStatement{new SharpExpression{new NameExpression{intern_name("nota")}}};
+                break;
+            default:
+                statement = new PrintStatement{new StrExpression{"//"}};
+                break;
+        }
+        tail = program.insert_after(tail, statement);
+    }
+    return program;
+}
+
+int main(int argc, char** argv){
+    long statement_count = argc > 1 ? std::atol(argv[1]) : 1000000;
+    if (statement_count <= 0) {
+        std::cerr << "Uso: " << argv[0] << " [cantidad_de_sentencias]" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "====== Benchmark de despacho por NodeKind (" << statement_count << " sentencias) ======" << std::endl;
+
+    Body program = make_program(statement_count);
+    Body program_copy = make_program(statement_count);
+
+    auto checksum = [](const Counts& counts) { return counts.notes * 3 + counts.sharps * 2 + counts.prints; };
+
+    // Pasada de calentamiento para que todas las mediciones partan con la caché caliente
+    classify_switch(program);
+
+    auto start = Clock::now();
+    Counts by_dynamic_cast = classify_dynamic_cast(program);
+    auto end = Clock::now();
+    print_row("dynamic_cast", elapsed_ms(start, end), checksum(by_dynamic_cast));
+
+    start = Clock::now();
+    Counts by_dyn_cast = classify_dyn_cast(program);
+    end = Clock::now();
+    print_row("dyn_cast<> (NodeKind)", elapsed_ms(start, end), checksum(by_dyn_cast));
+
+    start = Clock::now();
+    Counts by_switch = classify_switch(program);
+    end = Clock::now();
+    print_row("switch get_kind()", elapsed_ms(start, end), checksum(by_switch));
+
+    start = Clock::now();
+    bool equal = equal_body(program, program_copy);
+    end = Clock::now();
+    print_row("equal_body", elapsed_ms(start, end), equal ? 1 : 0);
+
+    destroy_body(program);
+    destroy_body(program_copy);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,39 @@
+// Reemplazo de operator new/delete que lleva la memoria viva del proceso
+// (live_bytes, benchmark_support.hpp). Solo lo enlazan los benchmarks que
+// miden memoria; el ejecutable usa allocation_counter.cpp.
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include "benchmark_support.hpp"
+
+// Cada bloque guarda su tamaño delante. Atómica porque los hilos de un
+// WorkStealingPool reservan a la vez que el principal
+static std::atomic<std::size_t> live{0};
+
+std::size_t live_bytes() noexcept{
+    return live.load(std::memory_order_relaxed);
+}
+
+void* operator new(std::size_t size){
+    auto block = static_cast<std::max_align_t*>(std::malloc(size + sizeof(std::max_align_t)));
+    if (block == nullptr){
+        throw std::bad_alloc{};
+    }
+    *reinterpret_cast<std::size_t*>(block) = size;
+    live.fetch_add(size, std::memory_order_relaxed);
+    return block + 1;
+}
+
+void operator delete(void* pointer) noexcept{
+    if (pointer != nullptr){
+        auto block = static_cast<std::max_align_t*>(pointer) - 1;
+        live.fetch_sub(*reinterpret_cast<std::size_t*>(block), std::memory_order_relaxed);
+        std::free(block);
+    }
+}
+
+void operator delete(void* pointer, std::size_t) noexcept{
+    operator delete(pointer);
+}
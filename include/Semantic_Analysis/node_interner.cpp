@@ -0,0 +1,53 @@
+#include "node_interner.hpp"
+
+#include "statement.hpp"
+
+NodeInterner::NodeInterner() noexcept
+    : shared_count(0)
+{
+}
+
+NodeInterner::~NodeInterner() noexcept
+{
+    clear();
+}
+
+ASTNodeInterface* NodeInterner::intern(ASTNodeInterface* node) noexcept{
+    auto inserted = nodes.insert(node);
+    if (inserted.second){
+        // Una referencia para el interner y la del llamador
+        return retain(node);
+    }
+
+    // Ya internado: el llamador conserva su referencia
+    ASTNodeInterface* existing = *inserted.first;
+    if (existing == node){
+        return node;
+    }
+
+    // El duplicado suelta sus hijos: los internados siguen vivos en el original
+    release(node);
+    ++shared_count;
+    return retain(existing);
+}
+
+void NodeInterner::intern_body(Body& body) noexcept{
+    for (Statement*& statement : body){
+        statement = cast<Statement>(intern(statement));
+    }
+}
+
+std::size_t NodeInterner::size() const noexcept{
+    return nodes.size();
+}
+
+std::size_t NodeInterner::get_shared_count() const noexcept{
+    return shared_count;
+}
+
+void NodeInterner::clear() noexcept{
+    for (ASTNodeInterface* node : nodes){
+        release(node);
+    }
+    nodes.clear();
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstddef>
+#include <unordered_set>
+#include <utility>
+
+#include "ast_node_interface.hpp"
+
+// Construcción del AST con hash-consing.
+//
+// Los nodos que se construyen con make() (o se pasan por intern()) se comparan
+// con los ya internados por su hash estructural y equal(): si ya hay uno igual
+// se devuelve ese y el nuevo se libera, así que una partitura que repite
+// compases y motivos guarda cada subárbol distinto una sola vez y el programa
+// pasa a ser un DAG. Construyendo de abajo arriba (los hijos ya internados)
+// las comparaciones encuentran punteros iguales y no bajan por el subárbol.
+//
+// Cada nodo devuelto lleva una referencia para el llamador, que se entrega al
+// padre al construirlo o se suelta con release()/destroy_body() como la de
+// cualquier otro nodo. El interner guarda además su propia referencia a cada
+// nodo distinto hasta clear() o su destrucción; los nodos siguen vivos
+// mientras algún cuerpo los use.
+//
+// Los nodos son inmutables, así que compartirlos no cambia ningún análisis:
+// resolve_name_body resuelve la sentencia en cada posición y
+// Statement::memoized_type_check comprueba una sola vez las compartidas.
+// No es seguro entre hilos (uno por unidad de compilación). Admite hijos de
+// una Arena (están fijados, ver Arena) si el interner se vacía antes de
+// liberar la arena.
+class NodeInterner
+{
+public:
+    NodeInterner() noexcept;
+
+    ~NodeInterner() noexcept;
+
+    NodeInterner(const NodeInterner&) = delete;
+
+    NodeInterner& operator=(const NodeInterner&) = delete;
+
+    // Construir un nodo y devolver el representante de su estructura
+    template <typename Type, typename... Args>
+    Type* make(Args&&... args) noexcept
+    {
+        return cast<Type>(intern(new Type(std::forward<Args>(args)...)));
+    }
+
+    // Tomar la referencia del llamador a node y devolverle el representante
+    // (node si es el primero con esa estructura)
+    ASTNodeInterface* intern(ASTNodeInterface* node) noexcept;
+
+    // Sustituir cada sentencia del cuerpo por su representante
+    void intern_body(Body& body) noexcept;
+
+    // Nodos distintos internados
+    std::size_t size() const noexcept;
+
+    // Nodos construidos que ya existían y se compartieron
+    std::size_t get_shared_count() const noexcept;
+
+    // Soltar las referencias del interner
+    void clear() noexcept;
+
+private:
+    std::unordered_set<ASTNodeInterface*, ASTNodeHash, ASTNodeEqual> nodes;
+    std::size_t shared_count;
+};
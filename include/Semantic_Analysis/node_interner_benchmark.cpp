@@ -0,0 +1,191 @@
+/*
+    Compilador Musical: Benchmark del AST compartido (hash-consing)
+
+    Genera una partitura repetitiva: notas globales, compases que repiten
+    sostenidos e impresiones de esas notas y motivos cuyos cuerpos son el mismo
+    en todas las funciones. La construye como árbol (new por nodo) y con
+    NodeInterner, y compara la memoria viva, el tiempo de construcción, el de
+    análisis (resolve_name_body + body_type_check) y el de liberación. Los dos
+    análisis deben coincidir con analyze_program, y al liberar la versión
+    compartida la memoria debe volver a la de antes de construirla.
+
+    Uso: ./node_interner_benchmark [compases] [funciones] [repeticiones]
+*/
+
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "benchmark_support.hpp"
+#include "datatype.hpp"
+#include "declaration.hpp"
+#include "expression.hpp"
+#include "node_interner.hpp"
+#include "parallel_analysis.hpp"
+#include "statement.hpp"
+#include "symbol_table.hpp"
+#include "work_stealing_pool.hpp"
+
+constexpr int global_notes = 64;
+constexpr int statements_per_measure = 16;
+constexpr int statements_per_function = 32;
+
+// Construcción sin compartir, con la misma interfaz que NodeInterner
+struct TreeFactory
+{
+    template <typename Type, typename... Args>
+    Type* make(Args&&... args) noexcept
+    {
+        return new Type(std::forward<Args>(args)...);
+    }
+};
+
+template <typename Factory>
+static Statement* make_measure_statement(Factory& factory, const std::vector<NameId>& notes, int measure, int index) {
+    NameId note = notes[(measure % 8 + index) % global_notes];
+    if (index % 2 == 0) {
+        return factory.template make<ExpressionStatement>(factory.template make<SharpExpression>(
+            factory.template make<SharpExpression>(factory.template make<NameExpression>(note))));
+    }
+    return factory.template make<PrintStatement>(factory.template make<NameExpression>(note));
+}
+
+// Variables locales y usos: iguales en todos los motivos
+template <typename Factory>
+static Statement* make_motif_statement(Factory& factory, int index) {
+    NameId local = intern_name("v" + std::to_string(index / 2));
+    if (index % 2 == 0) {
+        return factory.template make<DeclarationStatement>(factory.template make<VariableDeclaration>(
+            local, factory.template make<IntegerDatatype>(), factory.template make<IntExpression>(index)));
+    }
+    return factory.template make<ExpressionStatement>(factory.template make<SharpExpression>(
+        factory.template make<NoteExpression>(intern_name("C"), 4, index % 4)));
+}
+
+template <typename Factory>
+static Body make_score(Factory& factory, int measures, int functions) {
+    const NameId negra = intern_name("Negra");
+    std::vector<NameId> notes;
+    Body program;
+    auto tail = program.before_begin();
+    for (int n = 0; n < global_notes; ++n) {
+        notes.push_back(intern_name("nota_global" + std::to_string(n)));
+        tail = program.insert_after(tail, factory.template make<DeclarationStatement>(
+            factory.template make<NoteDeclaration>(notes[n], "CDEFGAB"[n % 7], 4, negra)));
+    }
+
+    for (int m = 0; m < measures; ++m) {
+        for (int s = 0; s < statements_per_measure; ++s) {
+            tail = program.insert_after(tail, make_measure_statement(factory, notes, m, s));
+        }
+    }
+
+    for (int f = 0; f < functions; ++f) {
+        Body body;
+        auto body_tail = body.before_begin();
+        for (int s = 0; s < statements_per_function; ++s) {
+            body_tail = body.insert_after(body_tail, make_motif_statement(factory, s));
+        }
+
+        ParamList params;
+        params.push_front({intern_name("motivo"), factory.template make<NoteDatatype>()});
+        tail = program.insert_after(tail, factory.template make<DeclarationStatement>(factory.template make<FunctionDeclaration>(
+            intern_name("motivo" + std::to_string(f)),
+            factory.template make<FunctionDatatype>(factory.template make<VoidDatatype>(), params), body)));
+    }
+    return program;
+}
+
+struct Measurement
+{
+    double build_ms;
+    double analyze_ms;
+    double destroy_ms;
+    std::size_t bytes;
+    bool verdict;
+    bool success;
+};
+
+template <typename Factory>
+static Measurement measure(Factory& factory, int measures, int functions, int repetitions, WorkStealingPool& pool) {
+    Measurement result{};
+    const std::size_t before = live_bytes();
+
+    auto start = Clock::now();
+    Body program = make_score(factory, measures, functions);
+    auto end = Clock::now();
+    result.build_ms = elapsed_ms(start, end);
+    result.bytes = live_bytes() - before;
+
+    start = Clock::now();
+    for (int r = 0; r < repetitions; ++r) {
+        SymbolTable table;
+        result.verdict = resolve_name_body(program, table) && body_type_check(program).first;
+    }
+    end = Clock::now();
+    result.analyze_ms = elapsed_ms(start, end) / repetitions;
+
+    SymbolTable table;
+    result.success = analyze_program(program, table, pool).success() == result.verdict;
+
+    start = Clock::now();
+    destroy_body(program);
+    end = Clock::now();
+    result.destroy_ms = elapsed_ms(start, end);
+    return result;
+}
+
+static void print_row(const std::string& label, const Measurement& measurement, bool success) {
+    print_label(label, 12);
+    print_ms(measurement.build_ms, 9);
+    print_kilobytes(measurement.bytes / 1024.0, 9, 2);
+    print_ms(measurement.analyze_ms, 9);
+    print_ms(measurement.destroy_ms, 9);
+    print_verdict(success);
+}
+
+int main(int argc, char** argv){
+    int measures = argc > 1 ? std::atoi(argv[1]) : 20000;
+    int functions = argc > 2 ? std::atoi(argv[2]) : 2000;
+    int repetitions = argc > 3 ? std::atoi(argv[3]) : 5;
+    if (measures < 0 || functions < 0 || repetitions <= 0) {
+        std::cerr << "Uso: " << argv[0] << " [compases] [funciones] [repeticiones]" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "====== Benchmark del AST compartido (" << measures << " compases, " << functions
+              << " motivos, " << repetitions << " repeticiones) ======" << std::endl;
+    std::cout << std::setw(12) << std::left << "modo" << " | " << std::setw(12) << std::right << "construir"
+              << " | " << std::setw(12) << "memoria" << " | " << std::setw(12) << "analizar"
+              << " | " << std::setw(12) << "liberar" << " | resultado" << std::endl;
+
+    WorkStealingPool pool{1};
+
+    TreeFactory tree;
+    Measurement plain = measure(tree, measures, functions, repetitions, pool);
+    print_row("árbol", plain, plain.success);
+
+    // La memoria del DAG incluye la tabla del interner; al liberarlo debe
+    // quedar la misma que antes de construir
+    const std::size_t before = live_bytes();
+    std::size_t distinct = 0, shared = 0;
+    Measurement dag;
+    {
+        NodeInterner interner;
+        dag = measure(interner, measures, functions, repetitions, pool);
+        distinct = interner.size();
+        shared = interner.get_shared_count();
+    }
+    const bool released = live_bytes() == before;
+    const bool success = plain.success && dag.success && dag.verdict == plain.verdict && released;
+    print_row("compartido", dag, dag.success && dag.verdict == plain.verdict && released);
+
+    std::cout << "nodos distintos: " << distinct << ", compartidos: " << shared
+              << ", memoria x" << std::setprecision(1) << static_cast<double>(plain.bytes) / dag.bytes
+              << (released ? "" : " (¡memoria sin liberar!)") << std::endl;
+
+    return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,112 @@
+#pragma once
+
+#include "ast_node_interface.hpp"
+#include "datatype.hpp"
+#include "declaration.hpp"
+#include "expression.hpp"
+#include "statement.hpp"
+
+// Visitante con despacho estático (CRTP) sobre los nodos del AST.
+//
+// visit() hace un único switch sobre el NodeKind y llama a
+// Derived::visit_node con el puntero ya convertido a la clase concreta, sin
+// llamadas virtuales ni dyn_cast<>. El conjunto de nodos es cerrado, así que
+// el compilador puede integrar cada visit_node en el switch.
+//
+// Derived decide qué sobrecargas de visit_node define: la resolución de
+// sobrecargas elige la más específica, de modo que una sobrecarga para una
+// categoría (Expression*, Datatype*...) o una plantilla cubre los nodos que no
+// tienen la suya. Si alguno queda sin cubrir, no compila.
+template <typename Derived, typename Result>
+class NodeVisitor
+{
+public:
+    Result visit(ASTNodeInterface* node) noexcept
+    {
+        switch (node->get_kind())
+        {
+            // Datatype
+            case NodeKind::VoidDatatype:
+                return derived().visit_node(static_cast<VoidDatatype*>(node));
+            case NodeKind::BooleanDatatype:
+                return derived().visit_node(static_cast<BooleanDatatype*>(node));
+            case NodeKind::CharacterDatatype:
+                return derived().visit_node(static_cast<CharacterDatatype*>(node));
+            case NodeKind::IntegerDatatype:
+                return derived().visit_node(static_cast<IntegerDatatype*>(node));
+            case NodeKind::StringDatatype:
+                return derived().visit_node(static_cast<StringDatatype*>(node));
+            case NodeKind::NoteDatatype:
+                return derived().visit_node(static_cast<NoteDatatype*>(node));
+            case NodeKind::TempoDatatype:
+                return derived().visit_node(static_cast<TempoDatatype*>(node));
+            case NodeKind::KeyDatatype:
+                return derived().visit_node(static_cast<KeyDatatype*>(node));
+            case NodeKind::TimeSignatureDatatype:
+                return derived().visit_node(static_cast<TimeSignatureDatatype*>(node));
+            case NodeKind::ArrayDatatype:
+                return derived().visit_node(static_cast<ArrayDatatype*>(node));
+            case NodeKind::FunctionDatatype:
+                return derived().visit_node(static_cast<FunctionDatatype*>(node));
+
+            // Declaration
+            case NodeKind::VariableDeclaration:
+                return derived().visit_node(static_cast<VariableDeclaration*>(node));
+            case NodeKind::TempoDeclaration:
+                return derived().visit_node(static_cast<TempoDeclaration*>(node));
+            case NodeKind::KeyDeclaration:
+                return derived().visit_node(static_cast<KeyDeclaration*>(node));
+            case NodeKind::TimeSignatureDeclaration:
+                return derived().visit_node(static_cast<TimeSignatureDeclaration*>(node));
+            case NodeKind::NoteDeclaration:
+                return derived().visit_node(static_cast<NoteDeclaration*>(node));
+            case NodeKind::FunctionDeclaration:
+                return derived().visit_node(static_cast<FunctionDeclaration*>(node));
+
+            // Expression
+            case NodeKind::BoolExpression:
+                return derived().visit_node(static_cast<BoolExpression*>(node));
+            case NodeKind::IntExpression:
+                return derived().visit_node(static_cast<IntExpression*>(node));
+            case NodeKind::StrExpression:
+                return derived().visit_node(static_cast<StrExpression*>(node));
+            case NodeKind::NoteExpression:
+                return derived().visit_node(static_cast<NoteExpression*>(node));
+            case NodeKind::KeyExpression:
+                return derived().visit_node(static_cast<KeyExpression*>(node));
+            case NodeKind::TempoExpression:
+                return derived().visit_node(static_cast<TempoExpression*>(node));
+            case NodeKind::TimeSignatureExpression:
+                return derived().visit_node(static_cast<TimeSignatureExpression*>(node));
+            case NodeKind::NameExpression:
+                return derived().visit_node(static_cast<NameExpression*>(node));
+            case NodeKind::ArrayAccessExpression:
+                return derived().visit_node(static_cast<ArrayAccessExpression*>(node));
+            case NodeKind::AssignmentExpression:
+                return derived().visit_node(static_cast<AssignmentExpression*>(node));
+            case NodeKind::CallExpression:
+                return derived().visit_node(static_cast<CallExpression*>(node));
+            case NodeKind::ArgExpression:
+                return derived().visit_node(static_cast<ArgExpression*>(node));
+            case NodeKind::SharpExpression:
+                return derived().visit_node(static_cast<SharpExpression*>(node));
+
+            // Statement
+            case NodeKind::DeclarationStatement:
+                return derived().visit_node(static_cast<DeclarationStatement*>(node));
+            case NodeKind::ExpressionStatement:
+                return derived().visit_node(static_cast<ExpressionStatement*>(node));
+            case NodeKind::PrintStatement:
+                return derived().visit_node(static_cast<PrintStatement*>(node));
+        }
+
+        // Todos los NodeKind tienen su caso
+        __builtin_unreachable();
+    }
+
+private:
+    Derived& derived() noexcept
+    {
+        return static_cast<Derived&>(*this);
+    }
+};
@@ -0,0 +1,151 @@
+#include "note_stream.hpp"
+
+void NoteStream::reserve(std::size_t count){
+    pitch_classes.reserve(count);
+    alterations.reserve(count);
+    octaves.reserve(count);
+    durations.reserve(count);
+    source_offsets.reserve(count);
+}
+
+void NoteStream::append(
+    std::uint8_t pitch_class,
+    std::int8_t alteration,
+    int octave,
+    std::uint16_t duration_ticks,
+    std::uint32_t source_offset
+){
+    pitch_classes.push_back(pitch_class);
+    alterations.push_back(alteration);
+    // Las octavas fuera de rango se marcan como inválidas en lugar de truncarse
+    octaves.push_back(octave < 0 || octave >= invalid_octave ? invalid_octave : static_cast<std::uint8_t>(octave));
+    durations.push_back(duration_ticks);
+    source_offsets.push_back(source_offset);
+}
+
+std::size_t NoteStream::size() const noexcept{
+    return pitch_classes.size();
+}
+
+bool NoteStream::empty() const noexcept{
+    return pitch_classes.empty();
+}
+
+void NoteStream::clear() noexcept{
+    pitch_classes.clear();
+    alterations.clear();
+    octaves.clear();
+    durations.clear();
+    source_offsets.clear();
+}
+
+const std::vector<std::uint8_t>& NoteStream::get_pitch_classes() const noexcept{
+    return pitch_classes;
+}
+
+const std::vector<std::int8_t>& NoteStream::get_alterations() const noexcept{
+    return alterations;
+}
+
+const std::vector<std::uint8_t>& NoteStream::get_octaves() const noexcept{
+    return octaves;
+}
+
+const std::vector<std::uint16_t>& NoteStream::get_durations() const noexcept{
+    return durations;
+}
+
+const std::vector<std::uint32_t>& NoteStream::get_source_offsets() const noexcept{
+    return source_offsets;
+}
+
+bool NoteStream::valid_note(std::uint8_t pitch_class, std::int8_t alteration, std::uint8_t octave, std::uint16_t duration) noexcept{
+    // Operadores a nivel de bits (sin cortocircuito) para que el bucle se pueda vectorizar
+    bool valid_duration = (duration == blanca_ticks) | (duration == negra_ticks) |
+                          (duration == corchea_ticks) | (duration == semicorchea_ticks);
+
+    return (pitch_class < 7) &
+           (static_cast<std::uint8_t>(alteration + 1) <= 2) &
+           (octave <= 8) &
+           valid_duration;
+}
+
+bool NoteStream::type_check() const noexcept{
+    const std::size_t count = size();
+    const std::uint8_t* pitch = pitch_classes.data();
+    const std::int8_t* alteration = alterations.data();
+    const std::uint8_t* octave = octaves.data();
+    const std::uint16_t* duration = durations.data();
+
+    bool valid = true;
+    for (std::size_t i = 0; i < count; ++i){
+        valid &= valid_note(pitch[i], alteration[i], octave[i], duration[i]);
+    }
+
+    return valid;
+}
+
+std::size_t NoteStream::first_invalid() const noexcept{
+    const std::size_t count = size();
+    for (std::size_t i = 0; i < count; ++i){
+        if (!valid_note(pitch_classes[i], alterations[i], octaves[i], durations[i]))
+        {
+            return i;
+        }
+    }
+
+    return count;
+}
+
+std::uint8_t pitch_class_from_letter(char letter) noexcept{
+    switch (letter){
+        case 'C': return 0;
+        case 'D': return 1;
+        case 'E': return 2;
+        case 'F': return 3;
+        case 'G': return 4;
+        case 'A': return 5;
+        case 'B': return 6;
+        default: return NoteStream::invalid_pitch;
+    }
+}
+
+std::uint8_t pitch_class_from_name(std::string_view name) noexcept{
+    if (name.size() == 1){
+        return pitch_class_from_letter(name[0]);
+    }
+
+    if (name == "Do") return 0;
+    if (name == "Re") return 1;
+    if (name == "Mi") return 2;
+    if (name == "Fa") return 3;
+    if (name == "Sol") return 4;
+    if (name == "La") return 5;
+    if (name == "Si") return 6;
+
+    return NoteStream::invalid_pitch;
+}
+
+char pitch_class_letter(std::uint8_t pitch_class) noexcept{
+    static const char letters[] = {'C', 'D', 'E', 'F', 'G', 'A', 'B'};
+    return pitch_class < 7 ? letters[pitch_class] : '?';
+}
+
+std::uint16_t duration_ticks_from_name(std::string_view name) noexcept{
+    if (name == "Blanca" || name == "blanca") return NoteStream::blanca_ticks;
+    if (name == "Negra" || name == "negra") return NoteStream::negra_ticks;
+    if (name == "Corchea" || name == "corchea") return NoteStream::corchea_ticks;
+    if (name == "Semicorchea" || name == "semicorchea") return NoteStream::semicorchea_ticks;
+
+    return NoteStream::invalid_duration;
+}
+
+std::string_view duration_name(std::uint16_t duration_ticks) noexcept{
+    switch (duration_ticks){
+        case NoteStream::blanca_ticks: return "Blanca";
+        case NoteStream::negra_ticks: return "Negra";
+        case NoteStream::corchea_ticks: return "Corchea";
+        case NoteStream::semicorchea_ticks: return "Semicorchea";
+        default: return "";
+    }
+}
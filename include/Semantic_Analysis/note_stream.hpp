@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+// Representación plana (struct-of-arrays) de una secuencia de notas.
+//
+// Cada nota ocupa una posición en cinco columnas de enteros empaquetados, de
+// modo que las pasadas semánticas recorren memoria contigua en lugar de seguir
+// la cadena Body -> DeclarationStatement -> NoteDeclaration. No depende del
+// AST para que el parser pueda emitirla directamente.
+class NoteStream
+{
+public:
+    // Marcadores de valor inválido (la validación los rechaza)
+    static constexpr std::uint8_t invalid_pitch = 0xFF;
+    static constexpr std::uint8_t invalid_octave = 0xFF;
+    static constexpr std::uint16_t invalid_duration = 0;
+
+    // Duraciones en ticks MIDI
+    static constexpr std::uint16_t blanca_ticks = 960;
+    static constexpr std::uint16_t negra_ticks = 480;
+    static constexpr std::uint16_t corchea_ticks = 240;
+    static constexpr std::uint16_t semicorchea_ticks = 120;
+
+    void reserve(std::size_t count);
+
+    // pitch_class: grado diatónico 0-6 (Do/C ... Si/B)
+    // alteration: -1 bemol, 0 natural, +1 sostenido
+    void append(
+        std::uint8_t pitch_class,
+        std::int8_t alteration,
+        int octave,
+        std::uint16_t duration_ticks,
+        std::uint32_t source_offset
+    );
+
+    std::size_t size() const noexcept;
+
+    bool empty() const noexcept;
+
+    void clear() noexcept;
+
+    const std::vector<std::uint8_t>& get_pitch_classes() const noexcept;
+    const std::vector<std::int8_t>& get_alterations() const noexcept;
+    const std::vector<std::uint8_t>& get_octaves() const noexcept;
+    const std::vector<std::uint16_t>& get_durations() const noexcept;
+    const std::vector<std::uint32_t>& get_source_offsets() const noexcept;
+
+    // Validación lineal de todas las notas: grado 0-6, alteración -1..1,
+    // octava 0-8 y duración Blanca/Negra/Corchea/Semicorchea
+    bool type_check() const noexcept;
+
+    // Índice de la primera nota inválida, o size() si todas son válidas
+    std::size_t first_invalid() const noexcept;
+
+private:
+    static bool valid_note(std::uint8_t pitch_class, std::int8_t alteration, std::uint8_t octave, std::uint16_t duration) noexcept;
+
+    std::vector<std::uint8_t> pitch_classes;
+    std::vector<std::int8_t> alterations;
+    std::vector<std::uint8_t> octaves;
+    std::vector<std::uint16_t> durations;
+    std::vector<std::uint32_t> source_offsets;
+};
+
+// Grado diatónico a partir de la letra inglesa (C..B) o invalid_pitch
+std::uint8_t pitch_class_from_letter(char letter) noexcept;
+
+// Grado diatónico a partir del nombre latino (Do..Si) o inglés (C..B)
+std::uint8_t pitch_class_from_name(std::string_view name) noexcept;
+
+// Letra inglesa del grado diatónico ('?' si es inválido)
+char pitch_class_letter(std::uint8_t pitch_class) noexcept;
+
+// Ticks de una figura ("Blanca" o "blanca", ...) o invalid_duration
+std::uint16_t duration_ticks_from_name(std::string_view name) noexcept;
+
+// Nombre de la figura correspondiente a una duración en ticks ("" si es inválida)
+std::string_view duration_name(std::uint16_t duration_ticks) noexcept;
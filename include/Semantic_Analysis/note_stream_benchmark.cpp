@@ -0,0 +1,78 @@
+/*
+    Compilador Musical: Benchmark del flujo plano de notas
+
+    Genera una partitura de N notas (1M por defecto) y compara la comprobación
+    de tipos sobre:
+      - el Body de DeclarationStatement -> NoteDeclaration (body_type_check)
+      - el NoteStream equivalente (columnas contiguas de enteros)
+
+    Uso: ./note_stream_benchmark [cantidad_de_notas]
+*/
+
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include "benchmark_support.hpp"
+#include "declaration.hpp"
+#include "note_stream.hpp"
+#include "statement.hpp"
+
+static const char pitches[] = {'C', 'D', 'E', 'F', 'G', 'A', 'B'};
+static const char* durations[] = {"Blanca", "Negra", "Corchea", "Semicorchea"};
+
+static void print_row(const std::string& label, double ms, bool success) {
+    print_label(label, 28);
+    print_ms(ms);
+    print_verdict(success);
+}
+
+int main(int argc, char** argv){
+    long note_count = argc > 1 ? std::atol(argv[1]) : 1000000;
+    if (note_count <= 0) {
+        std::cerr << "Uso: " << argv[0] << " [cantidad_de_notas]" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "====== Benchmark del flujo plano de notas (" << note_count << " notas) ======" << std::endl;
+
+    const NameId name = intern_name("nota");
+    NameId duration_ids[4];
+    for (int i = 0; i < 4; ++i) {
+        duration_ids[i] = intern_name(durations[i]);
+    }
+
+    Body program;
+    auto tail = program.before_begin();
+    for (long i = 0; i < note_count; ++i) {
+        auto note = new NoteDeclaration{
+            name, pitches[i % 7], static_cast<int>(i % 9), duration_ids[i % 4]
+        };
+        tail = program.insert_after(tail, new DeclarationStatement{note});
+    }
+
+    auto start = Clock::now();
+    NoteStream stream;
+    stream.reserve(note_count);
+    lower_body_notes(program, stream);
+    auto end = Clock::now();
+    print_row("Body -> NoteStream", elapsed_ms(start, end), stream.size() == static_cast<std::size_t>(note_count));
+
+    start = Clock::now();
+    bool body_valid = body_type_check(program).first;
+    end = Clock::now();
+    print_row("body_type_check (Body)", elapsed_ms(start, end), body_valid);
+
+    start = Clock::now();
+    bool stream_valid = stream.type_check();
+    end = Clock::now();
+    print_row("NoteStream::type_check", elapsed_ms(start, end), stream_valid);
+
+    std::cout << "Memoria del flujo: "
+              << stream.size() * (sizeof(std::uint8_t) * 2 + sizeof(std::int8_t) + sizeof(std::uint16_t) + sizeof(std::uint32_t)) / 1024
+              << " KiB" << std::endl;
+
+    destroy_body(program);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,93 @@
+#include "parallel_analysis.hpp"
+
+#include <memory>
+
+#include "declaration.hpp"
+#include "statement.hpp"
+#include "symbol_table.hpp"
+#include "work_stealing_pool.hpp"
+
+// Cuerpo pendiente de análisis
+struct FunctionJob
+{
+    std::size_t statement;
+    FunctionDeclaration* function;
+    std::size_t visible_bindings;   // Enlaces globales que ve el cuerpo
+};
+
+static FunctionDeclaration* function_of(Statement* statement) noexcept{
+    auto decl_stmt = dyn_cast<DeclarationStatement>(statement);
+    return decl_stmt != nullptr ? dyn_cast<FunctionDeclaration>(decl_stmt->get_declaration()) : nullptr;
+}
+
+AnalysisReport analyze_program(Body& program, SymbolTable& global_scope, WorkStealingPool& pool){
+    std::vector<Diagnostic> failures;
+    std::vector<FunctionJob> jobs;
+
+    // Fase 1 (secuencial): ámbito global y firmas, en el orden del programa
+    std::size_t index = 0;
+    for (Statement* statement : program){
+        const std::size_t current = index++;
+        FunctionDeclaration* function = function_of(statement);
+        if (function == nullptr){
+            if (!statement->resolve_name(global_scope)){
+                failures.push_back(Diagnostic{current, StringInterner::invalid_id, AnalysisStage::ResolveName});
+            }
+            else if (!statement->memoized_type_check()){
+                failures.push_back(Diagnostic{current, StringInterner::invalid_id, AnalysisStage::TypeCheck});
+            }
+            continue;
+        }
+
+        if (!function->resolve_signature(global_scope)){
+            failures.push_back(Diagnostic{current, function->get_name_id(), AnalysisStage::ResolveName});
+            continue;
+        }
+
+        // El cuerpo ve la propia función (recursión) pero no lo declarado después
+        jobs.push_back(FunctionJob{current, function, global_scope.binding_count()});
+    }
+
+    // Fase 2 (paralela): cada cuerpo en una tabla hija, una por hilo y
+    // reutilizada entre funciones (al salir del ámbito queda vacía)
+    std::vector<std::unique_ptr<SymbolTable>> scopes;
+    for (unsigned i = 0; i < pool.get_worker_count(); ++i){
+        scopes.push_back(std::make_unique<SymbolTable>());
+    }
+
+    // Cada tarea escribe solo su posición: no hace falta sincronizar
+    std::vector<std::uint8_t> outcomes(jobs.size());
+    constexpr std::uint8_t body_ok = 0, body_unresolved = 1, body_ill_typed = 2;
+
+    pool.run(jobs.size(), [&](std::size_t job_index, unsigned worker) {
+        const FunctionJob& job = jobs[job_index];
+        SymbolTable& scope = *scopes[worker];
+        scope.set_parent(&global_scope, job.visible_bindings);
+
+        if (!job.function->resolve_body(scope)){
+            outcomes[job_index] = body_unresolved;
+        }
+        else if (!job.function->type_check().first){
+            outcomes[job_index] = body_ill_typed;
+        }
+        else {
+            outcomes[job_index] = body_ok;
+        }
+    });
+
+    // Mezcla determinista: los trabajos ya están en orden de sentencia
+    AnalysisReport report;
+    auto failure = failures.begin();
+    for (std::size_t i = 0; i < jobs.size(); ++i){
+        while (failure != failures.end() && failure->statement < jobs[i].statement){
+            report.diagnostics.push_back(*failure++);
+        }
+        if (outcomes[i] != body_ok){
+            AnalysisStage stage = outcomes[i] == body_unresolved ? AnalysisStage::ResolveName : AnalysisStage::TypeCheck;
+            report.diagnostics.push_back(Diagnostic{jobs[i].statement, jobs[i].function->get_name_id(), stage});
+        }
+    }
+    report.diagnostics.insert(report.diagnostics.end(), failure, failures.end());
+
+    return report;
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "ast_node_interface.hpp"
+
+class WorkStealingPool;
+
+// Análisis semántico de un programa con los cuerpos de funciones en paralelo.
+//
+// Los cuerpos de dos funciones distintas solo comparten el ámbito global, que
+// no modifican. analyze_program resuelve primero, en orden, las sentencias de
+// nivel superior y las firmas de las funciones. Después resuelve y comprueba
+// los cuerpos en el pool, cada uno en una tabla hija con su propio ámbito. La
+// hija ve solo los enlaces globales que existían al declararse la función,
+// así que el resultado es el mismo que el del análisis secuencial.
+
+// Etapa en la que falló una sentencia
+enum class AnalysisStage : std::uint8_t
+{
+    ResolveName,
+    TypeCheck
+};
+
+struct Diagnostic
+{
+    std::size_t statement;   // Índice de la sentencia de nivel superior
+    NameId function;         // Función afectada o StringInterner::invalid_id
+    AnalysisStage stage;
+};
+
+struct AnalysisReport
+{
+    // En orden de sentencia, sin importar qué hilo terminó primero
+    std::vector<Diagnostic> diagnostics;
+
+    bool success() const noexcept
+    {
+        return diagnostics.empty();
+    }
+};
+
+// global_scope recibe los enlaces de nivel superior, como con resolve_name_body
+AnalysisReport analyze_program(Body& program, SymbolTable& global_scope, WorkStealingPool& pool);
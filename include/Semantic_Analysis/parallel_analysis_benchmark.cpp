@@ -0,0 +1,135 @@
+/*
+    Compilador Musical: Benchmark del análisis semántico en paralelo
+
+    Genera una biblioteca de funciones de motivos: cada función declara
+    variables locales y usa su parámetro y notas globales. Mide
+    el análisis secuencial (resolve_name_body + body_type_check) y
+    analyze_program con 1, 2, 4, ... hilos hasta el máximo pedido, y comprueba
+    que todas las variantes den el mismo veredicto.
+
+    Uso: ./parallel_analysis_benchmark [funciones] [sentencias_por_función] [hilos] [repeticiones]
+*/
+
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "benchmark_support.hpp"
+#include "datatype.hpp"
+#include "declaration.hpp"
+#include "expression.hpp"
+#include "parallel_analysis.hpp"
+#include "statement.hpp"
+#include "symbol_table.hpp"
+#include "work_stealing_pool.hpp"
+
+constexpr int global_notes = 64;
+
+static void print_row(const std::string& label, double ms, double baseline_ms, bool success) {
+    print_label(label, 24);
+    print_ms(ms);
+    print_speedup(baseline_ms, ms);
+    print_verdict(success);
+}
+
+// Notas globales seguidas de las funciones; cada una recibe una nota
+static Body make_library(int function_count, int statements_per_function) {
+    const NameId negra = intern_name("Negra");
+    const NameId pitch = intern_name("C");
+    const NameId motif = intern_name("motivo");
+
+    std::vector<NameId> notes;
+    Body program;
+    auto tail = program.before_begin();
+    for (int n = 0; n < global_notes; ++n) {
+        notes.push_back(intern_name("nota_global" + std::to_string(n)));
+        tail = program.insert_after(tail, new DeclarationStatement{new NoteDeclaration{notes[n], 'C', 4, negra}});
+    }
+
+    for (int f = 0; f < function_count; ++f) {
+        Body body;
+        auto body_tail = body.before_begin();
+        for (int s = 0; s < statements_per_function; ++s) {
+            Statement* statement = nullptr;
+            switch (s % 4) {
+                case 0:
+                    statement = new DeclarationStatement{new VariableDeclaration{
+                        intern_name("v" + std::to_string(s)), new IntegerDatatype{}, new IntExpression{s}}};
+                    break;
+                case 1:
+                    statement = new ExpressionStatement{new SharpExpression{new NameExpression{notes[(f + s) % global_notes]}}};
+                    break;
+                case 2:
+                    statement = new ExpressionStatement{new SharpExpression{new NoteExpression{pitch, 4, 1}}};
+                    break;
+                default:
+                    statement = new PrintStatement{new NameExpression{motif}};
+                    break;
+            }
+            body_tail = body.insert_after(body_tail, statement);
+        }
+
+        ParamList params;
+        params.push_front({motif, new NoteDatatype{}});
+        tail = program.insert_after(tail, new DeclarationStatement{new FunctionDeclaration{
+            intern_name("motivo" + std::to_string(f)), new FunctionDatatype{new VoidDatatype{}, params}, body}});
+    }
+    return program;
+}
+
+int main(int argc, char** argv){
+    int function_count = argc > 1 ? std::atoi(argv[1]) : 4000;
+    int statements_per_function = argc > 2 ? std::atoi(argv[2]) : 40;
+    int max_threads = argc > 3 ? std::atoi(argv[3]) : static_cast<int>(std::thread::hardware_concurrency());
+    int repetitions = argc > 4 ? std::atoi(argv[4]) : 5;
+    if (max_threads <= 0) {
+        max_threads = 1;
+    }
+    if (function_count <= 0 || statements_per_function <= 0 || repetitions <= 0) {
+        std::cerr << "Uso: " << argv[0] << " [funciones] [sentencias_por_función] [hilos] [repeticiones]" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "====== Benchmark del análisis en paralelo (" << function_count << " funciones x "
+              << statements_per_function << " sentencias, " << repetitions << " repeticiones) ======" << std::endl;
+
+    Body program = make_library(function_count, statements_per_function);
+
+    // Referencia secuencial (el resultado esperado es el mismo en todas las filas)
+    bool expected = true;
+    auto start = Clock::now();
+    for (int r = 0; r < repetitions; ++r) {
+        SymbolTable table;
+        expected = resolve_name_body(program, table) && body_type_check(program).first;
+    }
+    auto end = Clock::now();
+    const double sequential_ms = elapsed_ms(start, end);
+    print_row("secuencial", sequential_ms, sequential_ms, expected);
+
+    bool success = true;
+    for (int threads = 1; ; threads *= 2) {
+        threads = std::min(threads, max_threads);
+        WorkStealingPool pool{static_cast<unsigned>(threads)};
+
+        bool same = true;
+        start = Clock::now();
+        for (int r = 0; r < repetitions; ++r) {
+            SymbolTable table;
+            same = analyze_program(program, table, pool).success() == expected && same;
+        }
+        end = Clock::now();
+        print_row("paralelo (" + std::to_string(threads) + " hilos)", elapsed_ms(start, end), sequential_ms, same);
+        success = success && same;
+
+        if (threads == max_threads) {
+            break;
+        }
+    }
+
+    destroy_body(program);
+    return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,202 @@
+#include "pass_manager.hpp"
+
+#include <time.h>
+
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <ostream>
+
+#include "stats.hpp"
+
+// CPU consumida por el hilo actual
+static double thread_cpu_ms() noexcept{
+    timespec now;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+    return now.tv_sec * 1000.0 + now.tv_nsec / 1e6;
+}
+
+bool parse_pass_option(int argc, char** argv, int& i, PassOptions& options, std::string& error){
+    if (std::strcmp(argv[i], "--time-passes") == 0){
+        options.time_passes = true;
+        return true;
+    }
+    if (std::strcmp(argv[i], "--stats") == 0){
+        options.stats = true;
+        return true;
+    }
+
+    const bool disable = std::strcmp(argv[i], "--disable-pass") == 0;
+    if (!disable && std::strcmp(argv[i], "--enable-pass") != 0){
+        return false;
+    }
+
+    if (i + 1 >= argc){
+        error = std::string(argv[i]) + " requiere el nombre de un pase";
+        return true;
+    }
+    options.toggles.emplace_back(argv[++i], !disable);
+    return true;
+}
+
+void PassManager::add_pass(std::string name, Pass pass, bool enabled){
+    passes.push_back(Entry{std::move(name), std::move(pass), enabled, 0.0, 0.0, 0, 0, 0, 0});
+}
+
+bool PassManager::set_enabled(std::string_view name, bool enabled) noexcept{
+    for (Entry& entry : passes){
+        if (entry.name == name){
+            entry.enabled = enabled;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool PassManager::is_enabled(std::string_view name) const noexcept{
+    for (const Entry& entry : passes){
+        if (entry.name == name){
+            return entry.enabled;
+        }
+    }
+    return false;
+}
+
+bool PassManager::configure(const PassOptions& options, std::string& unknown) noexcept{
+    for (const auto& toggle : options.toggles){
+        if (!set_enabled(toggle.first, toggle.second)){
+            unknown = toggle.first;
+            return false;
+        }
+    }
+    return true;
+}
+
+bool PassManager::run(){
+    for (Entry& entry : passes){
+        if (!entry.enabled){
+            continue;
+        }
+
+        const auto wall_start = std::chrono::steady_clock::now();
+        const double cpu_start = thread_cpu_ms();
+        const std::uint64_t allocations_start = local_count(Counter::Allocation);
+        const std::uint64_t bytes_start = local_count(Counter::AllocatedBytes);
+        const bool success = entry.pass();
+        entry.allocations += local_count(Counter::Allocation) - allocations_start;
+        entry.allocated_bytes += local_count(Counter::AllocatedBytes) - bytes_start;
+        entry.cpu_ms += thread_cpu_ms() - cpu_start;
+        entry.wall_ms += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - wall_start).count();
+        ++entry.runs;
+
+        if (!success){
+            ++entry.failures;
+            return false;
+        }
+    }
+    return true;
+}
+
+void PassManager::merge_timings(const PassManager& other) noexcept{
+    for (Entry& entry : passes){
+        for (const Entry& other_entry : other.passes){
+            if (other_entry.name == entry.name){
+                entry.wall_ms += other_entry.wall_ms;
+                entry.cpu_ms += other_entry.cpu_ms;
+                entry.allocations += other_entry.allocations;
+                entry.allocated_bytes += other_entry.allocated_bytes;
+                entry.runs += other_entry.runs;
+                entry.failures += other_entry.failures;
+                break;
+            }
+        }
+    }
+}
+
+std::string PassManager::get_pass_names() const{
+    std::string names;
+    for (const Entry& entry : passes){
+        names += (names.empty() ? "" : ", ") + entry.name;
+    }
+    return names;
+}
+
+void PassManager::print_report(std::ostream& out) const{
+    double total_wall = 0.0;
+    double total_cpu = 0.0;
+    for (const Entry& entry : passes){
+        total_wall += entry.wall_ms;
+        total_cpu += entry.cpu_ms;
+    }
+
+    const auto flags = out.flags();
+    const auto precision = out.precision();
+
+    out << "\n=== Tiempo por pase ===\n" << std::endl;
+    out << std::setw(14) << std::left << "PASE"
+        << " | " << std::setw(12) << std::right << "PARED (ms)"
+        << " | " << std::setw(12) << "CPU (ms)"
+        << " | " << std::setw(7) << "%"
+        << " | EJECUCIONES" << std::endl;
+    out << std::string(70, '-') << std::endl;
+
+    out << std::fixed;
+    for (const Entry& entry : passes){
+        out << std::setw(14) << std::left << entry.name << " | ";
+        if (entry.runs == 0){
+            out << (entry.enabled ? "(sin ejecutar)" : "(deshabilitado)") << std::endl;
+            continue;
+        }
+        out << std::setw(12) << std::right << std::setprecision(3) << entry.wall_ms
+            << " | " << std::setw(12) << entry.cpu_ms
+            << " | " << std::setw(6) << std::setprecision(1) << (total_wall > 0.0 ? 100.0 * entry.wall_ms / total_wall : 0.0) << "%"
+            << " | " << entry.runs;
+        if (entry.failures != 0){
+            out << " (" << entry.failures << " con errores)";
+        }
+        out << std::endl;
+    }
+
+    out << std::string(70, '-') << std::endl;
+    out << std::setw(14) << std::left << "total"
+        << " | " << std::setw(12) << std::right << std::setprecision(3) << total_wall
+        << " | " << std::setw(12) << total_cpu << std::endl;
+
+    out.flags(flags);
+    out.precision(precision);
+}
+
+void PassManager::print_memory_report(std::ostream& out) const{
+#if MUSIC_STATS
+    const auto flags = out.flags();
+
+    out << "\n=== Memoria por pase ===\n" << std::endl;
+    out << std::setw(14) << std::left << "PASE"
+        << " | " << std::setw(12) << std::right << "RESERVAS"
+        << " | " << std::setw(14) << "BYTES" << std::endl;
+    out << std::string(46, '-') << std::endl;
+
+    std::uint64_t total_allocations = 0;
+    std::uint64_t total_bytes = 0;
+    for (const Entry& entry : passes){
+        out << std::setw(14) << std::left << entry.name << " | ";
+        if (entry.runs == 0){
+            out << (entry.enabled ? "(sin ejecutar)" : "(deshabilitado)") << std::endl;
+            continue;
+        }
+        out << std::setw(12) << std::right << entry.allocations
+            << " | " << std::setw(14) << entry.allocated_bytes << std::endl;
+        total_allocations += entry.allocations;
+        total_bytes += entry.allocated_bytes;
+    }
+
+    out << std::string(46, '-') << std::endl;
+    out << std::setw(14) << std::left << "total"
+        << " | " << std::setw(12) << std::right << total_allocations
+        << " | " << std::setw(14) << total_bytes << std::endl;
+
+    out.flags(flags);
+#else
+    (void)out;  // Sin contadores no hay nada que repartir por pase
+#endif
+}
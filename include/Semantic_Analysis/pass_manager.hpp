@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// Pipeline de pases con nombre y tiempo por pase.
+//
+// Cada binario registra sus pases en orden (lex, parse, resolve, type-check,
+// lowering...) y run() ejecuta los habilitados, midiendo el tiempo de pared
+// y el de CPU del hilo que los ejecuta (un pase que reparte trabajo en otros
+// hilos solo cuenta la CPU del suyo). Los tiempos se acumulan entre
+// ejecuciones, así que un pipeline se puede reutilizar para varios archivos y
+// los de varios hilos se suman con merge_timings(). Con las estadísticas
+// activas (stats.hpp) también se anotan los bytes pedidos a operator new
+// durante cada pase. No depende del AST para que el parser también pueda
+// usarlo.
+
+// Opciones de línea de comandos comunes a los binarios:
+//   --time-passes          imprimir el informe de tiempos al terminar
+//   --stats                imprimir las estadísticas (stats.hpp) al terminar
+//   --disable-pass NOMBRE  no ejecutar el pase
+//   --enable-pass NOMBRE   ejecutar un pase deshabilitado por defecto
+struct PassOptions
+{
+    bool time_passes = false;
+    bool stats = false;
+    std::vector<std::pair<std::string, bool>> toggles;   // (pase, habilitado) en orden
+};
+
+// Consume argv[i] (y su valor) si es una opción de pases. Devuelve false si no
+// lo es; error queda con un mensaje si la opción no tiene valor.
+bool parse_pass_option(int argc, char** argv, int& i, PassOptions& options, std::string& error);
+
+class PassManager
+{
+public:
+    // Devuelve false si el pase falló: los siguientes no se ejecutan
+    using Pass = std::function<bool()>;
+
+    // Agregar un pase al final del pipeline
+    void add_pass(std::string name, Pass pass, bool enabled = true);
+
+    // Devuelve false si no hay ningún pase con ese nombre
+    bool set_enabled(std::string_view name, bool enabled) noexcept;
+
+    bool is_enabled(std::string_view name) const noexcept;
+
+    // Aplicar los --enable-pass / --disable-pass; unknown recibe el primer
+    // nombre que no existe
+    bool configure(const PassOptions& options, std::string& unknown) noexcept;
+
+    // Ejecutar los pases habilitados en orden; false si alguno falló
+    bool run();
+
+    // Sumar los tiempos de otro pipeline con los mismos pases
+    void merge_timings(const PassManager& other) noexcept;
+
+    // Nombres de los pases, separados por comas (para los mensajes de error)
+    std::string get_pass_names() const;
+
+    // Tabla de tiempos: pared, CPU, porcentaje del total y ejecuciones
+    void print_report(std::ostream& out) const;
+
+    // Tabla de memoria: reservas y bytes pedidos por cada pase (--stats)
+    void print_memory_report(std::ostream& out) const;
+
+private:
+    struct Entry
+    {
+        std::string name;
+        Pass pass;
+        bool enabled;
+        double wall_ms;
+        double cpu_ms;
+        std::uint64_t allocations;
+        std::uint64_t allocated_bytes;
+        std::size_t runs;
+        std::size_t failures;
+    };
+
+    std::vector<Entry> passes;
+};
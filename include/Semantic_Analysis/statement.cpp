@@ -3,32 +3,58 @@
 #include "expression.hpp"
 #include "datatype.hpp"
 #include "symbol_table.hpp"
+#include "traversal.hpp"
 
 DeclarationStatement::DeclarationStatement(Declaration* _declaration) noexcept
-    : declaration(_declaration)
+    : Statement(NodeKind::DeclarationStatement), declaration(_declaration)
 {
+    hash_combine(hash_of(declaration));
 }
 
-void DeclarationStatement::destroy() noexcept
+bool Statement::memoized_type_check() const noexcept
 {
-    if (declaration != nullptr){
-        declaration->destroy();
-        delete declaration;
-        declaration = nullptr;
+    if (!is_shared()){
+        return type_check().first;
     }
+
+    const std::uint8_t memo = type_check_memo.load(std::memory_order_relaxed);
+    if (memo != unchecked){
+        return memo == checked_ok;
+    }
+
+    const bool result = type_check().first;
+    type_check_memo.store(result ? checked_ok : checked_failed, std::memory_order_relaxed);
+    return result;
 }
 
-ASTNodeInterface* DeclarationStatement::copy() const noexcept
+void DeclarationStatement::destroy() noexcept
 {
-    return new DeclarationStatement(
-        dynamic_cast<Declaration*>(declaration->copy())
-    );
+    NativeDepthGuard depth;
+    if (depth.exhausted()){
+        destroy_children(this);
+        declaration = nullptr;
+        return;
+    }
+
+    if (declaration != nullptr){
+        release(declaration);
+        declaration = nullptr;
+    }
 }
 
 bool DeclarationStatement::equal(ASTNodeInterface* other) const noexcept
 {
-    auto other_decl = dynamic_cast<DeclarationStatement*>(other);
-    if (other_decl == nullptr){
+    NativeDepthGuard depth;
+    if (depth.exhausted()){
+        return equal_tree(this, other);
+    }
+
+    if (other == this){
+        return true;
+    }
+
+    auto other_decl = dyn_cast<DeclarationStatement>(other);
+    if (other_decl == nullptr || hash() != other->hash()){
         return false;
     }
 
@@ -37,11 +63,21 @@ bool DeclarationStatement::equal(ASTNodeInterface* other) const noexcept
 
 std::pair<bool, Datatype*> DeclarationStatement::type_check() const noexcept
 {
+    NativeDepthGuard depth;
+    if (depth.exhausted()){
+        return type_check_tree(this);
+    }
+
     return declaration->type_check();
 }
 
 bool DeclarationStatement::resolve_name(SymbolTable& symbol_table) noexcept
 {
+    NativeDepthGuard depth;
+    if (depth.exhausted()){
+        return resolve_name_tree(this, symbol_table);
+    }
+
     return declaration->resolve_name(symbol_table);
 }
 
@@ -51,30 +87,39 @@ Declaration* DeclarationStatement::get_declaration() const noexcept
 }
 
 ExpressionStatement::ExpressionStatement(Expression* _expression) noexcept
-    : expression(_expression)
+    : Statement(NodeKind::ExpressionStatement), expression(_expression)
 {
+    hash_combine(hash_of(expression));
 }
 
 void ExpressionStatement::destroy() noexcept
 {
-    if (expression != nullptr){
-        expression->destroy();
-        delete expression;
+    NativeDepthGuard depth;
+    if (depth.exhausted()){
+        destroy_children(this);
         expression = nullptr;
+        return;
     }
-}
 
-ASTNodeInterface* ExpressionStatement::copy() const noexcept
-{
-    return new ExpressionStatement(
-        dynamic_cast<Expression*>(expression->copy())
-    );
+    if (expression != nullptr){
+        release(expression);
+        expression = nullptr;
+    }
 }
 
 bool ExpressionStatement::equal(ASTNodeInterface* other) const noexcept
 {
-    auto other_expr = dynamic_cast<ExpressionStatement*>(other);
-    if (other_expr == nullptr){
+    NativeDepthGuard depth;
+    if (depth.exhausted()){
+        return equal_tree(this, other);
+    }
+
+    if (other == this){
+        return true;
+    }
+
+    auto other_expr = dyn_cast<ExpressionStatement>(other);
+    if (other_expr == nullptr || hash() != other->hash()){
         return false;
     }
 
@@ -83,26 +128,26 @@ bool ExpressionStatement::equal(ASTNodeInterface* other) const noexcept
 
 std::pair<bool, Datatype*> ExpressionStatement::type_check() const noexcept
 {
+    NativeDepthGuard depth;
+    if (depth.exhausted()){
+        return type_check_tree(this);
+    }
+
     auto expr_type = expression->type_check();
     if (!expr_type.first){
-        if (expr_type.second != nullptr)
-        {
-            delete expr_type.second;
-            expr_type.second = nullptr;
-        }
         return std::make_pair(false, nullptr);
     }
 
-    if (expr_type.second != nullptr){
-        delete expr_type.second;
-        expr_type.second = nullptr;
-    }
-
     return std::make_pair(true, nullptr);
 }
 
 bool ExpressionStatement::resolve_name(SymbolTable& symbol_table) noexcept
 {
+    NativeDepthGuard depth;
+    if (depth.exhausted()){
+        return resolve_name_tree(this, symbol_table);
+    }
+
     return expression->resolve_name(symbol_table);
 }
 
@@ -112,30 +157,39 @@ Expression* ExpressionStatement::get_expression() const noexcept
 }
 
 PrintStatement::PrintStatement(Expression* _value) noexcept
-    : value(_value)
+    : Statement(NodeKind::PrintStatement), value(_value)
 {
+    hash_combine(hash_of(value));
 }
 
 void PrintStatement::destroy() noexcept
 {
-    if (value != nullptr){
-        value->destroy();
-        delete value;
+    NativeDepthGuard depth;
+    if (depth.exhausted()){
+        destroy_children(this);
         value = nullptr;
+        return;
     }
-}
 
-ASTNodeInterface* PrintStatement::copy() const noexcept
-{
-    return new PrintStatement(
-        dynamic_cast<Expression*>(value->copy())
-    );
+    if (value != nullptr){
+        release(value);
+        value = nullptr;
+    }
 }
 
 bool PrintStatement::equal(ASTNodeInterface* other) const noexcept
 {
-    auto other_print = dynamic_cast<PrintStatement*>(other);
-    if (other_print == nullptr){
+    NativeDepthGuard depth;
+    if (depth.exhausted()){
+        return equal_tree(this, other);
+    }
+
+    if (other == this){
+        return true;
+    }
+
+    auto other_print = dyn_cast<PrintStatement>(other);
+    if (other_print == nullptr || hash() != other->hash()){
         return false;
     }
 
@@ -144,26 +198,26 @@ bool PrintStatement::equal(ASTNodeInterface* other) const noexcept
 
 std::pair<bool, Datatype*> PrintStatement::type_check() const noexcept
 {
+    NativeDepthGuard depth;
+    if (depth.exhausted()){
+        return type_check_tree(this);
+    }
+
     auto value_type = value->type_check();
     if (!value_type.first){
-        if (value_type.second != nullptr)
-        {
-            delete value_type.second;
-            value_type.second = nullptr;
-        }
         return std::make_pair(false, nullptr);
     }
 
-    if (value_type.second != nullptr){
-        delete value_type.second;
-        value_type.second = nullptr;
-    }
-
     return std::make_pair(true, nullptr);
 }
 
 bool PrintStatement::resolve_name(SymbolTable& symbol_table) noexcept
 {
+    NativeDepthGuard depth;
+    if (depth.exhausted()){
+        return resolve_name_tree(this, symbol_table);
+    }
+
     return value->resolve_name(symbol_table);
 }
 
@@ -7,6 +7,25 @@ class Declaration;
 
 class Statement : public ASTNodeInterface
 {
+public:
+    static bool classof(const ASTNodeInterface* node) noexcept
+    {
+        return node->get_kind() >= NodeKind::FirstStatement && node->get_kind() <= NodeKind::LastStatement;
+    }
+
+    // type_check().first, memorizado si la sentencia está compartida
+    // (NodeInterner): el resultado solo depende del contenido, así que una
+    // sentencia que aparece en muchas posiciones se comprueba una sola vez
+    bool memoized_type_check() const noexcept;
+
+protected:
+    using ASTNodeInterface::ASTNodeInterface;
+
+private:
+    static constexpr std::uint8_t unchecked = 0, checked_ok = 1, checked_failed = 2;
+
+    // Puede escribirse desde varios hilos (analyze_program), siempre con el mismo valor
+    mutable std::atomic<std::uint8_t> type_check_memo{unchecked};
 };
 
 class DeclarationStatement : public Statement
@@ -14,9 +33,12 @@ class DeclarationStatement : public Statement
 public:
     explicit DeclarationStatement(Declaration* _declaration) noexcept;
 
-    void destroy() noexcept override;
+    static bool classof(const ASTNodeInterface* node) noexcept
+    {
+        return node->get_kind() == NodeKind::DeclarationStatement;
+    }
 
-    ASTNodeInterface* copy() const noexcept override;
+    void destroy() noexcept override;
 
     bool equal(ASTNodeInterface* other) const noexcept override;
 
@@ -35,9 +57,12 @@ class ExpressionStatement : public Statement
 public:
     explicit ExpressionStatement(Expression* _expression) noexcept;
 
-    void destroy() noexcept override;
+    static bool classof(const ASTNodeInterface* node) noexcept
+    {
+        return node->get_kind() == NodeKind::ExpressionStatement;
+    }
 
-    ASTNodeInterface* copy() const noexcept override;
+    void destroy() noexcept override;
 
     bool equal(ASTNodeInterface* other) const noexcept override;
 
@@ -57,9 +82,12 @@ class PrintStatement : public Statement
 public:
     explicit PrintStatement(Expression* _value) noexcept;
 
-    void destroy() noexcept override;
+    static bool classof(const ASTNodeInterface* node) noexcept
+    {
+        return node->get_kind() == NodeKind::PrintStatement;
+    }
 
-    ASTNodeInterface* copy() const noexcept override;
+    void destroy() noexcept override;
 
     bool equal(ASTNodeInterface* other) const noexcept override;
 
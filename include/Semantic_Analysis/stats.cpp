@@ -0,0 +1,201 @@
+#include "stats.hpp"
+
+#include <iomanip>
+#include <mutex>
+#include <ostream>
+#include <string>
+
+#include "ast_node_interface.hpp"
+
+static_assert(static_cast<std::size_t>(NodeKind::LastStatement) < max_node_kinds, "max_node_kinds es demasiado pequeño");
+
+// Bloques de los hilos vivos y total de los que ya terminaron. El registro no
+// pide memoria a operator new: allocation_counter.cpp cuenta desde ahí.
+static std::mutex blocks_mutex;
+static StatsBlock* live_blocks = nullptr;
+static StatsBlock retired;
+
+// Destino de los eventos de un hilo que ya soltó su bloque (destructores
+// thread_local posteriores); no entran en el informe
+static StatsBlock orphaned;
+
+// Dueño del bloque de un hilo: al terminar el hilo suma su bloque al total
+class StatsBlockOwner
+{
+public:
+    StatsBlockOwner() noexcept
+        : block{}
+    {
+        std::lock_guard<std::mutex> lock{blocks_mutex};
+        block.next = live_blocks;
+        live_blocks = &block;
+    }
+
+    ~StatsBlockOwner() noexcept
+    {
+        std::lock_guard<std::mutex> lock{blocks_mutex};
+        for (std::size_t i = 0; i < static_cast<std::size_t>(Counter::Count); ++i){
+            stats_add(retired.counters[i], block.counters[i].load(std::memory_order_relaxed));
+        }
+        for (std::size_t i = 0; i < max_node_kinds; ++i){
+            stats_add(retired.nodes[i], block.nodes[i].load(std::memory_order_relaxed));
+        }
+
+        StatsBlock** link = &live_blocks;
+        while (*link != &block){
+            link = &(*link)->next;
+        }
+        *link = block.next;
+        stats_block = &orphaned;
+    }
+
+    StatsBlockOwner(const StatsBlockOwner&) = delete;
+
+    StatsBlockOwner& operator=(const StatsBlockOwner&) = delete;
+
+    StatsBlock block;
+};
+
+StatsBlock* register_stats_block() noexcept{
+    thread_local StatsBlockOwner owner;
+    stats_block = &owner.block;
+    return stats_block;
+}
+
+std::uint64_t local_count(Counter counter) noexcept{
+    StatsBlock* block = stats_block;
+    return block != nullptr ? block->counters[static_cast<std::size_t>(counter)].load(std::memory_order_relaxed) : 0;
+}
+
+// Suma de todos los bloques: contadores y nodos por tipo
+static void snapshot(std::uint64_t* counters, std::uint64_t* nodes) noexcept{
+    std::lock_guard<std::mutex> lock{blocks_mutex};
+    for (std::size_t i = 0; i < static_cast<std::size_t>(Counter::Count); ++i){
+        counters[i] = retired.counters[i].load(std::memory_order_relaxed);
+    }
+    for (std::size_t i = 0; i < max_node_kinds; ++i){
+        nodes[i] = retired.nodes[i].load(std::memory_order_relaxed);
+    }
+
+    for (const StatsBlock* block = live_blocks; block != nullptr; block = block->next){
+        for (std::size_t i = 0; i < static_cast<std::size_t>(Counter::Count); ++i){
+            counters[i] += block->counters[i].load(std::memory_order_relaxed);
+        }
+        for (std::size_t i = 0; i < max_node_kinds; ++i){
+            nodes[i] += block->nodes[i].load(std::memory_order_relaxed);
+        }
+    }
+}
+
+std::uint64_t total_count(Counter counter) noexcept{
+    std::uint64_t counters[static_cast<std::size_t>(Counter::Count)];
+    std::uint64_t nodes[max_node_kinds];
+    snapshot(counters, nodes);
+    return counters[static_cast<std::size_t>(counter)];
+}
+
+#if MUSIC_STATS
+
+static const char* node_kind_name(std::size_t kind) noexcept{
+    static const char* const names[] = {
+        "VoidDatatype", "BooleanDatatype", "CharacterDatatype", "IntegerDatatype", "StringDatatype",
+        "NoteDatatype", "TempoDatatype", "KeyDatatype", "TimeSignatureDatatype", "ArrayDatatype",
+        "FunctionDatatype",
+        "VariableDeclaration", "TempoDeclaration", "KeyDeclaration", "TimeSignatureDeclaration",
+        "NoteDeclaration", "FunctionDeclaration",
+        "BoolExpression", "IntExpression", "StrExpression", "NoteExpression", "KeyExpression",
+        "TempoExpression", "TimeSignatureExpression", "NameExpression", "ArrayAccessExpression",
+        "AssignmentExpression", "CallExpression", "ArgExpression", "SharpExpression",
+        "DeclarationStatement", "ExpressionStatement", "PrintStatement"
+    };
+    static_assert(sizeof(names) / sizeof(names[0]) == static_cast<std::size_t>(NodeKind::LastStatement) + 1,
+                  "falta el nombre de algún NodeKind");
+    return names[kind];
+}
+
+static void print_line(std::ostream& out, const std::string& label, std::uint64_t value){
+    // setw cuenta bytes: los de continuación UTF-8 no ocupan columna
+    std::size_t width = 34;
+    for (char c : label){
+        width += (static_cast<unsigned char>(c) & 0xC0) == 0x80;
+    }
+    out << "  " << std::setw(static_cast<int>(width)) << std::left << label << std::setw(14) << std::right << value << std::endl;
+}
+
+#endif
+
+void print_stats(std::ostream& out, unsigned sections){
+    const auto flags = out.flags();
+    out << "\n=== Estadísticas ===" << std::endl;
+
+#if MUSIC_STATS
+    std::uint64_t counters[static_cast<std::size_t>(Counter::Count)];
+    std::uint64_t nodes[max_node_kinds];
+    snapshot(counters, nodes);
+    auto value = [&counters](Counter counter) {
+        return counters[static_cast<std::size_t>(counter)];
+    };
+
+    if (sections & stats_ast){
+        std::uint64_t total_nodes = 0;
+        std::uint64_t datatypes = 0;
+        for (std::size_t kind = 0; kind <= static_cast<std::size_t>(NodeKind::LastStatement); ++kind){
+            total_nodes += nodes[kind];
+            if (kind <= static_cast<std::size_t>(NodeKind::LastDatatype)){
+                datatypes += nodes[kind];
+            }
+        }
+
+        out << "\nNodos del AST construidos: " << total_nodes << std::endl;
+        for (std::size_t kind = 0; kind <= static_cast<std::size_t>(NodeKind::LastStatement); ++kind){
+            if (nodes[kind] != 0){
+                print_line(out, node_kind_name(kind), nodes[kind]);
+            }
+        }
+        print_line(out, "(Datatype en total)", datatypes);
+
+        out << "\nConversiones" << std::endl;
+        print_line(out, "isa<> / is<>", value(Counter::KindCheck));
+        print_line(out, "dyn_cast<>", value(Counter::DynCast));
+        print_line(out, "dyn_cast<> nulos", value(Counter::DynCastNull));
+    }
+
+    if (sections & stats_symbols){
+        out << "\nTabla de símbolos" << std::endl;
+        print_line(out, "enlaces", value(Counter::SymbolBind));
+        print_line(out, "enlaces rechazados", value(Counter::SymbolBindRejected));
+        print_line(out, "búsquedas encontradas", value(Counter::SymbolLookupHit));
+        print_line(out, "búsquedas fallidas", value(Counter::SymbolLookupMiss));
+        print_line(out, "casillas examinadas", value(Counter::SymbolSlotProbe));
+        print_line(out, "búsquedas en la tabla padre", value(Counter::SymbolParentLookup));
+    }
+
+    if (sections & stats_parser){
+        out << "\nParser" << std::endl;
+        print_line(out, "configuraciones", value(Counter::ParserConfiguration));
+        print_line(out, "programas", value(Counter::ParserProgram));
+        print_line(out, "notas", value(Counter::ParserNote));
+        print_line(out, "programas leídos del .musc", value(Counter::AstCacheHit));
+        print_line(out, "programas sin .musc válido", value(Counter::AstCacheMiss));
+    }
+
+    if (sections & stats_result_cache){
+        out << "\nCaché de resultados" << std::endl;
+        print_line(out, "aciertos", value(Counter::ResultCacheHit));
+        print_line(out, "fallos", value(Counter::ResultCacheMiss));
+        print_line(out, "entradas guardadas", value(Counter::ResultCacheStore));
+        print_line(out, "entradas desalojadas", value(Counter::ResultCacheEvicted));
+    }
+
+    if (sections & stats_memory){
+        out << "\nMemoria (operator new)" << std::endl;
+        print_line(out, "reservas", value(Counter::Allocation));
+        print_line(out, "bytes", value(Counter::AllocatedBytes));
+    }
+#else
+    (void)sections;
+    out << "Estadísticas deshabilitadas (compilar con STATS=1)" << std::endl;
+#endif
+
+    out.flags(flags);
+}
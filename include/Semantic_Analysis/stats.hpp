@@ -0,0 +1,134 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+
+// Estadísticas de compilación: nodos construidos por tipo, conversiones
+// dyn_cast<>, operaciones de la tabla de símbolos, nodos del parser, uso
+// de las cachés (.musc y de resultados) y memoria pedida a operator new.
+//
+// Cada hilo cuenta en su propio bloque, sin locks ni operaciones atómicas de
+// lectura-modificación-escritura (un incremento normal por evento); los
+// bloques se suman al pedir el informe y el de un hilo que termina se guarda
+// en el total. Con MUSIC_STATS=0 (make STATS=0) las funciones de conteo
+// quedan vacías y el compilador las elimina.
+//
+// Los bytes de operator new solo se cuentan en los binarios que enlazan
+// allocation_counter.cpp (los dos ejecutables); los benchmarks que miden la
+// memoria reemplazan operator new por su cuenta.
+
+#ifndef MUSIC_STATS
+#define MUSIC_STATS 1
+#endif
+
+enum class Counter : std::uint8_t
+{
+    // Conversiones del AST
+    KindCheck,            // isa<> y Datatype::is<>
+    DynCast,
+    DynCastNull,          // dyn_cast<> que devolvió nullptr
+
+    // Tabla de símbolos
+    SymbolBind,
+    SymbolBindRejected,   // Nombre ya declarado en el mismo ámbito
+    SymbolLookupHit,
+    SymbolLookupMiss,
+    SymbolSlotProbe,      // Casillas de la tabla hash examinadas
+    SymbolParentLookup,   // Búsquedas que siguieron en la tabla padre
+
+    // Parser
+    ParserConfiguration,
+    ParserProgram,
+    ParserNote,
+    AstCacheHit,          // Programas leídos de un .musc
+    AstCacheMiss,         // Análisis con --ast-cache sin un .musc válido
+    ResultCacheHit,       // Veredictos leídos de la caché de resultados
+    ResultCacheMiss,
+    ResultCacheStore,
+    ResultCacheEvicted,
+
+    // operator new
+    Allocation,
+    AllocatedBytes,
+
+    Count
+};
+
+// Un contador por NodeKind (ast_node_interface.hpp)
+constexpr std::size_t max_node_kinds = 64;
+
+struct StatsBlock
+{
+    std::atomic<std::uint64_t> counters[static_cast<std::size_t>(Counter::Count)];
+    std::atomic<std::uint64_t> nodes[max_node_kinds];
+    StatsBlock* next;
+};
+
+// Bloque del hilo actual (nullptr hasta el primer evento). Con inicialización
+// constante y visible en el encabezado, el acceso no pasa por una función
+// de envoltura de thread_local.
+inline thread_local StatsBlock* stats_block = nullptr;
+
+StatsBlock* register_stats_block() noexcept;
+
+inline StatsBlock& local_stats() noexcept
+{
+    StatsBlock* block = stats_block;
+    if (__builtin_expect(block == nullptr, 0))
+    {
+        block = register_stats_block();
+    }
+    return *block;
+}
+
+// Solo escribe el hilo dueño del bloque: load + store relajados compilan a
+// un incremento normal, y el informe puede leerlo desde otro hilo sin carrera
+inline void stats_add(std::atomic<std::uint64_t>& value, std::uint64_t amount) noexcept
+{
+    value.store(value.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+}
+
+#if MUSIC_STATS
+
+inline void count(Counter counter, std::uint64_t amount = 1) noexcept
+{
+    stats_add(local_stats().counters[static_cast<std::size_t>(counter)], amount);
+}
+
+inline void count_node(std::uint8_t kind) noexcept
+{
+    stats_add(local_stats().nodes[kind], 1);
+}
+
+#else
+
+inline void count(Counter, std::uint64_t = 1) noexcept
+{
+}
+
+inline void count_node(std::uint8_t) noexcept
+{
+}
+
+#endif
+
+// Valor de un contador en el hilo actual (para medir un pase por diferencia)
+std::uint64_t local_count(Counter counter) noexcept;
+
+// Valor de un contador sumado entre todos los hilos
+std::uint64_t total_count(Counter counter) noexcept;
+
+// Secciones del informe: cada binario pide solo las que puede llenar
+enum StatsSection : unsigned
+{
+    stats_ast = 1,          // Nodos por tipo y conversiones
+    stats_symbols = 2,      // Tabla de símbolos
+    stats_parser = 4,       // Nodos del parser y caché .musc
+    stats_result_cache = 8,
+    stats_memory = 16
+};
+
+// Informe de las secciones pedidas (de los tipos de nodo, solo los construidos)
+void print_stats(std::ostream& out, unsigned sections);
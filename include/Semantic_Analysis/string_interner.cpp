@@ -0,0 +1,83 @@
+#include "string_interner.hpp"
+
+#include <functional>
+
+StringInterner& StringInterner::instance() noexcept{
+    static StringInterner interner;
+    return interner;
+}
+
+StringInterner::StringInterner() noexcept
+    : chunks{new std::atomic<std::string_view*>[max_chunks]}, next_id{0}
+{
+    for (std::size_t i = 0; i < max_chunks; ++i){
+        chunks[i].store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+StringInterner::~StringInterner() noexcept{
+    for (std::size_t i = 0; i < max_chunks; ++i){
+        delete[] chunks[i].load(std::memory_order_relaxed);
+    }
+    delete[] chunks;
+}
+
+StringInterner::Shard& StringInterner::shard_for(std::string_view name) const noexcept{
+    return shards[std::hash<std::string_view>{}(name) % shard_count];
+}
+
+NameId StringInterner::intern(std::string_view name){
+    Shard& shard = shard_for(name);
+    std::lock_guard<std::mutex> lock{shard.mutex};
+
+    auto it = shard.ids.find(name);
+    if (it != shard.ids.end()){
+        return it->second;
+    }
+
+    NameId id = next_id.fetch_add(1, std::memory_order_relaxed);
+    shard.names.emplace_back(name);
+    std::string_view stored = shard.names.back();
+    publish(id, stored);
+    shard.ids.emplace(stored, id);
+    return id;
+}
+
+NameId StringInterner::find(std::string_view name) const noexcept{
+    Shard& shard = shard_for(name);
+    std::lock_guard<std::mutex> lock{shard.mutex};
+
+    auto it = shard.ids.find(name);
+    return it != shard.ids.end() ? it->second : invalid_id;
+}
+
+std::string_view StringInterner::get(NameId id) const noexcept{
+    std::string_view* chunk = chunks[id >> chunk_bits].load(std::memory_order_acquire);
+    return chunk[id & (chunk_size - 1)];
+}
+
+std::size_t StringInterner::size() const noexcept{
+    return next_id.load(std::memory_order_relaxed);
+}
+
+void StringInterner::publish(NameId id, std::string_view name){
+    std::atomic<std::string_view*>& slot = chunks[id >> chunk_bits];
+    std::string_view* chunk = slot.load(std::memory_order_acquire);
+    if (chunk == nullptr){
+        std::lock_guard<std::mutex> lock{chunk_mutex};
+        chunk = slot.load(std::memory_order_relaxed);
+        if (chunk == nullptr){
+            chunk = new std::string_view[chunk_size];
+            slot.store(chunk, std::memory_order_release);
+        }
+    }
+    chunk[id & (chunk_size - 1)] = name;
+}
+
+NameId intern_name(std::string_view name){
+    return StringInterner::instance().intern(name);
+}
+
+std::string_view name_text(NameId id) noexcept{
+    return StringInterner::instance().get(id);
+}
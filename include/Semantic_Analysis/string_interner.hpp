@@ -0,0 +1,79 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+// Identificador interno de un nombre: dos nombres iguales tienen el mismo id
+using NameId = std::uint32_t;
+
+// Tabla global de nombres internados, compartida por el lexer, el parser y el AST.
+//
+// Cada cadena distinta se guarda una sola vez y se identifica con un entero
+// denso, de modo que las etapas posteriores guardan 4 bytes por nombre y
+// comparan nombres comparando enteros. Es segura entre hilos: la tabla se
+// reparte en fragmentos con su propio mutex, y get() no toma ningún lock.
+class StringInterner
+{
+public:
+    static constexpr NameId invalid_id = UINT32_MAX;
+
+    static StringInterner& instance() noexcept;
+
+    // Id del nombre, agregándolo si no existía
+    NameId intern(std::string_view name);
+
+    // Id del nombre o invalid_id si nunca se internó (no agrega nada)
+    NameId find(std::string_view name) const noexcept;
+
+    // Texto de un id válido (la vista es estable durante todo el programa)
+    std::string_view get(NameId id) const noexcept;
+
+    // Cantidad de nombres distintos
+    std::size_t size() const noexcept;
+
+    StringInterner(const StringInterner&) = delete;
+    StringInterner& operator=(const StringInterner&) = delete;
+
+private:
+    StringInterner() noexcept;
+
+    ~StringInterner() noexcept;
+
+    static constexpr std::size_t shard_count = 16;
+    static constexpr std::size_t chunk_bits = 16;
+    static constexpr std::size_t chunk_size = std::size_t{1} << chunk_bits;
+    static constexpr std::size_t max_chunks = std::size_t{1} << (32 - chunk_bits);
+
+    struct Shard
+    {
+        mutable std::mutex mutex;
+        // deque: las cadenas no se mueven al crecer, así que las vistas siguen siendo válidas
+        std::deque<std::string> names;
+        std::unordered_map<std::string_view, NameId> ids;
+    };
+
+    Shard& shard_for(std::string_view name) const noexcept;
+
+    // Registrar el texto del id (bajo el lock del fragmento que lo creó)
+    void publish(NameId id, std::string_view name);
+
+    mutable Shard shards[shard_count];
+
+    // Texto de cada id en bloques de tamaño fijo: los bloques no se mueven, así
+    // que get() puede leerlos mientras otros hilos agregan nombres
+    std::atomic<std::string_view*>* chunks;
+    std::mutex chunk_mutex;
+
+    std::atomic<NameId> next_id;
+};
+
+// Atajos sobre la tabla global
+NameId intern_name(std::string_view name);
+
+std::string_view name_text(NameId id) noexcept;
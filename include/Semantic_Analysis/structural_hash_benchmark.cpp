@@ -0,0 +1,140 @@
+/*
+    Compilador Musical: Benchmark del hash estructural
+
+    Compara con equal_body cuerpos de 100k sentencias (notas, sostenidos
+    anidados, llamadas con argumentos y variables) construidos por separado,
+    ya que copy_body comparte las sentencias: iguales, distintos en la
+    primera o en la última sentencia y de distinta longitud; y funciones con
+    esos cuerpos, que se rechazan sin mirar el cuerpo. Por último deduplica las
+    sentencias de un cuerpo en un std::unordered_set con ASTNodeHash.
+
+    Uso: ./structural_hash_benchmark [sentencias] [repeticiones]
+*/
+
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <unordered_set>
+
+#include "benchmark_support.hpp"
+#include "datatype.hpp"
+#include "declaration.hpp"
+#include "expression.hpp"
+#include "statement.hpp"
+
+static void print_row(const std::string& label, double ms, bool success) {
+    print_label(label, 32);
+    print_ms(ms, 10, 3);
+    print_verdict(success);
+}
+
+// Las sentencias se repiten cada `period` posiciones (para la deduplicación)
+static Statement* make_statement(int index, int period) {
+    const int value = index % period;
+    switch (index % 4) {
+        case 0:
+            return new DeclarationStatement{new NoteDeclaration{
+                intern_name("nota" + std::to_string(value)), "CDEFGAB"[value % 7], 4, intern_name("Negra")}};
+        case 1:
+            return new ExpressionStatement{new SharpExpression{new SharpExpression{
+                new NameExpression{intern_name("nota" + std::to_string(value))}}}};
+        case 2:
+            return new PrintStatement{new CallExpression{new NameExpression{intern_name("motivo")},
+                new ArgExpression{new IntExpression{value}, new ArgExpression{new NameExpression{intern_name("x")}, nullptr}}}};
+        default:
+            return new DeclarationStatement{new VariableDeclaration{
+                intern_name("v" + std::to_string(value)), new IntegerDatatype{}, new IntExpression{value}}};
+    }
+}
+
+static Body make_body(int size, int period) {
+    Body body;
+    auto tail = body.before_begin();
+    for (int i = 0; i < size; ++i) {
+        tail = body.insert_after(tail, make_statement(i, period));
+    }
+    return body;
+}
+
+static Statement* make_function(const Body& body) {
+    return new DeclarationStatement{new FunctionDeclaration{
+        intern_name("motivo"), new FunctionDatatype{new VoidDatatype{}, ParamList{}}, body}};
+}
+
+// Repetir equal_body y comprobar que siempre da el resultado esperado
+template <typename Compare>
+static void measure(const std::string& label, int repetitions, bool expected, Compare&& compare, bool& success) {
+    bool same = true;
+    auto start = Clock::now();
+    for (int r = 0; r < repetitions; ++r) {
+        same = compare() == expected && same;
+    }
+    auto end = Clock::now();
+    print_row(label, elapsed_ms(start, end) / repetitions, same);
+    success = success && same;
+}
+
+int main(int argc, char** argv){
+    int size = argc > 1 ? std::atoi(argv[1]) : 100000;
+    int repetitions = argc > 2 ? std::atoi(argv[2]) : 10;
+    if (size < 2 || repetitions <= 0) {
+        std::cerr << "Uso: " << argv[0] << " [sentencias] [repeticiones]" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "====== Benchmark del hash estructural (" << size << " sentencias, "
+              << repetitions << " repeticiones) ======" << std::endl;
+
+    bool success = true;
+    Body original = make_body(size, size);
+
+    // Los cuerpos construidos igual tienen el mismo hash que el original
+    Body same = make_body(size, size);
+    measure("iguales", repetitions, true, [&]() { return equal_body(original, same); }, success);
+
+    Body last = make_body(size, size);
+    replace_statement(last, std::next(last.begin(), size - 1), make_statement(size, size + 1));
+    measure("distinta la última", repetitions, false, [&]() { return equal_body(original, last); }, success);
+
+    Body first = make_body(size, size);
+    replace_statement(first, first.begin(), make_statement(size * 4, size * 4 + 1));
+    measure("distinta la primera", repetitions, false, [&]() { return equal_body(original, first); }, success);
+
+    Body longer = make_body(size, size);
+    longer.insert_after(std::next(longer.begin(), size - 1), make_statement(size, size + 1));
+    measure("una sentencia más", repetitions, false, [&]() { return equal_body(original, longer); }, success);
+
+    // El hash de la función incluye el de su cuerpo: se rechaza en O(1)
+    Statement* function = make_function(make_body(size, size));
+    Statement* same_function = make_function(make_body(size, size));
+    Body other_body = make_body(size, size);
+    replace_statement(other_body, std::next(other_body.begin(), size - 1), make_statement(size, size + 1));
+    Statement* other_function = make_function(other_body);
+    measure("funciones iguales", repetitions, true, [&]() { return function->equal(same_function); }, success);
+    measure("funciones, distinta la última", repetitions, false, [&]() { return function->equal(other_function); }, success);
+
+    // Deduplicación: cada sentencia se repite size / 64 veces
+    Body repeated = make_body(size, 64);
+    std::size_t unique = 0;
+    auto start = Clock::now();
+    for (int r = 0; r < repetitions; ++r) {
+        std::unordered_set<Statement*, ASTNodeHash, ASTNodeEqual> statements;
+        for (Statement* statement : repeated) {
+            statements.insert(statement);
+        }
+        unique = statements.size();
+    }
+    auto end = Clock::now();
+    print_row("deduplicar (" + std::to_string(unique) + " únicas)", elapsed_ms(start, end) / repetitions, unique == 64);
+    success = success && unique == 64;
+
+    for (Statement* statement : {function, same_function, other_function}) {
+        release(statement);
+    }
+    for (Body* body : {&original, &same, &last, &first, &longer, &repeated}) {
+        destroy_body(*body);
+    }
+    return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -1,75 +1,204 @@
 #include "symbol_table.hpp"
 #include "datatype.hpp"
+#include "stats.hpp"
 
-std::shared_ptr<Symbol> Symbol::build(Datatype* type, std::string_view name) noexcept{
-    auto symbol = std::make_shared<Symbol>();
-    symbol->type = type;
-    symbol->name = name;
-    return symbol;
-}
-
-SymbolTable::SymbolTable() noexcept{
+SymbolTable::SymbolTable() noexcept
+    : symbols(symbol_block_size), slots(initial_capacity, Slot{StringInterner::invalid_id, no_binding}), used_slots{0},
+      pass{false}, parent{nullptr}, parent_bindings{0}
+{
     // Iniciar con un ámbito global
     enter_scope();
 }
 
 SymbolTable::~SymbolTable() noexcept
 {
-    // limpiamos el vector directamente 
-    scopes.clear();
 }
 
 void SymbolTable::enter_scope() noexcept{
-    scopes.push_back(TableType());
+    scope_starts.push_back(static_cast<std::uint32_t>(bindings.size()));
 }
 
 bool SymbolTable::exit_scope() noexcept{
-    if (scopes.size() <= 1){
+    if (scope_starts.size() <= 1){
         // no permitir eliminar el ambito global
         return false;
     }
 
-    scopes.pop_back();
+    // Deshacer los enlaces del ámbito en orden inverso, restaurando los ocultos
+    const std::uint32_t start = scope_starts.back();
+    scope_starts.pop_back();
+    while (bindings.size() > start){
+        const Binding& binding = bindings.back();
+        find_slot(binding.name)->binding = binding.shadowed;
+        bindings.pop_back();
+    }
+
     return true;
 }
 
-SymbolTable::TableType::size_type SymbolTable::scope_level() const noexcept{
-    return scopes.size();
+std::size_t SymbolTable::scope_level() const noexcept{
+    return scope_starts.size();
+}
+
+std::size_t SymbolTable::binding_count() const noexcept{
+    return bindings.size();
+}
+
+void SymbolTable::set_parent(const SymbolTable* _parent, std::size_t visible_bindings) noexcept{
+    parent = _parent;
+    parent_bindings = visible_bindings;
+}
+
+NameId SymbolTable::intern(std::string_view name) noexcept{
+    return intern_name(name);
+}
+
+Symbol* SymbolTable::make_symbol(Datatype* type, NameId name) noexcept{
+    return symbols.make<Symbol>(Symbol{type, name});
+}
+
+Symbol* SymbolTable::make_symbol(Datatype* type, std::string_view name) noexcept{
+    return make_symbol(type, intern_name(name));
 }
 
-bool SymbolTable::bind(const std::string& name, std::shared_ptr<Symbol> symbol) noexcept{
+bool SymbolTable::bind(const std::string& name, Symbol* symbol) noexcept{
+    return bind(intern_name(name), symbol);
+}
+
+bool SymbolTable::bind(NameId name, Symbol* symbol) noexcept{
+    Slot& slot = insert_slot(name);
+    const std::uint32_t scope = static_cast<std::uint32_t>(scope_starts.size());
+
     // Verificar si el símbolo ya existe en el ámbito actual
-    if (current_scope_lookup(name) != nullptr){
+    if (slot.binding != no_binding && bindings[slot.binding].scope == scope){
+        count(Counter::SymbolBindRejected);
         return false; // si el simbolo ya existe en este ambito
     }
 
-    // agregar el simbolo al ambito actual
-    scopes.back()[name] = symbol;
+    count(Counter::SymbolBind);
+
+    // agregar el simbolo al ambito actual, ocultando el enlace exterior
+    bindings.push_back(Binding{name, scope, slot.binding, symbol});
+    slot.binding = static_cast<std::uint32_t>(bindings.size() - 1);
     return true;
 }
 
-std::shared_ptr<Symbol> SymbolTable::lookup(const std::string& name) noexcept{
-    // buscar el simbolo en todos los ambitos, comenzando por el mas reciente
-    for (auto it = scopes.rbegin(); it != scopes.rend(); ++it){
-        auto symbol = find_in_scope(name, *it);
-        if (symbol != nullptr)
-        {
-            return symbol;
-        }
+Symbol* SymbolTable::lookup(const std::string& name) noexcept{
+    // Un nombre que nunca se internó no puede estar enlazado
+    NameId id = StringInterner::instance().find(name);
+    return id != StringInterner::invalid_id ? lookup(id) : nullptr;
+}
+
+Symbol* SymbolTable::lookup(NameId name) noexcept{
+    const Binding* binding = visible_binding(name);
+    if (binding == nullptr && parent != nullptr){
+        binding = parent->binding_before(name, parent_bindings);
     }
+    count(binding != nullptr ? Counter::SymbolLookupHit : Counter::SymbolLookupMiss);
+    return binding != nullptr ? binding->symbol : nullptr;
+}
 
-    return nullptr; // No se encontró el símbolo
+Symbol* SymbolTable::current_scope_lookup(const std::string& name) noexcept{
+    NameId id = StringInterner::instance().find(name);
+    return id != StringInterner::invalid_id ? current_scope_lookup(id) : nullptr;
 }
 
-std::shared_ptr<Symbol> SymbolTable::current_scope_lookup(const std::string& name) noexcept{
+Symbol* SymbolTable::current_scope_lookup(NameId name) noexcept{
     // Buscar sólo en el ámbito actual
-    return find_in_scope(name, scopes.back());
+    const Binding* binding = visible_binding(name);
+    if (binding != nullptr && binding->scope == scope_starts.size()){
+        return binding->symbol;
+    }
+    return nullptr;
 }
 
-std::shared_ptr<Symbol> SymbolTable::find_in_scope(const std::string& name, const TableType& scope) noexcept{
-    auto it = scope.find(name);
-    if (it != scope.end()){
-        return it->second;
-    }  
-    return nullptr;
-} 
\ No newline at end of file
+SymbolTable::ResolvePass& SymbolTable::resolve_pass() noexcept{
+    return pass;
+}
+
+const SymbolTable::Binding* SymbolTable::visible_binding(NameId name) noexcept{
+    Slot* slot = find_slot(name);
+    if (slot == nullptr || slot->binding == no_binding){
+        return nullptr;
+    }
+    return &bindings[slot->binding];
+}
+
+const SymbolTable::Binding* SymbolTable::binding_before(NameId name, std::size_t count) const noexcept{
+    // Solo se consulta desde una tabla hija (o recursivamente, subiendo)
+    ::count(Counter::SymbolParentLookup);
+    const Slot* slot = find_slot(name);
+    std::uint32_t index = slot != nullptr ? slot->binding : no_binding;
+
+    // Los enlaces posteriores al corte se saltan siguiendo la cadena de sombreado
+    while (index != no_binding && index >= count){
+        index = bindings[index].shadowed;
+    }
+
+    if (index != no_binding){
+        return &bindings[index];
+    }
+    return parent != nullptr ? parent->binding_before(name, parent_bindings) : nullptr;
+}
+
+// Hash de Fibonacci: los ids son densos, así que basta con dispersarlos
+static std::size_t slot_index(NameId name, std::size_t mask) noexcept{
+    return (static_cast<std::uint64_t>(name) * 0x9E3779B97F4A7C15ull >> 32) & mask;
+}
+
+SymbolTable::Slot* SymbolTable::find_slot(NameId name) noexcept{
+    return const_cast<Slot*>(static_cast<const SymbolTable*>(this)->find_slot(name));
+}
+
+const SymbolTable::Slot* SymbolTable::find_slot(NameId name) const noexcept{
+    const std::size_t mask = slots.size() - 1;
+    std::uint64_t probes = 1;
+    for (std::size_t i = slot_index(name, mask); ; i = (i + 1) & mask, ++probes){
+        const Slot& slot = slots[i];
+        if (slot.name == name){
+            count(Counter::SymbolSlotProbe, probes);
+            return &slot;
+        }
+        if (slot.name == StringInterner::invalid_id){
+            count(Counter::SymbolSlotProbe, probes);
+            return nullptr;
+        }
+    }
+}
+
+SymbolTable::Slot& SymbolTable::insert_slot(NameId name) noexcept{
+    // Mantener la carga por debajo del 70% para que los sondeos sean cortos
+    if ((used_slots + 1) * 10 > slots.size() * 7){
+        grow();
+    }
+
+    const std::size_t mask = slots.size() - 1;
+    for (std::size_t i = slot_index(name, mask); ; i = (i + 1) & mask){
+        Slot& slot = slots[i];
+        if (slot.name == name){
+            return slot;
+        }
+        if (slot.name == StringInterner::invalid_id){
+            slot.name = name;
+            ++used_slots;
+            return slot;
+        }
+    }
+}
+
+void SymbolTable::grow() noexcept{
+    std::vector<Slot> previous(slots.size() * 2, Slot{StringInterner::invalid_id, no_binding});
+    previous.swap(slots);
+
+    const std::size_t mask = slots.size() - 1;
+    for (const Slot& slot : previous){
+        if (slot.name == StringInterner::invalid_id){
+            continue;
+        }
+        std::size_t i = slot_index(slot.name, mask);
+        while (slots[i].name != StringInterner::invalid_id){
+            i = (i + 1) & mask;
+        }
+        slots[i] = slot;
+    }
+}
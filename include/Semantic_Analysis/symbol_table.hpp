@@ -1,33 +1,46 @@
 #pragma once
 
-#include <memory>
+#include <cstdint>
 #include <string>
 #include <string_view>
-#include <unordered_map>
 #include <vector>
 
+#include "arena.hpp"
+#include "string_interner.hpp"
+
 class Datatype;
 
-// Estructura para representar un símbolo en la tabla de símbolos
+// Estructura para representar un símbolo en la tabla de símbolos.
+// Los símbolos viven en la arena de la tabla que los creó; type no es dueño
+// del tipo (apunta al Datatype del AST o a uno canónico de TypeContext).
 struct Symbol
 {
     Datatype* type;
-    std::string name;
-    
-    static std::shared_ptr<Symbol> build(Datatype* type, std::string_view name) noexcept;
+    NameId name;
 };
 
-// Tabla de símbolos para el análisis semántico del lenguaje musical
+// Tabla de símbolos para el análisis semántico del lenguaje musical.
+//
+// Una sola tabla hash de direccionamiento abierto, indexada por el id del
+// nombre en la tabla global de nombres (StringInterner), guarda para cada nombre su enlace visible. Cada enlace
+// recuerda al que ocultó (cadena de sombreado) y la lista de enlaces funciona
+// como registro de deshacer: salir de un ámbito restaura solo los nombres que
+// ese ámbito enlazó, y buscar cuesta un sondeo sin importar la profundidad.
+//
+// Los símbolos se crean con make_symbol() en una arena propia de la tabla (una
+// por compilación) y las búsquedas devuelven punteros no dueños, válidos
+// mientras viva la tabla.
 class SymbolTable
 {
 public:
-    using TableType = std::unordered_map<std::string, std::shared_ptr<Symbol>>;
-    using TableStack = std::vector<TableType>;
-
     SymbolTable() noexcept;
 
     ~SymbolTable() noexcept;
 
+    SymbolTable(const SymbolTable&) = delete;
+
+    SymbolTable& operator=(const SymbolTable&) = delete;
+
     // Crear un nuevo ámbito
     void enter_scope() noexcept;
 
@@ -35,21 +48,97 @@ public:
     bool exit_scope() noexcept;
 
     // Obtener el nivel de ámbito actual
-    TableType::size_type scope_level() const noexcept;
+    std::size_t scope_level() const noexcept;
+
+    // Enlaces vivos en todos los ámbitos abiertos (sirve de corte para set_parent)
+    std::size_t binding_count() const noexcept;
+
+    // Convertir la tabla en hija de parent: las búsquedas que no encuentran el
+    // nombre siguen en los primeros visible_bindings enlaces de parent. parent
+    // no debe modificarse mientras tenga hijas; varias pueden leerlo a la vez.
+    void set_parent(const SymbolTable* parent, std::size_t visible_bindings) noexcept;
+
+    // Id internado de un nombre (para enlazar y buscar sin volver a hashear la cadena)
+    NameId intern(std::string_view name) noexcept;
+
+    // Crear un símbolo en la arena de la tabla
+    Symbol* make_symbol(Datatype* type, NameId name) noexcept;
+    Symbol* make_symbol(Datatype* type, std::string_view name) noexcept;
 
     // Asociar un nombre a un símbolo en el ámbito actual
-    bool bind(const std::string& name, std::shared_ptr<Symbol> symbol) noexcept;
+    bool bind(const std::string& name, Symbol* symbol) noexcept;
+    bool bind(NameId name, Symbol* symbol) noexcept;
 
     // Buscar un símbolo por nombre en todos los ámbitos, comenzando por el actual
-    std::shared_ptr<Symbol> lookup(const std::string& name) noexcept;
+    // (y siguiendo en la tabla padre, si la hay)
+    Symbol* lookup(const std::string& name) noexcept;
+    Symbol* lookup(NameId name) noexcept;
 
     // Buscar un símbolo por nombre solo en el ámbito actual
-    std::shared_ptr<Symbol> current_scope_lookup(const std::string& name) noexcept;
+    Symbol* current_scope_lookup(const std::string& name) noexcept;
+    Symbol* current_scope_lookup(NameId name) noexcept;
+
+    // Estado de la pasada de resolución de nombres en curso (ver resolve_name_body).
+    // Vive en la tabla, no en variables estáticas, para que cada compilación
+    // tenga el suyo y puedan resolverse varias a la vez
+    struct ResolvePass
+    {
+        bool in_function;          // Resolviendo el cuerpo de una función
+    };
+
+    ResolvePass& resolve_pass() noexcept;
 
 private:
-    // Función auxiliar para buscar en un ámbito específico
-    static std::shared_ptr<Symbol> find_in_scope(const std::string& name, const TableType& scope) noexcept;
+    static constexpr std::uint32_t no_binding = UINT32_MAX;
+    static constexpr std::size_t initial_capacity = 64;
+    static constexpr std::size_t symbol_block_size = 4 * 1024;
+
+    struct Binding
+    {
+        NameId name;
+        std::uint32_t scope;       // Nivel de ámbito (1 = global)
+        std::uint32_t shadowed;    // Enlace anterior del mismo nombre o no_binding
+        Symbol* symbol;
+    };
+
+    // Ranura de la tabla hash: una vez ocupada por un nombre queda asignada a él,
+    // por eso no hacen falta lápidas al salir de un ámbito
+    struct Slot
+    {
+        NameId name;
+        std::uint32_t binding;     // Enlace visible o no_binding
+    };
 
-    // Pila de ámbitos (el último es el actual)
-    TableStack scopes;
-}; 
\ No newline at end of file
+    // Ranura del nombre o nullptr si nunca se enlazó
+    Slot* find_slot(NameId name) noexcept;
+    const Slot* find_slot(NameId name) const noexcept;
+
+    // Ranura del nombre, creándola si no existe
+    Slot& insert_slot(NameId name) noexcept;
+
+    void grow() noexcept;
+
+    // Enlace visible de un nombre o nullptr
+    const Binding* visible_binding(NameId name) noexcept;
+
+    // Enlace que era visible cuando la tabla tenía solo los primeros count enlaces
+    const Binding* binding_before(NameId name, std::size_t count) const noexcept;
+
+    // Dueña de todos los símbolos de la tabla
+    Arena symbols;
+
+    std::vector<Slot> slots;
+    std::size_t used_slots;
+
+    // Enlaces en orden de creación (registro de deshacer)
+    std::vector<Binding> bindings;
+
+    // Primer enlace de cada ámbito abierto
+    std::vector<std::uint32_t> scope_starts;
+
+    ResolvePass pass;
+
+    // Tabla padre (solo lectura) y cuántos de sus enlaces ve esta tabla
+    const SymbolTable* parent;
+    std::size_t parent_bindings;
+};
@@ -0,0 +1,284 @@
+/*
+    Compilador Musical: Benchmark de la tabla de símbolos
+
+    Reproduce el patrón de ámbitos de cuerpos de funciones anidados: en cada
+    nivel se enlazan los parámetros y variables locales y se buscan nombres
+    declarados en niveles exteriores (incluido el global). Compara:
+      - la pila de unordered_map<string, shared_ptr> original (un mapa por ámbito)
+      - la tabla hash por NameId con símbolos en shared_ptr (cada búsqueda
+        copia el shared_ptr: un incremento y un decremento atómicos)
+      - SymbolTable buscando por cadena (se hashea una vez por búsqueda)
+      - SymbolTable buscando por NameId ya internado (símbolos en arena,
+        búsquedas que devuelven Symbol*)
+
+    Después de los ámbitos anidados se mide una fase de búsquedas repetidas
+    sobre el ámbito más profundo, donde el costo por búsqueda domina.
+
+    Uso: ./symbol_table_benchmark [profundidad] [repeticiones]
+*/
+
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "benchmark_support.hpp"
+#include "symbol_table.hpp"
+
+constexpr int names_per_scope = 8;
+constexpr int lookups_per_scope = 64;
+constexpr int repeated_lookup_rounds = 32;
+
+// Tabla anterior: un unordered_map por ámbito, búsqueda desde el más interno
+class LegacySymbolTable
+{
+public:
+    using TableType = std::unordered_map<std::string, std::shared_ptr<Symbol>>;
+
+    LegacySymbolTable() { enter_scope(); }
+
+    void enter_scope() { scopes.push_back(TableType()); }
+
+    void exit_scope() { scopes.pop_back(); }
+
+    bool bind(const std::string& name, std::shared_ptr<Symbol> symbol) {
+        if (scopes.back().count(name)) return false;
+        scopes.back()[name] = symbol;
+        return true;
+    }
+
+    std::shared_ptr<Symbol> lookup(const std::string& name) {
+        for (auto it = scopes.rbegin(); it != scopes.rend(); ++it) {
+            auto found = it->find(name);
+            if (found != it->end()) return found->second;
+        }
+        return nullptr;
+    }
+
+private:
+    std::vector<TableType> scopes;
+};
+
+// Tabla por NameId con la misma estructura que SymbolTable, pero dueña de los
+// símbolos mediante shared_ptr y devolviendo copias en cada búsqueda
+class SharedSymbolTable
+{
+public:
+    SharedSymbolTable() : slots(64, Slot{StringInterner::invalid_id, no_binding}), used_slots{0} { enter_scope(); }
+
+    void enter_scope() { scope_starts.push_back(static_cast<std::uint32_t>(bindings.size())); }
+
+    void exit_scope() {
+        const std::uint32_t start = scope_starts.back();
+        scope_starts.pop_back();
+        while (bindings.size() > start) {
+            find_slot(bindings.back().name)->binding = bindings.back().shadowed;
+            bindings.pop_back();
+        }
+    }
+
+    bool bind(NameId name, std::shared_ptr<Symbol> symbol) {
+        Slot& slot = insert_slot(name);
+        const std::uint32_t scope = static_cast<std::uint32_t>(scope_starts.size());
+        if (slot.binding != no_binding && bindings[slot.binding].scope == scope) return false;
+        bindings.push_back(Binding{name, scope, slot.binding, std::move(symbol)});
+        slot.binding = static_cast<std::uint32_t>(bindings.size() - 1);
+        return true;
+    }
+
+    std::shared_ptr<Symbol> lookup(NameId name) {
+        Slot* slot = find_slot(name);
+        if (slot == nullptr || slot->binding == no_binding) return nullptr;
+        return bindings[slot->binding].symbol;
+    }
+
+private:
+    static constexpr std::uint32_t no_binding = UINT32_MAX;
+
+    struct Binding
+    {
+        NameId name;
+        std::uint32_t scope;
+        std::uint32_t shadowed;
+        std::shared_ptr<Symbol> symbol;
+    };
+
+    struct Slot
+    {
+        NameId name;
+        std::uint32_t binding;
+    };
+
+    static std::size_t slot_index(NameId name, std::size_t mask) {
+        return (static_cast<std::uint64_t>(name) * 0x9E3779B97F4A7C15ull >> 32) & mask;
+    }
+
+    Slot* find_slot(NameId name) {
+        const std::size_t mask = slots.size() - 1;
+        for (std::size_t i = slot_index(name, mask); ; i = (i + 1) & mask) {
+            if (slots[i].name == name) return &slots[i];
+            if (slots[i].name == StringInterner::invalid_id) return nullptr;
+        }
+    }
+
+    Slot& insert_slot(NameId name) {
+        if ((used_slots + 1) * 10 > slots.size() * 7) {
+            std::vector<Slot> previous(slots.size() * 2, Slot{StringInterner::invalid_id, no_binding});
+            previous.swap(slots);
+            for (const Slot& slot : previous) {
+                if (slot.name == StringInterner::invalid_id) continue;
+                std::size_t i = slot_index(slot.name, slots.size() - 1);
+                while (slots[i].name != StringInterner::invalid_id) i = (i + 1) & (slots.size() - 1);
+                slots[i] = slot;
+            }
+        }
+        const std::size_t mask = slots.size() - 1;
+        for (std::size_t i = slot_index(name, mask); ; i = (i + 1) & mask) {
+            if (slots[i].name == name) return slots[i];
+            if (slots[i].name == StringInterner::invalid_id) {
+                slots[i].name = name;
+                ++used_slots;
+                return slots[i];
+            }
+        }
+    }
+
+    std::vector<Slot> slots;
+    std::size_t used_slots;
+    std::vector<Binding> bindings;
+    std::vector<std::uint32_t> scope_starts;
+};
+
+struct Workload
+{
+    // names[nivel][i]: nombres enlazados en cada nivel (0 = global)
+    std::vector<std::vector<std::string>> names;
+    // lookups[nivel][j]: nivel e índice del nombre buscado desde ese nivel
+    std::vector<std::vector<std::pair<int, int>>> lookups;
+};
+
+static Workload make_workload(int depth) {
+    Workload workload;
+    workload.names.resize(depth + 1);
+    workload.lookups.resize(depth + 1);
+
+    unsigned seed = 12345;
+    auto next = [&seed]() { seed = seed * 1103515245u + 12345u; return seed >> 8; };
+
+    for (int level = 0; level <= depth; ++level) {
+        for (int i = 0; i < names_per_scope; ++i) {
+            // Los nombres se repiten entre niveles para ejercitar el sombreado
+            workload.names[level].push_back(i % 2 == 0 ? "local_" + std::to_string(i) : "f" + std::to_string(level) + "_var_" + std::to_string(i));
+        }
+        for (int j = 0; j < lookups_per_scope; ++j) {
+            int target_level = next() % (level + 1);
+            workload.lookups[level].push_back({target_level, static_cast<int>(next() % names_per_scope)});
+        }
+    }
+    return workload;
+}
+
+template <typename Table, typename Key, typename Handle>
+static long run(Table& table, const std::vector<std::vector<Key>>& keys, const Workload& workload,
+                const Handle& symbol) {
+    const int depth = static_cast<int>(workload.names.size()) - 1;
+    long found = 0;
+
+    for (int i = 0; i < names_per_scope; ++i) {
+        table.bind(keys[0][i], symbol);
+    }
+    for (int level = 1; level <= depth; ++level) {
+        table.enter_scope();
+        for (int i = 0; i < names_per_scope; ++i) {
+            table.bind(keys[level][i], symbol);
+        }
+        for (const auto& lookup : workload.lookups[level]) {
+            found += table.lookup(keys[lookup.first][lookup.second]) != nullptr;
+        }
+    }
+    // Búsquedas repetidas desde el ámbito más profundo
+    for (int round = 0; round < repeated_lookup_rounds; ++round) {
+        for (const auto& lookup : workload.lookups[depth]) {
+            found += table.lookup(keys[lookup.first][lookup.second]) != nullptr;
+        }
+    }
+    for (int level = depth; level >= 1; --level) {
+        table.exit_scope();
+    }
+
+    return found;
+}
+
+static void print_row(const std::string& label, double ms, long checksum) {
+    print_label(label, 28);
+    print_ms(ms);
+    print_text("control " + std::to_string(checksum));
+    print_end();
+}
+
+int main(int argc, char** argv){
+    int depth = argc > 1 ? std::atoi(argv[1]) : 64;
+    int repetitions = argc > 2 ? std::atoi(argv[2]) : 2000;
+    if (depth <= 0 || repetitions <= 0) {
+        std::cerr << "Uso: " << argv[0] << " [profundidad] [repeticiones]" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "====== Benchmark de la tabla de símbolos (profundidad " << depth << ", "
+              << repetitions << " repeticiones) ======" << std::endl;
+
+    const Workload workload = make_workload(depth);
+    auto shared_symbol = std::make_shared<Symbol>(Symbol{nullptr, intern_name("simbolo")});
+
+    // Ids internados una sola vez en la tabla global, como los deja el lexer en el AST
+    std::vector<std::vector<NameId>> ids(workload.names.size());
+    for (std::size_t level = 0; level < workload.names.size(); ++level) {
+        for (const std::string& name : workload.names[level]) {
+            ids[level].push_back(intern_name(name));
+        }
+    }
+
+    long checksum = 0;
+    auto start = Clock::now();
+    for (int r = 0; r < repetitions; ++r) {
+        LegacySymbolTable table;
+        checksum += run(table, workload.names, workload, shared_symbol);
+    }
+    auto end = Clock::now();
+    print_row("pila de unordered_map", elapsed_ms(start, end), checksum);
+
+    checksum = 0;
+    start = Clock::now();
+    for (int r = 0; r < repetitions; ++r) {
+        SharedSymbolTable table;
+        checksum += run(table, ids, workload, shared_symbol);
+    }
+    end = Clock::now();
+    print_row("tabla NameId + shared_ptr", elapsed_ms(start, end), checksum);
+
+    checksum = 0;
+    start = Clock::now();
+    for (int r = 0; r < repetitions; ++r) {
+        SymbolTable table;
+        Symbol* symbol = table.make_symbol(nullptr, "simbolo");
+        checksum += run(table, workload.names, workload, symbol);
+    }
+    end = Clock::now();
+    print_row("SymbolTable (cadena)", elapsed_ms(start, end), checksum);
+
+    checksum = 0;
+    start = Clock::now();
+    for (int r = 0; r < repetitions; ++r) {
+        SymbolTable table;
+        Symbol* symbol = table.make_symbol(nullptr, "simbolo");
+        checksum += run(table, ids, workload, symbol);
+    }
+    end = Clock::now();
+    print_row("SymbolTable (NameId)", elapsed_ms(start, end), checksum);
+
+    return EXIT_SUCCESS;
+}
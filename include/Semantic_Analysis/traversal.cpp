@@ -0,0 +1,557 @@
+#include "traversal.hpp"
+
+#include "datatype.hpp"
+#include "symbol_table.hpp"
+#include "type_context.hpp"
+
+bool is_composite(NodeKind kind) noexcept{
+    switch (kind){
+        case NodeKind::VariableDeclaration:
+        case NodeKind::FunctionDeclaration:
+        case NodeKind::ArrayAccessExpression:
+        case NodeKind::AssignmentExpression:
+        case NodeKind::CallExpression:
+        case NodeKind::ArgExpression:
+        case NodeKind::SharpExpression:
+        case NodeKind::DeclarationStatement:
+        case NodeKind::ExpressionStatement:
+        case NodeKind::PrintStatement:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// Resolución de nombres
+
+class ResolveNameVisitor
+{
+public:
+    ResolveNameVisitor(SymbolTable& _symbol_table, SymbolTable::ResolvePass& _pass) noexcept
+        : symbol_table(_symbol_table), pass(_pass)
+    {
+    }
+
+    Visit enter(ASTNodeInterface* node) noexcept{
+        switch (node->get_kind()){
+            case NodeKind::VariableDeclaration:
+                return cast<VariableDeclaration>(node)->get_type()->resolve_name(symbol_table) ? Visit::Children : Visit::Stop;
+            case NodeKind::FunctionDeclaration:
+                return enter_function(cast<FunctionDeclaration>(node));
+            default:
+                if (is_composite(node->get_kind())){
+                    return Visit::Children;
+                }
+                return node->resolve_name(symbol_table) ? Visit::Skip : Visit::Stop;
+        }
+    }
+
+    bool leave(ASTNodeInterface* node) noexcept{
+        if (auto variable = dyn_cast<VariableDeclaration>(node)){
+            // El nombre se enlaza después de resolver el inicializador
+            Symbol* symbol = symbol_table.make_symbol(variable->get_type(), variable->get_name_id());
+            return symbol_table.bind(variable->get_name_id(), symbol);
+        }
+        cancel(node);
+        return true;
+    }
+
+    void cancel(ASTNodeInterface* node) noexcept{
+        if (isa<FunctionDeclaration>(node)){
+            symbol_table.exit_scope();
+            pass.in_function = false;
+        }
+    }
+
+    template <typename Function>
+    void children(ASTNodeInterface* node, Function&& function) noexcept{
+        for_each_child(node, function);
+    }
+
+private:
+    Visit enter_function(FunctionDeclaration* function) noexcept{
+        // Las funciones anidadas no se resuelven mientras se resuelve otra
+        if (pass.in_function){
+            return Visit::Skip;
+        }
+
+        auto type = cast<FunctionDatatype>(function->get_type());
+        if (!type->resolve_name(symbol_table)){
+            return Visit::Stop;
+        }
+
+        Symbol* symbol = symbol_table.make_symbol(type, function->get_name_id());
+        if (!symbol_table.bind(function->get_name_id(), symbol)){
+            return Visit::Stop;
+        }
+
+        symbol_table.enter_scope();
+        pass.in_function = true;
+
+        if (!resolve_name_param_list(type->get_parameters(), symbol_table)){
+            cancel(function);
+            return Visit::Stop;
+        }
+
+        return Visit::Children;
+    }
+
+    SymbolTable& symbol_table;
+    SymbolTable::ResolvePass& pass;
+};
+
+bool resolve_name_tree(ASTNodeInterface* root, SymbolTable& symbol_table) noexcept{
+    ResolveNameVisitor visitor{symbol_table, symbol_table.resolve_pass()};
+    return traverse(root, visitor);
+}
+
+// Comprobación de tipos
+//
+// Cada nodo deja un resultado en la pila de resultados; un nodo compuesto
+// consume los de sus hijos al salir. Un hijo con error hace fallar a todos sus
+// ancestros, así que el primer error aborta el recorrido.
+
+using TypeResult = std::pair<bool, Datatype*>;
+
+class TypeCheckVisitor
+{
+public:
+    Visit enter(const ASTNodeInterface* node) noexcept{
+        if (!is_composite(node->get_kind())){
+            TypeResult result = node->type_check();
+            if (!result.first){
+                return Visit::Stop;
+            }
+            results.items.push_back(result);
+            return Visit::Skip;
+        }
+
+        marks.items.push_back(results.items.size());
+        return Visit::Children;
+    }
+
+    bool leave(const ASTNodeInterface* node) noexcept{
+        const std::size_t mark = marks.items.back();
+        marks.items.pop_back();
+
+        TypeResult result = combine(node, results.items.data() + mark);
+        results.items.resize(mark);
+        if (!result.first){
+            return false;
+        }
+        results.items.push_back(result);
+        return true;
+    }
+
+    void cancel(const ASTNodeInterface*) noexcept{
+    }
+
+    template <typename Function>
+    void children(const ASTNodeInterface* node, Function&& function) noexcept{
+        // Una llamada necesita el tipo de cada argumento, no el de la lista
+        if (auto call = dyn_cast<CallExpression>(node)){
+            function(call->get_function());
+            const Expression* current = call->get_arguments();
+            while (auto arg = dyn_cast<ArgExpression>(current)){
+                function(arg->get_value());
+                current = arg->get_next();
+            }
+            if (current != nullptr){
+                function(current);
+            }
+            return;
+        }
+        for_each_child(node, function);
+    }
+
+    TypeResult result() const noexcept{
+        return results.items.back();
+    }
+
+private:
+    static TypeResult combine(const ASTNodeInterface* node, const TypeResult* child) noexcept{
+        const TypeResult failure{false, nullptr};
+
+        switch (node->get_kind()){
+            case NodeKind::VariableDeclaration: {
+                auto variable = cast<VariableDeclaration>(node);
+                Datatype* type = variable->get_canonical_type();
+                // Verificando que el tipo del inicializador sea compatible con el tipo declarado
+                if (variable->get_initializer() != nullptr && child[0].second != nullptr && child[0].second != type){
+                    return failure;
+                }
+                return {true, type};
+            }
+            case NodeKind::FunctionDeclaration:
+                // Los errores del cuerpo ya abortaron el recorrido
+                return {true, cast<FunctionDeclaration>(node)->get_canonical_type()};
+            case NodeKind::ArrayAccessExpression: {
+                // Verificar que array sea de tipo array y el índice, entero
+                auto array_datatype = dyn_cast<ArrayDatatype>(child[0].second);
+                if (array_datatype == nullptr || child[1].second != TypeContext::get<IntegerDatatype>()){
+                    return failure;
+                }
+                // El tipo del resultado es el tipo interno del array (ya canónico)
+                return {true, array_datatype->get_inner_datatype()};
+            }
+            case NodeKind::AssignmentExpression:
+                // Los tipos canónicos se comparan por puntero
+                if (child[0].second == nullptr || child[0].second != child[1].second){
+                    return failure;
+                }
+                return child[1];
+            case NodeKind::CallExpression:
+                return combine_call(cast<CallExpression>(node), child);
+            case NodeKind::ArgExpression:
+                return child[0];
+            case NodeKind::SharpExpression:
+                // Verificar que el operando sea una nota musical
+                if (child[0].second != nullptr && child[0].second != TypeContext::get<NoteDatatype>()){
+                    return failure;
+                }
+                return child[0];
+            case NodeKind::DeclarationStatement:
+                return child[0];
+            default:
+                return {true, nullptr};
+        }
+    }
+
+    // child[0] es la función y los siguientes, los argumentos en orden
+    static TypeResult combine_call(const CallExpression* call, const TypeResult* child) noexcept{
+        const TypeResult failure{false, nullptr};
+
+        auto function_type = dyn_cast<FunctionDatatype>(child[0].second);
+        if (function_type == nullptr){
+            return failure;
+        }
+
+        // Verificar que el número y tipos de argumentos coincidan con los parámetros
+        const Expression* current = call->get_arguments();
+        const TypeResult* arg_type = child + 1;
+        for (const auto& param : function_type->get_parameters()){
+            auto arg = dyn_cast<ArgExpression>(current);
+            if (arg == nullptr){
+                return failure;
+            }
+
+            // Los parámetros de un tipo canónico también son canónicos
+            if (arg_type->second == nullptr || arg_type->second != param.second){
+                return failure;
+            }
+
+            current = arg->get_next();
+            ++arg_type;
+        }
+
+        // Verificar que no sobren argumentos
+        if (current != nullptr){
+            return failure;
+        }
+
+        return {true, function_type->get_return_type()};
+    }
+
+    ScratchVector<TypeResult> results;
+    ScratchVector<std::size_t> marks;
+};
+
+std::pair<bool, Datatype*> type_check_tree(const ASTNodeInterface* root) noexcept{
+    TypeCheckVisitor visitor;
+    if (!traverse(root, visitor)){
+        return std::make_pair(false, nullptr);
+    }
+    return visitor.result();
+}
+
+// Sustitución de un nodo
+//
+// Como la comprobación de tipos: cada nodo deja en la pila su versión nueva.
+// Un nodo compuesto cuyos hijos no cambiaron deja el mismo puntero, sin
+// referencia propia; si alguno cambió se construye de nuevo con esos hijos y
+// comparte (copy()) los que siguen igual y su tipo.
+
+class ReplaceVisitor
+{
+public:
+    ReplaceVisitor(const ASTNodeInterface* _target, ASTNodeInterface* _replacement) noexcept
+        : target(_target), replacement(_replacement)
+    {
+    }
+
+    Visit enter(const ASTNodeInterface* node) noexcept{
+        if (node == target){
+            results.items.push_back(Result{replacement->copy(), true});
+            return Visit::Skip;
+        }
+        if (!is_composite(node->get_kind())){
+            results.items.push_back(Result{const_cast<ASTNodeInterface*>(node), false});
+            return Visit::Skip;
+        }
+
+        marks.items.push_back(results.items.size());
+        return Visit::Children;
+    }
+
+    bool leave(const ASTNodeInterface* node) noexcept{
+        const std::size_t mark = marks.items.back();
+        marks.items.pop_back();
+
+        Result* child = results.items.data() + mark;
+        const std::size_t count = results.items.size() - mark;
+        Result result{const_cast<ASTNodeInterface*>(node), false};
+        if (std::any_of(child, child + count, [](const Result& entry) { return entry.created; })){
+            operands.items.clear();
+            for (std::size_t i = 0; i < count; ++i){
+                operands.items.push_back(child[i].created ? child[i].node : child[i].node->copy());
+            }
+            result = Result{build(node, operands.items.data(), count), true};
+        }
+        results.items.resize(mark);
+        results.items.push_back(result);
+        return true;
+    }
+
+    void cancel(const ASTNodeInterface*) noexcept{
+    }
+
+    template <typename Function>
+    void children(const ASTNodeInterface* node, Function&& function) noexcept{
+        for_each_child(node, function);
+    }
+
+    ASTNodeInterface* result() const noexcept{
+        const Result& root = results.items.back();
+        return root.created ? root.node : root.node->copy();
+    }
+
+private:
+    struct Result
+    {
+        ASTNodeInterface* node;
+        bool created;   // Nodo nuevo (o replacement): la referencia es nuestra
+    };
+
+    static ASTNodeInterface* build(const ASTNodeInterface* node, ASTNodeInterface** child, std::size_t count) noexcept{
+        auto expression = [child, count](std::size_t index) {
+            return index < count ? cast<Expression>(child[index]) : nullptr;
+        };
+
+        switch (node->get_kind()){
+            case NodeKind::VariableDeclaration: {
+                auto variable = cast<VariableDeclaration>(node);
+                return new VariableDeclaration(
+                    variable->get_name_id(),
+                    cast<Datatype>(variable->get_type()->copy()),
+                    expression(0)
+                );
+            }
+            case NodeKind::FunctionDeclaration: {
+                auto function = cast<FunctionDeclaration>(node);
+                Body body;
+                auto tail = body.before_begin();
+                for (std::size_t i = 0; i < count; ++i){
+                    tail = body.insert_after(tail, cast<Statement>(child[i]));
+                }
+                return new FunctionDeclaration(
+                    function->get_name_id(),
+                    cast<FunctionDatatype>(function->get_type()->copy()),
+                    body
+                );
+            }
+            case NodeKind::ArrayAccessExpression:
+                return new ArrayAccessExpression(expression(0), expression(1));
+            case NodeKind::AssignmentExpression:
+                return new AssignmentExpression(expression(0), expression(1));
+            case NodeKind::CallExpression:
+                return new CallExpression(expression(0), expression(1));
+            case NodeKind::ArgExpression:
+                return new ArgExpression(expression(0), expression(1));
+            case NodeKind::SharpExpression:
+                return new SharpExpression(expression(0));
+            case NodeKind::DeclarationStatement:
+                return new DeclarationStatement(cast<Declaration>(child[0]));
+            case NodeKind::ExpressionStatement:
+                return new ExpressionStatement(expression(0));
+            case NodeKind::PrintStatement:
+                return new PrintStatement(expression(0));
+            default:
+                return nullptr;
+        }
+    }
+
+    const ASTNodeInterface* target;
+    ASTNodeInterface* replacement;
+    ScratchVector<Result> results;
+    ScratchVector<std::size_t> marks;
+    ScratchVector<ASTNodeInterface*> operands;
+};
+
+ASTNodeInterface* replace_node(const ASTNodeInterface* root, const ASTNodeInterface* target,
+                               ASTNodeInterface* replacement) noexcept{
+    ReplaceVisitor visitor{target, replacement};
+    traverse(root, visitor);
+    release(replacement);
+    return visitor.result();
+}
+
+// Igualdad
+//
+// Se recorren los dos árboles a la vez: cada nodo del recorrido es un par
+// (nodo, nodo del otro árbol). Antes de bajar se comparan el tipo de nodo, los
+// campos propios y la cantidad de hijos.
+
+using NodePair = std::pair<const ASTNodeInterface*, ASTNodeInterface*>;
+
+class EqualVisitor
+{
+public:
+    Visit enter(NodePair pair) noexcept{
+        const ASTNodeInterface* node = pair.first;
+        ASTNodeInterface* other = pair.second;
+        if (node == other){
+            return Visit::Skip;
+        }
+        if (other == nullptr || node->get_kind() != other->get_kind() || node->hash() != other->hash()){
+            return Visit::Stop;
+        }
+
+        if (!is_composite(node->get_kind())){
+            return node->equal(other) ? Visit::Skip : Visit::Stop;
+        }
+
+        return same_shape(node, other) ? Visit::Children : Visit::Stop;
+    }
+
+    bool leave(NodePair) noexcept{
+        return true;
+    }
+
+    void cancel(NodePair) noexcept{
+    }
+
+    template <typename Function>
+    void children(NodePair pair, Function&& function) noexcept{
+        // Los cuerpos de funciones se recorren en paralelo
+        if (auto node = dyn_cast<FunctionDeclaration>(pair.first)){
+            auto other = cast<FunctionDeclaration>(pair.second);
+            auto it = other->get_body().begin();
+            for (Statement* statement : node->get_body()){
+                function(NodePair{statement, *it++});
+            }
+            return;
+        }
+
+        // El resto tiene a lo sumo dos hijos
+        ASTNodeInterface* other_children[2] = {nullptr, nullptr};
+        std::size_t count = 0;
+        for_each_child(pair.second, [&other_children, &count](ASTNodeInterface* child) {
+            other_children[count++] = child;
+        });
+
+        std::size_t index = 0;
+        for_each_child(pair.first, [&function, &other_children, &index](ASTNodeInterface* child) {
+            function(NodePair{child, other_children[index++]});
+        });
+    }
+
+private:
+    static bool same_shape(const ASTNodeInterface* node, const ASTNodeInterface* other) noexcept{
+        switch (node->get_kind()){
+            case NodeKind::VariableDeclaration: {
+                auto variable = cast<VariableDeclaration>(node);
+                auto other_variable = cast<VariableDeclaration>(other);
+                return variable->get_name_id() == other_variable->get_name_id() &&
+                       variable->get_type()->equal(other_variable->get_type()) &&
+                       (variable->get_initializer() == nullptr) == (other_variable->get_initializer() == nullptr);
+            }
+            case NodeKind::FunctionDeclaration: {
+                auto function = cast<FunctionDeclaration>(node);
+                auto other_function = cast<FunctionDeclaration>(other);
+                return function->get_name_id() == other_function->get_name_id() &&
+                       function->get_type()->equal(other_function->get_type()) &&
+                       std::distance(function->get_body().begin(), function->get_body().end()) ==
+                       std::distance(other_function->get_body().begin(), other_function->get_body().end());
+            }
+            case NodeKind::CallExpression:
+                return (cast<CallExpression>(node)->get_arguments() == nullptr) ==
+                       (cast<CallExpression>(other)->get_arguments() == nullptr);
+            case NodeKind::ArgExpression:
+                return (cast<ArgExpression>(node)->get_next() == nullptr) ==
+                       (cast<ArgExpression>(other)->get_next() == nullptr);
+            default:
+                return true;
+        }
+    }
+};
+
+bool equal_tree(const ASTNodeInterface* node, ASTNodeInterface* other) noexcept{
+    EqualVisitor visitor;
+    return traverse(NodePair{node, other}, visitor);
+}
+
+// Liberación
+//
+// Cada nodo pierde la referencia de su padre al entrar; si alguien más lo
+// comparte no se baja por él. Las hojas se liberan al entrar y los nodos
+// compuestos al salir, cuando ya no quedan hijos que los referencien. La raíz
+// no se libera: la llama su propio destroy(), que después anula sus punteros.
+
+class DestroyVisitor
+{
+public:
+    explicit DestroyVisitor(ASTNodeInterface* _root) noexcept
+        : root(_root)
+    {
+    }
+
+    Visit enter(ASTNodeInterface* node) noexcept{
+        if (node == root){
+            return Visit::Children;
+        }
+        if (!node->drop_reference()){
+            return Visit::Skip;
+        }
+        if (!is_composite(node->get_kind())){
+            node->destroy();
+            delete node;
+            return Visit::Skip;
+        }
+        return Visit::Children;
+    }
+
+    bool leave(ASTNodeInterface* node) noexcept{
+        if (node == root){
+            return true;
+        }
+
+        // Los tipos son hojas propias de las declaraciones
+        Datatype* type = nullptr;
+        if (auto variable = dyn_cast<VariableDeclaration>(node)){
+            type = variable->get_type();
+        }
+        else if (auto function = dyn_cast<FunctionDeclaration>(node)){
+            type = function->get_type();
+        }
+        release(type);
+
+        delete node;
+        return true;
+    }
+
+    void cancel(ASTNodeInterface*) noexcept{
+    }
+
+    template <typename Function>
+    void children(ASTNodeInterface* node, Function&& function) noexcept{
+        for_each_child(node, function);
+    }
+
+private:
+    ASTNodeInterface* root;
+};
+
+void destroy_children(ASTNodeInterface* root) noexcept{
+    DestroyVisitor visitor{root};
+    traverse(root, visitor);
+}
@@ -0,0 +1,242 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "ast_node_interface.hpp"
+#include "declaration.hpp"
+#include "expression.hpp"
+#include "statement.hpp"
+
+// Motor de recorrido del AST con pila explícita.
+//
+// resolve_name, type_check, equal y destroy de los nodos compuestos
+// (los que tienen sentencias o expresiones hijas) recurren por sus métodos
+// virtuales mientras la recursión nativa sea poco profunda, que es el camino
+// más rápido. Al pasar de max_native_depth niveles delegan el subárbol en
+// visitantes sobre este motor: desde ahí la profundidad solo hace crecer
+// vectores en el heap y la pila nativa queda acotada. Las hojas conservan su
+// propia implementación y el motor la llama directamente. Los Datatype también
+// se tratan como hojas: su anidamiento está acotado por lo que se escribe en
+// una declaración. replace_node (ast_node_interface.hpp) usa siempre el motor.
+
+// Qué hacer con un nodo al entrar en él
+enum class Visit : std::uint8_t
+{
+    Children,   // Visitar los hijos y después llamar a leave()
+    Skip,       // No visitar los hijos ni llamar a leave()
+    Stop        // Abortar el recorrido
+};
+
+// Niveles de recursión nativa por hilo antes de pasar al motor
+constexpr std::uint32_t max_native_depth = 64;
+
+// Cuenta un nivel de recursión nativa mientras vive
+class NativeDepthGuard
+{
+public:
+    NativeDepthGuard() noexcept
+    {
+        ++depth();
+    }
+
+    ~NativeDepthGuard() noexcept
+    {
+        --depth();
+    }
+
+    NativeDepthGuard(const NativeDepthGuard&) = delete;
+
+    NativeDepthGuard& operator=(const NativeDepthGuard&) = delete;
+
+    // El nodo debe seguir con el motor en lugar de recurrir
+    bool exhausted() const noexcept
+    {
+        return depth() > max_native_depth;
+    }
+
+private:
+    static std::uint32_t& depth() noexcept
+    {
+        thread_local std::uint32_t value = 0;
+        return value;
+    }
+};
+
+// Nodo cuyos hijos recorre el motor
+bool is_composite(NodeKind kind) noexcept;
+
+// Hijos directos de un nodo compuesto en orden de evaluación (se omiten los nulos)
+template <typename Function>
+void for_each_child(const ASTNodeInterface* node, Function&& function) noexcept
+{
+    auto visit = [&function](ASTNodeInterface* child) {
+        if (child != nullptr)
+        {
+            function(child);
+        }
+    };
+
+    switch (node->get_kind())
+    {
+        case NodeKind::VariableDeclaration:
+            visit(static_cast<const VariableDeclaration*>(node)->get_initializer());
+            break;
+        case NodeKind::FunctionDeclaration:
+            for (Statement* statement : static_cast<const FunctionDeclaration*>(node)->get_body())
+            {
+                visit(statement);
+            }
+            break;
+        case NodeKind::ArrayAccessExpression:
+            visit(static_cast<const ArrayAccessExpression*>(node)->get_array());
+            visit(static_cast<const ArrayAccessExpression*>(node)->get_index());
+            break;
+        case NodeKind::AssignmentExpression:
+            visit(static_cast<const AssignmentExpression*>(node)->get_target());
+            visit(static_cast<const AssignmentExpression*>(node)->get_value());
+            break;
+        case NodeKind::CallExpression:
+            visit(static_cast<const CallExpression*>(node)->get_function());
+            visit(static_cast<const CallExpression*>(node)->get_arguments());
+            break;
+        case NodeKind::ArgExpression:
+            visit(static_cast<const ArgExpression*>(node)->get_value());
+            visit(static_cast<const ArgExpression*>(node)->get_next());
+            break;
+        case NodeKind::SharpExpression:
+            visit(static_cast<const UnaryExpression*>(node)->get_operand());
+            break;
+        case NodeKind::DeclarationStatement:
+            visit(static_cast<const DeclarationStatement*>(node)->get_declaration());
+            break;
+        case NodeKind::ExpressionStatement:
+            visit(static_cast<const ExpressionStatement*>(node)->get_expression());
+            break;
+        case NodeKind::PrintStatement:
+            visit(static_cast<const PrintStatement*>(node)->get_value());
+            break;
+        default:
+            break;
+    }
+}
+
+// Vector de trabajo que reutiliza la capacidad del recorrido anterior del mismo
+// hilo. Un recorrido anidado encuentra el de reserva vacío y usa uno propio.
+template <typename Type>
+class ScratchVector
+{
+public:
+    ScratchVector() noexcept
+    {
+        items.swap(spare());
+    }
+
+    ~ScratchVector() noexcept
+    {
+        items.clear();
+        items.swap(spare());
+    }
+
+    ScratchVector(const ScratchVector&) = delete;
+
+    ScratchVector& operator=(const ScratchVector&) = delete;
+
+    std::vector<Type> items;
+
+private:
+    static std::vector<Type>& spare() noexcept
+    {
+        thread_local std::vector<Type> vector;
+        return vector;
+    }
+};
+
+// Recorrido en profundidad, de izquierda a derecha, con pila explícita.
+//
+// El visitante provee:
+//   Visit enter(Node)                    al llegar al nodo
+//   bool leave(Node)                     después de sus hijos; false aborta
+//   void cancel(Node)                    para cada nodo pendiente de leave() al abortar
+//   void children(Node, Function&&)      llama a la función con cada hijo
+//
+// Devuelve false si el recorrido se abortó.
+template <typename Node, typename Visitor>
+bool traverse(Node root, Visitor& visitor) noexcept
+{
+    // Nodo abierto: se sale de él cuando la pila vuelve a la altura que tenía
+    // antes de apilar sus hijos. Llevarlos aparte, en lugar de marcar las
+    // entradas de la pila como "entrar" o "salir", evita un salto impredecible
+    // por cada nodo.
+    struct Open
+    {
+        Node node;
+        std::size_t height;
+    };
+
+    ScratchVector<Node> pending_scratch;
+    ScratchVector<Open> open_scratch;
+    std::vector<Node>& pending = pending_scratch.items;
+    std::vector<Open>& open = open_scratch.items;
+    pending.push_back(root);
+
+    auto abort = [&open, &visitor]() {
+        while (!open.empty())
+        {
+            visitor.cancel(open.back().node);
+            open.pop_back();
+        }
+        return false;
+    };
+
+    for (;;)
+    {
+        while (!open.empty() && open.back().height == pending.size())
+        {
+            const Node node = open.back().node;
+            open.pop_back();
+            if (!visitor.leave(node))
+            {
+                return abort();
+            }
+        }
+
+        if (pending.empty())
+        {
+            return true;
+        }
+
+        const Node node = pending.back();
+        pending.pop_back();
+
+        Visit visit = visitor.enter(node);
+        if (visit == Visit::Stop)
+        {
+            return abort();
+        }
+        if (visit == Visit::Skip)
+        {
+            continue;
+        }
+
+        const std::size_t height = pending.size();
+        open.push_back(Open{node, height});
+        visitor.children(node, [&pending](Node child) {
+            pending.push_back(child);
+        });
+        // Los hijos se apilan en orden y se invierten para salir de izquierda a derecha
+        std::reverse(pending.begin() + height, pending.end());
+    }
+}
+
+// Operaciones de los nodos compuestos, implementadas sobre el motor
+bool resolve_name_tree(ASTNodeInterface* root, SymbolTable& symbol_table) noexcept;
+
+std::pair<bool, Datatype*> type_check_tree(const ASTNodeInterface* root) noexcept;
+
+bool equal_tree(const ASTNodeInterface* node, ASTNodeInterface* other) noexcept;
+
+// Liberar (destroy + delete) todos los descendientes de root, sin tocar root
+void destroy_children(ASTNodeInterface* root) noexcept;
@@ -0,0 +1,222 @@
+/*
+    Compilador Musical: Benchmark del recorrido de árboles del AST
+
+    Mide resolve_name, type_check, copy, equal y destroy sobre un programa con
+    funciones cuyos cuerpos mezclan declaraciones, sostenidos anidados y
+    llamadas con listas de argumentos. Como copy_body comparte las sentencias,
+    equal compara la copia con otro programa igual construido por separado.
+    Después construye árboles muy profundos
+    (cadenas de sostenidos, listas de argumentos y funciones anidadas) para
+    comprobar que las cinco operaciones terminan sin desbordar la pila.
+
+    Uso: ./traversal_benchmark [funciones] [sentencias_por_función] [repeticiones] [profundidad]
+*/
+
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "benchmark_support.hpp"
+#include "datatype.hpp"
+#include "declaration.hpp"
+#include "expression.hpp"
+#include "statement.hpp"
+#include "symbol_table.hpp"
+
+static void print_row(const std::string& label, double ms, bool success) {
+    print_label(label, 24);
+    print_ms(ms);
+    print_verdict(success);
+}
+
+static Expression* sharp_chain(Expression* operand, int depth) {
+    for (int i = 0; i < depth; ++i) {
+        operand = new SharpExpression{operand};
+    }
+    return operand;
+}
+
+static Expression* argument_list(NameId name, int count) {
+    Expression* arguments = nullptr;
+    for (int i = 0; i < count; ++i) {
+        arguments = new ArgExpression{new NameExpression{name}, arguments};
+    }
+    return arguments;
+}
+
+static Expression* note_list(NameId pitch, int count) {
+    Expression* arguments = nullptr;
+    for (int i = 0; i < count; ++i) {
+        arguments = new ArgExpression{new NoteExpression{pitch, i % 9, 1 + i % 4}, arguments};
+    }
+    return arguments;
+}
+
+// Programa: por cada función, una nota global y una función cuyo cuerpo usa
+// esas notas. Todas las sentencias resuelven nombres y pasan la comprobación
+// de tipos, así que ninguna operación corta el recorrido antes de tiempo.
+static Body make_program(int function_count, int statements_per_function) {
+    std::vector<NameId> notes;
+    for (int i = 0; i < function_count; ++i) {
+        notes.push_back(intern_name("nota" + std::to_string(i)));
+    }
+    const NameId negra = intern_name("Negra");
+    const NameId pitch = intern_name("C");
+    const NameId local = intern_name("local");
+
+    Body program;
+    auto tail = program.before_begin();
+    for (int f = 0; f < function_count; ++f) {
+        tail = program.insert_after(tail, new DeclarationStatement{new NoteDeclaration{notes[f], 'C', 4, negra}});
+
+        Body body;
+        auto body_tail = body.before_begin();
+        for (int s = 0; s < statements_per_function; ++s) {
+            Statement* statement = nullptr;
+            switch (s % 5) {
+                case 0:
+                    statement = new DeclarationStatement{new VariableDeclaration{
+                        intern_name(std::string("v") + std::to_string(s)), new IntegerDatatype{}, new IntExpression{s}}};
+                    break;
+                case 1:
+                    statement = new ExpressionStatement{sharp_chain(new NoteExpression{pitch, 4, 1}, 4)};
+                    break;
+                case 2:
+                    statement = new ExpressionStatement{sharp_chain(new NameExpression{notes[s % (f + 1)]}, 2)};
+                    break;
+                case 3:
+                    statement = new ExpressionStatement{note_list(pitch, 1 + s % 6)};
+                    break;
+                default:
+                    statement = new PrintStatement{new StrExpression{"// compás"}};
+                    break;
+            }
+            body_tail = body.insert_after(body_tail, statement);
+        }
+
+        ParamList params;
+        params.push_front({local, new NoteDatatype{}});
+        tail = program.insert_after(tail, new DeclarationStatement{new FunctionDeclaration{
+            intern_name("funcion" + std::to_string(f)), new FunctionDatatype{new VoidDatatype{}, params}, body}});
+    }
+    return program;
+}
+
+// Funciones anidadas: cada cuerpo contiene una nota y la función del nivel siguiente
+static Statement* nested_functions(int depth) {
+    const NameId negra = intern_name("Negra");
+    const NameId note = intern_name("nota");
+    Statement* inner = new ExpressionStatement{new NameExpression{note}};
+    for (int level = 0; level < depth; ++level) {
+        Body body;
+        body.push_front(inner);
+        body.push_front(new DeclarationStatement{new NoteDeclaration{note, 'C', 4, negra}});
+        inner = new DeclarationStatement{new FunctionDeclaration{
+            intern_name("f" + std::to_string(level % 16)), new FunctionDatatype{new VoidDatatype{}, {}}, body}};
+    }
+    return inner;
+}
+
+// Las cinco operaciones sobre un árbol profundo, construido dos veces para que
+// equal recorra dos árboles distintos; el tiempo incluye la liberación
+template <typename Build>
+static bool run_deep(const std::string& label, Build&& build) {
+    Body program = build();
+    Body other = build();
+    auto start = Clock::now();
+    SymbolTable table;
+    bool resolved = resolve_name_body(program, table);
+    body_type_check(program);
+    Body copy = copy_body(program);
+    bool equal = equal_body(copy, other);
+    destroy_body(copy);
+    destroy_body(other);
+    destroy_body(program);
+    auto end = Clock::now();
+    print_row(label, elapsed_ms(start, end), resolved && equal);
+    return resolved && equal;
+}
+
+int main(int argc, char** argv){
+    int function_count = argc > 1 ? std::atoi(argv[1]) : 200;
+    int statements_per_function = argc > 2 ? std::atoi(argv[2]) : 50;
+    int repetitions = argc > 3 ? std::atoi(argv[3]) : 50;
+    int depth = argc > 4 ? std::atoi(argv[4]) : 100000;
+    if (function_count <= 0 || statements_per_function <= 0 || repetitions <= 0 || depth <= 0) {
+        std::cerr << "Uso: " << argv[0] << " [funciones] [sentencias_por_función] [repeticiones] [profundidad]" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "====== Benchmark del recorrido del AST (" << function_count << " funciones x "
+              << statements_per_function << " sentencias, " << repetitions << " repeticiones) ======" << std::endl;
+
+    Body program = make_program(function_count, statements_per_function);
+    Body other = make_program(function_count, statements_per_function);
+    bool success = true;
+
+    auto start = Clock::now();
+    for (int r = 0; r < repetitions; ++r) {
+        SymbolTable table;
+        success = resolve_name_body(program, table) && success;
+    }
+    auto end = Clock::now();
+    print_row("resolve_name", elapsed_ms(start, end), success);
+
+    long checked = 0;
+    start = Clock::now();
+    for (int r = 0; r < repetitions; ++r) {
+        checked += body_type_check(program).first;
+    }
+    end = Clock::now();
+    print_row("type_check", elapsed_ms(start, end), checked == repetitions);
+
+    double copy_ms = 0.0, equal_ms = 0.0, destroy_ms = 0.0;
+    success = true;
+    for (int r = 0; r < repetitions; ++r) {
+        start = Clock::now();
+        Body copy = copy_body(program);
+        auto copied = Clock::now();
+        success = equal_body(copy, other) && success;
+        auto compared = Clock::now();
+        destroy_body(copy);
+        end = Clock::now();
+
+        copy_ms += elapsed_ms(start, copied);
+        equal_ms += elapsed_ms(copied, compared);
+        destroy_ms += elapsed_ms(compared, end);
+    }
+    print_row("copy", copy_ms, success);
+    print_row("equal", equal_ms, success);
+    print_row("destroy", destroy_ms, success);
+    destroy_body(program);
+    destroy_body(other);
+
+    std::cout << std::endl << "====== Árboles profundos (profundidad " << depth << ") ======" << std::endl;
+
+    const NameId note = intern_name("nota");
+    const NameId negra = intern_name("Negra");
+
+    success = run_deep("sostenidos anidados", [&]() {
+        Body sharps;
+        sharps.push_front(new ExpressionStatement{sharp_chain(new NameExpression{note}, depth)});
+        sharps.push_front(new DeclarationStatement{new NoteDeclaration{note, 'C', 4, negra}});
+        return sharps;
+    }) && success;
+
+    success = run_deep("lista de argumentos", [&]() {
+        Body call;
+        call.push_front(new ExpressionStatement{new CallExpression{new NameExpression{note}, argument_list(note, depth)}});
+        call.push_front(new DeclarationStatement{new NoteDeclaration{note, 'C', 4, negra}});
+        return call;
+    }) && success;
+
+    success = run_deep("funciones anidadas", [&]() {
+        Body functions;
+        functions.push_front(nested_functions(depth));
+        return functions;
+    }) && success;
+
+    return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,104 @@
+#include "type_context.hpp"
+
+#include <functional>
+
+TypeContext& TypeContext::instance() noexcept{
+    static TypeContext context;
+    return context;
+}
+
+TypeContext::~TypeContext() noexcept
+{
+    // Los tipos internos son canónicos y pertenecen al contexto: no se llama a
+    // destroy() para no liberar los singletons compartidos
+    for (auto& entry : array_types){
+        delete entry.second;
+    }
+
+    for (auto& entry : function_types){
+        delete entry.second;
+    }
+}
+
+Datatype* TypeContext::get_array(Datatype* inner_datatype) noexcept{
+    std::lock_guard<std::mutex> lock{mutex};
+
+    auto it = array_types.find(inner_datatype);
+    if (it != array_types.end()){
+        return it->second;
+    }
+
+    auto array_type = new ArrayDatatype(inner_datatype);
+    array_types.emplace(inner_datatype, array_type);
+    return array_type;
+}
+
+Datatype* TypeContext::get_function(Datatype* return_type, const ParamList& parameters) noexcept{
+    FunctionKey key{return_type, {}};
+    for (const Param& param : parameters){
+        key.parameters.emplace_back(param.first, param.second);
+    }
+
+    std::lock_guard<std::mutex> lock{mutex};
+
+    auto it = function_types.find(key);
+    if (it != function_types.end()){
+        return it->second;
+    }
+
+    auto function_type = new FunctionDatatype(return_type, parameters);
+    function_types.emplace(std::move(key), function_type);
+    return function_type;
+}
+
+Datatype* TypeContext::intern(const Datatype* type) noexcept{
+    if (type == nullptr){
+        return nullptr;
+    }
+
+    switch (type->get_kind()){
+        case NodeKind::VoidDatatype: return get<VoidDatatype>();
+        case NodeKind::BooleanDatatype: return get<BooleanDatatype>();
+        case NodeKind::CharacterDatatype: return get<CharacterDatatype>();
+        case NodeKind::IntegerDatatype: return get<IntegerDatatype>();
+        case NodeKind::StringDatatype: return get<StringDatatype>();
+        case NodeKind::NoteDatatype: return get<NoteDatatype>();
+        case NodeKind::TempoDatatype: return get<TempoDatatype>();
+        case NodeKind::KeyDatatype: return get<KeyDatatype>();
+        case NodeKind::TimeSignatureDatatype: return get<TimeSignatureDatatype>();
+
+        case NodeKind::ArrayDatatype:{
+            auto array_type = static_cast<const ArrayDatatype*>(type);
+            return get_array(intern(array_type->get_inner_datatype()));
+        }
+
+        case NodeKind::FunctionDatatype:{
+            auto function_type = static_cast<const FunctionDatatype*>(type);
+            ParamList parameters;
+            for (const Param& param : function_type->get_parameters()){
+                parameters.push_front(std::make_pair(param.first, intern(param.second)));
+            }
+            parameters.reverse(); // Para mantener el orden
+
+            return get_function(intern(function_type->get_return_type()), parameters);
+        }
+
+        default:
+            break;
+    }
+
+    return nullptr;
+}
+
+bool TypeContext::FunctionKey::operator==(const FunctionKey& other) const noexcept{
+    return return_type == other.return_type && parameters == other.parameters;
+}
+
+std::size_t TypeContext::FunctionKeyHash::operator()(const FunctionKey& key) const noexcept{
+    std::size_t seed = std::hash<Datatype*>{}(key.return_type);
+    for (const auto& param : key.parameters){
+        seed ^= std::hash<NameId>{}(param.first) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+        seed ^= std::hash<Datatype*>{}(param.second) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    }
+    return seed;
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "datatype.hpp"
+
+// Contexto de internamiento de tipos.
+//
+// Los tipos básicos (NoteDatatype, TempoDatatype, ...) son singletons
+// inmutables y los tipos compuestos (ArrayDatatype, FunctionDatatype) se
+// construyen una sola vez por estructura (hash-consing). Los Datatype que
+// devuelve type_check() son siempre canónicos: pertenecen a este contexto, no
+// se deben liberar y dos tipos iguales son el mismo puntero.
+//
+// intern() toma el mutex y reserva la clave de búsqueda, así que se llama al
+// construir las declaraciones (get_canonical_type) y no al comprobar tipos.
+class TypeContext
+{
+public:
+    static TypeContext& instance() noexcept;
+
+    ~TypeContext() noexcept;
+
+    TypeContext(const TypeContext&) = delete;
+
+    TypeContext& operator=(const TypeContext&) = delete;
+
+    // Singleton de un tipo básico
+    template <typename Type>
+    static Datatype* get() noexcept
+    {
+        static Type singleton;
+        return &singleton;
+    }
+
+    // Tipo canónico de un arreglo cuyo tipo interno ya es canónico
+    Datatype* get_array(Datatype* inner_datatype) noexcept;
+
+    // Tipo canónico de una función cuyos tipos ya son canónicos
+    Datatype* get_function(Datatype* return_type, const ParamList& parameters) noexcept;
+
+    // Versión canónica de un tipo arbitrario (por ejemplo, uno del AST)
+    Datatype* intern(const Datatype* type) noexcept;
+
+private:
+    TypeContext() noexcept = default;
+
+    struct FunctionKey
+    {
+        Datatype* return_type;
+        std::vector<std::pair<NameId, Datatype*>> parameters;
+
+        bool operator==(const FunctionKey& other) const noexcept;
+    };
+
+    struct FunctionKeyHash
+    {
+        std::size_t operator()(const FunctionKey& key) const noexcept;
+    };
+
+    std::mutex mutex;
+    std::unordered_map<Datatype*, Datatype*> array_types;
+    std::unordered_map<FunctionKey, Datatype*, FunctionKeyHash> function_types;
+};
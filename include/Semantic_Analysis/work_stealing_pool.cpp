@@ -0,0 +1,80 @@
+#include "work_stealing_pool.hpp"
+
+#include <thread>
+
+WorkStealingPool::WorkStealingPool(unsigned worker_count) noexcept
+    : worker_count{worker_count != 0 ? worker_count : std::thread::hardware_concurrency()}
+{
+    if (this->worker_count == 0){
+        this->worker_count = 1;
+    }
+
+    for (unsigned i = 0; i < this->worker_count; ++i){
+        queues.push_back(std::make_unique<WorkerQueue>());
+    }
+}
+
+unsigned WorkStealingPool::get_worker_count() const noexcept{
+    return worker_count;
+}
+
+void WorkStealingPool::run(std::size_t count, const Task& task){
+    if (count == 0){
+        return;
+    }
+
+    // Bloques contiguos: cada hilo empieza por índices vecinos
+    const std::size_t block = (count + worker_count - 1) / worker_count;
+    for (unsigned worker = 0; worker < worker_count; ++worker){
+        std::lock_guard<std::mutex> lock{queues[worker]->mutex};
+        for (std::size_t i = worker * block; i < count && i < (worker + 1) * block; ++i){
+            queues[worker]->indices.push_back(i);
+        }
+    }
+
+    std::vector<std::thread> threads;
+    for (unsigned worker = 1; worker < worker_count && worker * block < count; ++worker){
+        threads.emplace_back(&WorkStealingPool::work, this, worker, std::cref(task));
+    }
+
+    work(0, task);
+
+    for (std::thread& thread : threads){
+        thread.join();
+    }
+}
+
+bool WorkStealingPool::pop_local(unsigned worker, std::size_t& index) noexcept{
+    WorkerQueue& queue = *queues[worker];
+    std::lock_guard<std::mutex> lock{queue.mutex};
+    if (queue.indices.empty()){
+        return false;
+    }
+
+    index = queue.indices.front();
+    queue.indices.pop_front();
+    return true;
+}
+
+bool WorkStealingPool::steal(unsigned thief, std::size_t& index) noexcept{
+    // Recorrer las víctimas empezando por el vecino para repartir los robos
+    for (unsigned offset = 1; offset < worker_count; ++offset){
+        WorkerQueue& victim = *queues[(thief + offset) % worker_count];
+        std::lock_guard<std::mutex> lock{victim.mutex};
+        if (!victim.indices.empty()){
+            index = victim.indices.back();
+            victim.indices.pop_back();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void WorkStealingPool::work(unsigned worker, const Task& task){
+    // No se agregan tareas durante run(), así que sin trabajo local ni robable se termina
+    std::size_t index;
+    while (pop_local(worker, index) || steal(worker, index)){
+        task(index, worker);
+    }
+}
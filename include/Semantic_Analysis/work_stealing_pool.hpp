@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Planificador de tareas con robo de trabajo.
+//
+// run(count, task) reparte los índices [0, count) en bloques contiguos, uno
+// por hilo. Cada hilo consume su bloque desde el frente y, cuando se queda
+// sin trabajo, roba del final del bloque de otro hilo, de modo que los
+// archivos grandes no dejan hilos ociosos. No depende del AST para que el
+// parser también pueda usarlo.
+class WorkStealingPool
+{
+public:
+    // task(índice, hilo): el hilo está en [0, get_worker_count())
+    using Task = std::function<void(std::size_t, unsigned)>;
+
+    // worker_count == 0 usa std::thread::hardware_concurrency()
+    explicit WorkStealingPool(unsigned worker_count = 0) noexcept;
+
+    unsigned get_worker_count() const noexcept;
+
+    // Ejecuta task para cada índice y espera a que terminen todos.
+    // El hilo llamador participa como hilo 0.
+    void run(std::size_t count, const Task& task);
+
+private:
+    struct WorkerQueue
+    {
+        std::mutex mutex;
+        std::deque<std::size_t> indices;
+    };
+
+    bool pop_local(unsigned worker, std::size_t& index) noexcept;
+
+    bool steal(unsigned thief, std::size_t& index) noexcept;
+
+    void work(unsigned worker, const Task& task);
+
+    unsigned worker_count;
+    std::vector<std::unique_ptr<WorkerQueue>> queues;
+};
@@ -0,0 +1,341 @@
+#include "ast_cache.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#ifndef MUSIC_COMPILER_VERSION
+#define MUSIC_COMPILER_VERSION "musical-parser " __DATE__ " " __TIME__
+#endif
+
+static_assert(sizeof(CachedProgram::Header) == 80, "la cabecera del .musc cambió de tamaño");
+static_assert(sizeof(CachedProgram::PackedNote) == 8, "las notas empaquetadas deben ocupar 8 bytes");
+
+static constexpr std::uint64_t hash_prime_1 = 0x9E3779B185EBCA87ull;
+static constexpr std::uint64_t hash_prime_2 = 0xC2B2AE3D27D4EB4Full;
+
+static std::uint64_t load_word(const unsigned char* bytes) noexcept {
+    std::uint64_t word;
+    std::memcpy(&word, bytes, sizeof(word));
+    return word;
+}
+
+static std::uint64_t hash_round(std::uint64_t lane, std::uint64_t word) noexcept {
+    lane += word * hash_prime_2;
+    lane = (lane << 31) | (lane >> 33);
+    return lane * hash_prime_1;
+}
+
+std::uint64_t contentHash(const void* data, std::size_t size) noexcept {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    const unsigned char* end = bytes + size;
+
+    // Cuatro carriles independientes: las multiplicaciones no esperan una a otra
+    std::uint64_t lanes[4] = {hash_prime_1 + hash_prime_2, hash_prime_2, 0, 0 - hash_prime_1};
+    for (; end - bytes >= 32; bytes += 32) {
+        for (int lane = 0; lane < 4; lane++) {
+            lanes[lane] = hash_round(lanes[lane], load_word(bytes + 8 * lane));
+        }
+    }
+
+    std::uint64_t hash = size;
+    for (int lane = 0; lane < 4; lane++) {
+        hash = (hash ^ hash_round(0, lanes[lane])) * hash_prime_1;
+    }
+    for (; end - bytes >= 8; bytes += 8) {
+        hash = (hash ^ hash_round(0, load_word(bytes))) * hash_prime_1;
+    }
+    if (bytes != end) {
+        std::uint64_t tail = 0;
+        std::memcpy(&tail, bytes, end - bytes);
+        hash = (hash ^ hash_round(0, tail)) * hash_prime_1;
+    }
+
+    // Mezcla final para que todos los bits de entrada afecten a todos los de salida
+    hash ^= hash >> 33;
+    hash *= hash_prime_2;
+    hash ^= hash >> 29;
+    return hash;
+}
+
+bool hashSourceFile(const char* path, std::uint64_t& hash, std::uint64_t& size) noexcept {
+    int fd = ::open(path, O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || !S_ISREG(info.st_mode) || info.st_size <= 0) {
+        ::close(fd);
+        return false;
+    }
+
+    size = info.st_size;
+    void* region = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (region == MAP_FAILED) {
+        return false;
+    }
+    madvise(region, size, MADV_SEQUENTIAL);
+    hash = contentHash(region, size);
+    munmap(region, size);
+    return true;
+}
+
+const char* compilerVersionStamp() noexcept {
+    return MUSIC_COMPILER_VERSION;
+}
+
+// Hash de la marca de versión, calculado una sola vez
+static std::uint64_t compiler_hash() noexcept {
+    static const std::uint64_t hash = contentHash(compilerVersionStamp(), std::strlen(compilerVersionStamp()));
+    return hash;
+}
+
+std::string cachePathFor(const char* source_path) {
+    std::string path = source_path;
+    std::size_t length = path.size();
+    if (length >= 4 && path.compare(length - 4, 4, ".mus") == 0) {
+        return path + "c";
+    }
+    return path + ".musc";
+}
+
+CachedProgram::CachedProgram() noexcept
+    : base(nullptr), length(0) {}
+
+CachedProgram::~CachedProgram() noexcept {
+    close();
+}
+
+bool CachedProgram::open(const char* cache_path, std::uint64_t source_hash, std::uint64_t source_size) noexcept {
+    close();
+
+    int fd = ::open(cache_path, O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || !S_ISREG(info.st_mode) || static_cast<std::size_t>(info.st_size) < sizeof(Header)) {
+        ::close(fd);
+        return false;
+    }
+
+    std::size_t size = info.st_size;
+    void* region = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (region == MAP_FAILED) {
+        return false;
+    }
+    base = static_cast<const char*>(region);
+    length = size;
+
+    // Comprobar la cabecera y que cada tabla cae dentro del archivo antes de
+    // usar ninguna posición; cualquier inconsistencia invalida la caché
+    const Header& header = *reinterpret_cast<const Header*>(base);
+    bool valid = header.magic == magic && header.version == version
+        && header.source_hash == source_hash && header.source_size == source_size
+        && header.compiler_hash == compiler_hash()
+        && header.file_size == size
+        && header.notes_offset % alignof(PackedNote) == 0 && header.strings_offset % alignof(StringEntry) == 0
+        && header.notes_offset >= sizeof(Header)
+        && header.notes_offset + static_cast<std::uint64_t>(header.note_count) * sizeof(PackedNote) <= size
+        && header.strings_offset + static_cast<std::uint64_t>(header.string_count) * sizeof(StringEntry) <= size
+        && (header.key_note == no_string || header.key_note < header.string_count)
+        && (header.key_mode == no_string || header.key_mode < header.string_count);
+
+    const StringEntry* strings = reinterpret_cast<const StringEntry*>(base + header.strings_offset);
+    for (std::uint32_t i = 0; valid && i < header.string_count; i++) {
+        valid = header.strings_offset + static_cast<std::uint64_t>(strings[i].offset) + strings[i].length <= size;
+    }
+
+    if (!valid) {
+        close();
+    }
+    return valid;
+}
+
+void CachedProgram::close() noexcept {
+    if (base != nullptr) {
+        munmap(const_cast<char*>(base), length);
+    }
+    base = nullptr;
+    length = 0;
+}
+
+bool CachedProgram::isOpen() const noexcept {
+    return base != nullptr;
+}
+
+bool CachedProgram::isComplete() const noexcept {
+    return hasTempo() && hasTimeSignature() && hasKey();
+}
+
+bool CachedProgram::hasTempo() const noexcept {
+    return reinterpret_cast<const Header*>(base)->flags & has_tempo;
+}
+
+bool CachedProgram::hasTimeSignature() const noexcept {
+    return reinterpret_cast<const Header*>(base)->flags & has_time_signature;
+}
+
+bool CachedProgram::hasKey() const noexcept {
+    return reinterpret_cast<const Header*>(base)->flags & has_key;
+}
+
+int CachedProgram::getTempo() const noexcept {
+    return reinterpret_cast<const Header*>(base)->tempo;
+}
+
+int CachedProgram::getTimeSignatureNumerator() const noexcept {
+    return reinterpret_cast<const Header*>(base)->time_signature_num;
+}
+
+int CachedProgram::getTimeSignatureDenominator() const noexcept {
+    return reinterpret_cast<const Header*>(base)->time_signature_den;
+}
+
+std::string_view CachedProgram::getKeyNote() const noexcept {
+    return getString(reinterpret_cast<const Header*>(base)->key_note);
+}
+
+std::string_view CachedProgram::getKeyMode() const noexcept {
+    return getString(reinterpret_cast<const Header*>(base)->key_mode);
+}
+
+std::size_t CachedProgram::getNoteCount() const noexcept {
+    return reinterpret_cast<const Header*>(base)->note_count;
+}
+
+Note CachedProgram::getNote(std::size_t index) const noexcept {
+    const Header& header = *reinterpret_cast<const Header*>(base);
+    const PackedNote& note = reinterpret_cast<const PackedNote*>(base + header.notes_offset)[index];
+
+    std::uint8_t octave = note.octave_alteration & 0x0F;
+    return Note(note.pitch_class, static_cast<std::int8_t>((note.octave_alteration >> 4) - 1),
+                octave == 0x0F ? NoteStream::invalid_octave : octave, note.duration);
+}
+
+std::uint32_t CachedProgram::getSourceOffset(std::size_t index) const noexcept {
+    const Header& header = *reinterpret_cast<const Header*>(base);
+    return reinterpret_cast<const PackedNote*>(base + header.notes_offset)[index].source_offset;
+}
+
+std::string_view CachedProgram::getString(std::uint32_t index) const noexcept {
+    if (index == no_string) {
+        return {};
+    }
+    const Header& header = *reinterpret_cast<const Header*>(base);
+    const StringEntry& entry = reinterpret_cast<const StringEntry*>(base + header.strings_offset)[index];
+    return std::string_view(base + header.strings_offset + entry.offset, entry.length);
+}
+
+// Agrega una cadena a la tabla (sin repetir) y devuelve su índice
+static std::uint32_t add_string(std::vector<std::string_view>& table, std::string_view text) {
+    for (std::size_t i = 0; i < table.size(); i++) {
+        if (table[i] == text) {
+            return i;
+        }
+    }
+    table.push_back(text);
+    return table.size() - 1;
+}
+
+bool CachedProgram::write(const char* cache_path, const MusicProgram& program,
+                          std::uint64_t source_hash, std::uint64_t source_size) noexcept {
+    const Configuration* config = program.getConfiguration();
+    const NoteStream& notes = program.getNotes();
+
+    Header header{};
+    header.magic = magic;
+    header.version = version;
+    header.source_hash = source_hash;
+    header.source_size = source_size;
+    header.compiler_hash = compiler_hash();
+    header.key_note = no_string;
+    header.key_mode = no_string;
+
+    std::vector<std::string_view> strings;
+    if (config != nullptr) {
+        if (config->hasTempo()) {
+            header.flags |= has_tempo;
+            header.tempo = config->getTempo();
+        }
+        if (config->hasTimeSignature()) {
+            header.flags |= has_time_signature;
+            header.time_signature_num = config->getTimeSignatureNumerator();
+            header.time_signature_den = config->getTimeSignatureDenominator();
+        }
+        if (config->hasKey()) {
+            header.flags |= has_key;
+            header.key_note = add_string(strings, config->getKeyNote());
+            header.key_mode = add_string(strings, config->getKeyMode());
+        }
+    }
+
+    // Empaquetar las columnas del NoteStream en registros
+    std::vector<PackedNote> packed(notes.size());
+    for (std::size_t i = 0; i < notes.size(); i++) {
+        std::int8_t alteration = notes.get_alterations()[i];
+        std::uint8_t octave = notes.get_octaves()[i];
+        if (alteration < -1 || alteration > 1 || (octave >= 0x0F && octave != NoteStream::invalid_octave)) {
+            return false;
+        }
+        packed[i].source_offset = notes.get_source_offsets()[i];
+        packed[i].duration = notes.get_durations()[i];
+        packed[i].pitch_class = notes.get_pitch_classes()[i];
+        packed[i].octave_alteration = (octave == NoteStream::invalid_octave ? 0x0F : octave) | ((alteration + 1) << 4);
+    }
+
+    std::vector<StringEntry> entries(strings.size());
+    std::uint32_t string_bytes = strings.size() * sizeof(StringEntry);
+    for (std::size_t i = 0; i < strings.size(); i++) {
+        entries[i] = StringEntry{string_bytes, static_cast<std::uint32_t>(strings[i].size())};
+        string_bytes += strings[i].size();
+    }
+
+    std::uint64_t notes_end = sizeof(Header) + packed.size() * sizeof(PackedNote);
+    std::uint64_t file_size = notes_end + string_bytes;
+    if (file_size > 0xFFFFFFFFull) {
+        return false;
+    }
+    header.note_count = packed.size();
+    header.notes_offset = sizeof(Header);
+    header.string_count = strings.size();
+    header.strings_offset = notes_end;   // 80 + 8n: ya alineado para StringEntry
+    header.file_size = file_size;
+
+    // Nombre temporal único aunque dos hilos escriban la misma caché
+    std::string temporary = std::string(cache_path) + ".XXXXXX";
+    int fd = mkstemp(temporary.data());
+    if (fd < 0) {
+        return false;
+    }
+    fchmod(fd, 0644);   // mkstemp crea el archivo con 0600
+    FILE* file = fdopen(fd, "wb");
+    if (!file) {
+        ::close(fd);
+        unlink(temporary.c_str());
+        return false;
+    }
+    bool written = fwrite(&header, sizeof(header), 1, file) == 1
+        && fwrite(packed.data(), sizeof(PackedNote), packed.size(), file) == packed.size()
+        && fwrite(entries.data(), sizeof(StringEntry), entries.size(), file) == entries.size();
+    for (std::string_view text : strings) {
+        written = written && fwrite(text.data(), 1, text.size(), file) == text.size();
+    }
+    written = fclose(file) == 0 && written;
+
+    if (!written || rename(temporary.c_str(), cache_path) != 0) {
+        unlink(temporary.c_str());
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "expression.hpp"
+
+// Caché binaria del programa analizado (.musc).
+//
+// Junto a cada partitura.mus se guarda partitura.musc con el resultado del
+// parser: la configuración, una tabla de cadenas internadas (nombres de la
+// tonalidad) y las notas empaquetadas en registros de 8 bytes. Todas las
+// posiciones son relativas al inicio del archivo, así que se proyecta con mmap
+// y se lee en el lugar, sin deserializar ni reservar memoria. La cabecera
+// guarda el hash y el tamaño del fuente y el de la versión del compilador
+// (compilerVersionStamp): si cambió el .mus o el parser que la escribió, la
+// caché se ignora y se vuelve a escribir tras el siguiente análisis.
+//
+// Formato (enteros en el orden de bytes de la máquina; la constante mágica
+// rechaza archivos de otra arquitectura):
+//   Header                        80 bytes
+//   PackedNote[note_count]        en notes_offset (alineado a 8)
+//   StringEntry[string_count]     en strings_offset (alineado a 4)
+//   bytes de las cadenas          posición relativa a strings_offset
+
+// Hash de 64 bits del contenido (cuatro carriles de 8 bytes por iteración)
+std::uint64_t contentHash(const void* data, std::size_t size) noexcept;
+
+// Proyecta un archivo regular y calcula su hash. false si no se puede leer
+// (no existe, tubería, dispositivo...) o está vacío.
+bool hashSourceFile(const char* path, std::uint64_t& hash, std::uint64_t& size) noexcept;
+
+// Marca de versión del compilador, compartida por el .musc y ResultCache: el
+// Makefile la fija con -DMUSIC_COMPILER_VERSION="..." a partir del hash de la
+// gramática y las fuentes del parser (VERSION_SOURCES). Compilado sin ella, la
+// fecha y hora de compilación (cualquier recompilación invalida las cachés).
+const char* compilerVersionStamp() noexcept;
+
+// Ruta de la caché de un fuente: x.mus -> x.musc; otro nombre -> nombre.musc
+std::string cachePathFor(const char* source_path);
+
+class CachedProgram {
+public:
+    static constexpr std::uint32_t magic = 0x4353554D;   // "MUSC"
+    static constexpr std::uint32_t version = 2;
+    static constexpr std::uint32_t no_string = 0xFFFFFFFF;
+
+    struct Header {
+        std::uint32_t magic;
+        std::uint32_t version;
+        std::uint64_t source_hash;
+        std::uint64_t source_size;
+        std::uint64_t compiler_hash;     // Hash de compilerVersionStamp()
+        std::uint32_t flags;             // has_tempo | has_time_signature | has_key
+        std::int32_t tempo;
+        std::int32_t time_signature_num;
+        std::int32_t time_signature_den;
+        std::uint32_t key_note;          // Índice en la tabla de cadenas o no_string
+        std::uint32_t key_mode;
+        std::uint32_t note_count;
+        std::uint32_t notes_offset;
+        std::uint32_t string_count;
+        std::uint32_t strings_offset;
+        std::uint32_t file_size;
+        std::uint32_t reserved;
+    };
+
+    // octave_alteration: octava en los 4 bits bajos (0xF = inválida) y
+    // alteración + 1 en los bits 4-5
+    struct PackedNote {
+        std::uint32_t source_offset;
+        std::uint16_t duration;
+        std::uint8_t pitch_class;
+        std::uint8_t octave_alteration;
+    };
+
+    struct StringEntry {
+        std::uint32_t offset;
+        std::uint32_t length;
+    };
+
+    enum Flags : std::uint32_t {
+        has_tempo = 1,
+        has_time_signature = 2,
+        has_key = 4
+    };
+
+    CachedProgram() noexcept;
+    ~CachedProgram() noexcept;
+
+    CachedProgram(const CachedProgram&) = delete;
+    CachedProgram& operator=(const CachedProgram&) = delete;
+
+    // Proyectar cache_path y aceptarlo solo si corresponde a ese fuente, lo
+    // escribió esta versión del compilador y todas sus posiciones caen dentro
+    // del archivo. Cierra la anterior.
+    bool open(const char* cache_path, std::uint64_t source_hash, std::uint64_t source_size) noexcept;
+
+    void close() noexcept;
+
+    bool isOpen() const noexcept;
+
+    // Misma consulta que MusicProgram::validate()
+    bool isComplete() const noexcept;
+
+    bool hasTempo() const noexcept;
+    bool hasTimeSignature() const noexcept;
+    bool hasKey() const noexcept;
+    int getTempo() const noexcept;
+    int getTimeSignatureNumerator() const noexcept;
+    int getTimeSignatureDenominator() const noexcept;
+    std::string_view getKeyNote() const noexcept;
+    std::string_view getKeyMode() const noexcept;
+
+    std::size_t getNoteCount() const noexcept;
+    Note getNote(std::size_t index) const noexcept;
+    std::uint32_t getSourceOffset(std::size_t index) const noexcept;
+
+    // Escribir la caché de un programa (archivo temporal + rename, para que un
+    // lector nunca vea un .musc a medias). false si alguna nota no cabe en el
+    // formato empaquetado o no se pudo escribir.
+    static bool write(const char* cache_path, const MusicProgram& program,
+                      std::uint64_t source_hash, std::uint64_t source_size) noexcept;
+
+private:
+    std::string_view getString(std::uint32_t index) const noexcept;
+
+    const char* base;
+    std::size_t length;
+};
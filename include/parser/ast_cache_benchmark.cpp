@@ -0,0 +1,214 @@
+/*
+    Compilador Musical: Benchmark de las cachés del parser
+
+    Genera un corpus de N partituras en un directorio temporal, escribe sus
+    .musc y sus entradas en la caché de resultados, y luego vuelve a validar
+    el corpus completo de tres formas:
+      - análisis desde el fuente (mmap + yyparse), como sin cachés
+      - hash del fuente + proyección del .musc, leído en el lugar
+      - hash del fuente + veredicto de la caché de resultados
+    Las dos primeras recorren todas las notas, para que la caché no gane solo
+    por no tocarlas; la tercera solo devuelve el veredicto, como el driver con
+    --result-cache. Se informa el mejor tiempo de varias repeticiones.
+
+    Uso: ./ast_cache_benchmark [archivos] [notas por archivo] [repeticiones]
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "ast_cache.hpp"
+#include "music_parser.hpp"
+#include "result_cache.hpp"
+
+extern int yydebug;
+
+using Clock = std::chrono::steady_clock;
+
+static const char* pitches[] = {"Do", "Re", "Mi", "Fa", "Sol", "La", "Si"};
+static const char* alterations[] = {"", "#", "b"};
+static const char* durations[] = {"Blanca", "Negra", "Corchea", "Semicorchea"};
+
+static bool write_score(const std::string& path, long seed, long notes) {
+    FILE* file = fopen(path.c_str(), "w");
+    if (!file) return false;
+
+    fprintf(file, "Tempo %ld\nCompas 4/4\nTonalidad %s M\n", 60 + seed % 120, pitches[seed % 7]);
+    for (long i = 0; i < notes; ++i) {
+        long n = i + seed;
+        fprintf(file, "%s%s%ld %s\n", pitches[n % 7], alterations[n % 3], n % 9, durations[n % 4]);
+    }
+
+    fclose(file);
+    return true;
+}
+
+// Suma de control sobre las notas: igual en los dos modos si la caché es fiel
+struct Checksum {
+    std::size_t files = 0;
+    std::size_t complete = 0;
+    std::uint64_t notes = 0;
+    std::uint64_t durations = 0;
+
+    bool operator==(const Checksum& other) const {
+        return files == other.files && complete == other.complete
+            && notes == other.notes && durations == other.durations;
+    }
+};
+
+static Checksum from_source(MusicParser& parser, const std::vector<std::string>& paths) {
+    Checksum checksum;
+    for (const std::string& path : paths) {
+        MusicProgram* program = parser.parseFile(path.c_str());
+        if (!program) continue;
+        checksum.files++;
+        checksum.complete += program->validate();
+        for (std::uint16_t duration : program->getNotes().get_durations()) {
+            checksum.durations += duration;
+        }
+        checksum.notes += program->getNoteCount();
+        program->destroy();
+        delete program;
+    }
+    return checksum;
+}
+
+static Checksum from_cache(const std::vector<std::string>& paths) {
+    Checksum checksum;
+    CachedProgram cached;
+    for (const std::string& path : paths) {
+        std::uint64_t hash = 0;
+        std::uint64_t size = 0;
+        if (!hashSourceFile(path.c_str(), hash, size) || !cached.open(cachePathFor(path.c_str()).c_str(), hash, size)) {
+            continue;
+        }
+        checksum.files++;
+        checksum.complete += cached.isComplete();
+        for (std::size_t i = 0; i < cached.getNoteCount(); ++i) {
+            checksum.durations += cached.getNote(i).getDuration();
+        }
+        checksum.notes += cached.getNoteCount();
+    }
+    return checksum;
+}
+
+static Checksum from_results(const ResultCache& results, const std::vector<std::string>& paths) {
+    Checksum checksum;
+    FileResult result;
+    for (const std::string& path : paths) {
+        std::uint64_t hash = 0;
+        std::uint64_t size = 0;
+        if (!hashSourceFile(path.c_str(), hash, size) || !results.lookup(hash, size, result) || !result.success) {
+            continue;
+        }
+        checksum.files++;
+        checksum.complete += result.complete;
+        checksum.notes += result.note_count;
+    }
+    return checksum;
+}
+
+static void run_mode(const char* label, const std::function<Checksum()>& mode, int repetitions,
+                     double megabytes, Checksum& checksum) {
+    double best_ms = 0;
+    for (int r = 0; r < repetitions; ++r) {
+        auto start = Clock::now();
+        checksum = mode();
+        double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        best_ms = r == 0 ? ms : std::min(best_ms, ms);
+    }
+
+    std::cout << std::setw(24) << std::left << label
+              << " | " << std::setw(10) << std::right << std::fixed << std::setprecision(2) << best_ms << " ms"
+              << " | " << std::setw(8) << std::setprecision(1) << megabytes / (best_ms / 1000.0) << " MB/s"
+              << " | " << checksum.files << " archivos, " << checksum.notes << " notas" << std::endl;
+}
+
+int main(int argc, char** argv) {
+    yydebug = 0;
+
+    long files = argc > 1 ? atol(argv[1]) : 2000;
+    long notes = argc > 2 ? atol(argv[2]) : 400;
+    int repetitions = argc > 3 ? atoi(argv[3]) : 3;
+    if (files <= 0 || notes <= 0 || repetitions <= 0) {
+        std::cerr << "Uso: " << argv[0] << " [archivos] [notas por archivo] [repeticiones]" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::filesystem::path directory = "/tmp/ast_cache_benchmark_" + std::to_string(getpid());
+    std::error_code error;
+    std::filesystem::create_directory(directory, error);
+    if (error) {
+        std::cerr << "No se pudo crear " << directory << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::vector<std::string> paths;
+    std::uintmax_t bytes = 0;
+    for (long i = 0; i < files; ++i) {
+        std::string path = (directory / ("score_" + std::to_string(i) + ".mus")).string();
+        if (!write_score(path, i, notes)) {
+            std::cerr << "No se pudo crear " << path << std::endl;
+            return EXIT_FAILURE;
+        }
+        bytes += std::filesystem::file_size(path);
+        paths.push_back(path);
+    }
+    double megabytes = bytes / (1024.0 * 1024.0);
+
+    // Primera pasada: analizar y escribir los .musc y los veredictos (lo que
+    // hace el driver con --ast-cache y --result-cache cuando no hay caché)
+    MusicParser parser;
+    ResultCache results((directory / "results").string(), files);
+    results.prepare();
+    std::uintmax_t cache_bytes = 0;
+    for (const std::string& path : paths) {
+        std::uint64_t hash = 0;
+        std::uint64_t size = 0;
+        MusicProgram* program = parser.parseFile(path.c_str());
+        if (program && hashSourceFile(path.c_str(), hash, size)) {
+            std::string cache_path = cachePathFor(path.c_str());
+            if (CachedProgram::write(cache_path.c_str(), *program, hash, size)) {
+                cache_bytes += std::filesystem::file_size(cache_path);
+            }
+            FileResult result;
+            result.success = true;
+            result.complete = program->validate();
+            result.note_count = program->getNoteCount();
+            results.store(hash, size, result);
+        }
+        if (program) {
+            program->destroy();
+            delete program;
+        }
+    }
+
+    std::cout << "====== Benchmark de las cachés del parser (" << files << " archivos, " << std::fixed << std::setprecision(1)
+              << megabytes << " MB de fuente, " << cache_bytes / (1024.0 * 1024.0) << " MB de caché, mejor de "
+              << repetitions << ") ======" << std::endl;
+
+    Checksum parsed;
+    Checksum cached;
+    Checksum verdicts;
+    run_mode("fuente (yyparse)", [&]() { return from_source(parser, paths); }, repetitions, megabytes, parsed);
+    run_mode("desde .musc (mmap)", [&]() { return from_cache(paths); }, repetitions, megabytes, cached);
+    run_mode("veredicto (resultados)", [&]() { return from_results(results, paths); }, repetitions, megabytes, verdicts);
+
+    // La caché de resultados no guarda las notas: se comparan los totales
+    verdicts.durations = parsed.durations;
+    bool same = parsed == cached && parsed == verdicts;
+    std::cout << "Resultados iguales: " << (same ? "✓ ÉXITO" : "✗ ERROR") << std::endl;
+
+    std::filesystem::remove_all(directory, error);
+    return same ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -1,6 +1,8 @@
 #include "expression.hpp"
 #include <sstream>
 
+#include "../Semantic_Analysis/stats.hpp"
+
 extern bool yydebug;
 
 using namespace std::literals;
@@ -12,7 +14,9 @@ Expression::~Expression() {}
 Configuration::Configuration() noexcept
     : tempo_set(false), time_signature_set(false), key_set(false),
       tempo_value(0), time_signature_num(0), time_signature_den(0),
-      key_note(""), key_mode("") {}
+      key_note(StringInterner::invalid_id), key_mode(StringInterner::invalid_id) {
+    count(Counter::ParserConfiguration);
+}
 
 void Configuration::destroy() noexcept {}
 
@@ -35,7 +39,7 @@ std::string Configuration::to_string() const noexcept {
     }
     
     if (key_set) {
-        ss << ", key: " << key_note << " " << key_mode;
+        ss << ", key: " << name_text(key_note) << " " << name_text(key_mode);
     }
     
     ss << ")"s;
@@ -54,6 +58,26 @@ bool Configuration::hasKey() const noexcept {
     return key_set;
 }
 
+int Configuration::getTempo() const noexcept {
+    return tempo_value;
+}
+
+int Configuration::getTimeSignatureNumerator() const noexcept {
+    return time_signature_num;
+}
+
+int Configuration::getTimeSignatureDenominator() const noexcept {
+    return time_signature_den;
+}
+
+std::string_view Configuration::getKeyNote() const noexcept {
+    return name_text(key_note);
+}
+
+std::string_view Configuration::getKeyMode() const noexcept {
+    return name_text(key_mode);
+}
+
 void Configuration::setTempo(int bpm) noexcept {
     if (bpm <= 0 && yydebug) {
         fprintf(stderr, "ERROR: El tempo debe ser positivo\n");
@@ -82,13 +106,17 @@ void Configuration::setTimeSignature(int numerator, int denominator) noexcept {
     fprintf(stderr, "DEBUG: Configuración: compás establecido a %d/%d\n", numerator, denominator);
 }
 
-void Configuration::setKey(const std::string& note, const std::string& mode) noexcept {
+void Configuration::setKey(NameId note, NameId mode) noexcept {
     key_set = true;
     key_note = note;
     key_mode = mode;
     
     if (!yydebug) return;
-    fprintf(stderr, "DEBUG: Configuración: tonalidad establecida a %s %s\n", note.c_str(), mode.c_str());
+    std::string_view note_name = name_text(note);
+    std::string_view mode_name = name_text(mode);
+    fprintf(stderr, "DEBUG: Configuración: tonalidad establecida a %.*s %.*s\n",
+            static_cast<int>(note_name.size()), note_name.data(),
+            static_cast<int>(mode_name.size()), mode_name.data());
 }
 
 // Tempo
@@ -131,7 +159,7 @@ int TimeSignature::getDenominator() const noexcept {
 }
 
 // Key
-Key::Key(const std::string& note, const std::string& mode) noexcept
+Key::Key(NameId note, NameId mode) noexcept
     : note(note), mode(mode) {
     setKey(note, mode);
 }
@@ -141,20 +169,23 @@ void Key::destroy() noexcept {
 }
 
 std::string Key::to_string() const noexcept {
-    return "Key("s + note + " " + mode + ")"s;
+    return "Key("s + std::string(name_text(note)) + " " + std::string(name_text(mode)) + ")"s;
 }
 
-std::string Key::getNote() const noexcept {
-    return note;
+std::string_view Key::getNote() const noexcept {
+    return name_text(note);
 }
 
-std::string Key::getMode() const noexcept {
-    return mode;
+std::string_view Key::getMode() const noexcept {
+    return name_text(mode);
 }
 
 // MusicProgram
-MusicProgram::MusicProgram(Configuration* config) noexcept
+MusicProgram::MusicProgram(Configuration* config, std::size_t expected_notes) noexcept
     : configuration(config) {
+    count(Counter::ParserProgram);
+    notes.reserve(expected_notes);
+    
     if (!yydebug) return;
     fprintf(stderr, "DEBUG: Programa musical creado\n");
 }
@@ -164,6 +195,7 @@ void MusicProgram::destroy() noexcept {
         configuration->destroy();
         delete configuration;
         configuration = nullptr;
+        notes.clear();
         
         if (!yydebug) return;
         fprintf(stderr, "DEBUG: Programa musical destruido\n");
@@ -172,7 +204,8 @@ void MusicProgram::destroy() noexcept {
 
 std::string MusicProgram::to_string() const noexcept {
     std::stringstream ss;
-    ss << "MusicProgram(" << (configuration ? configuration->to_string() : "null") << ")";
+    ss << "MusicProgram(" << (configuration ? configuration->to_string() : "null")
+       << ", notes: " << notes.size() << ")";
     return ss.str();
 }
 
@@ -184,27 +217,58 @@ Configuration* MusicProgram::getConfiguration() const noexcept {
     return configuration;
 }
 
-// Note
-Note::Note(const std::string& name, const std::string& alteration, int octave, const std::string& duration) noexcept
-    : name(name), alteration(alteration), octave(octave), duration(duration) {
+void MusicProgram::appendNote(std::uint8_t pitch_class, std::int8_t alteration, int octave,
+                              std::uint16_t duration_ticks, std::uint32_t source_offset) noexcept {
+    notes.append(pitch_class, alteration, octave, duration_ticks, source_offset);
+    count(Counter::ParserNote);
+    
     if (!yydebug) return;
-    fprintf(stderr, "DEBUG: Nota creada: %s%s%d con duración %s\n", 
-            name.c_str(), alteration.c_str(), octave, duration.c_str());
+    fprintf(stderr, "DEBUG: Nota agregada: %s\n", getNote(notes.size() - 1).to_string().c_str());
 }
 
-void Note::destroy() noexcept {
-    if (!yydebug) return;
-    fprintf(stderr, "DEBUG: Nota destruida\n");
+std::size_t MusicProgram::getNoteCount() const noexcept {
+    return notes.size();
 }
 
+Note MusicProgram::getNote(std::size_t index) const noexcept {
+    return Note(notes.get_pitch_classes()[index], notes.get_alterations()[index],
+                notes.get_octaves()[index], notes.get_durations()[index]);
+}
+
+const NoteStream& MusicProgram::getNotes() const noexcept {
+    return notes;
+}
+
+// Note
+Note::Note(std::uint8_t pitch_class, std::int8_t alteration, std::uint8_t octave, std::uint16_t duration_ticks) noexcept
+    : pitch_class(pitch_class), alteration(alteration), octave(octave), duration(duration_ticks) {}
+
 std::string Note::to_string() const noexcept {
     std::stringstream ss;
-    ss << "Note(" << name;
+    ss << "Note(" << pitch_class_letter(pitch_class);
     
-    if (!alteration.empty()) {
-        ss << alteration;
+    if (alteration > 0) {
+        ss << "#";
+    } else if (alteration < 0) {
+        ss << "b";
     }
     
-    ss << octave << ", duration: " << duration << ")";
+    ss << static_cast<int>(octave) << ", duration: " << duration_name(duration) << ")";
     return ss.str();
-} 
\ No newline at end of file
+}
+
+std::uint8_t Note::getPitchClass() const noexcept {
+    return pitch_class;
+}
+
+std::int8_t Note::getAlteration() const noexcept {
+    return alteration;
+}
+
+std::uint8_t Note::getOctave() const noexcept {
+    return octave;
+}
+
+std::uint16_t Note::getDuration() const noexcept {
+    return duration;
+}
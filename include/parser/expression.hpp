@@ -1,6 +1,12 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <string>
+#include <string_view>
+
+#include "../Semantic_Analysis/note_stream.hpp"
+#include "../Semantic_Analysis/string_interner.hpp"
 
 class Expression {
 public:
@@ -19,11 +25,18 @@ public:
     bool hasTempo() const noexcept;
     bool hasTimeSignature() const noexcept;
     bool hasKey() const noexcept;
+
+    // Valores almacenados (solo válidos si el has* correspondiente es true)
+    int getTempo() const noexcept;
+    int getTimeSignatureNumerator() const noexcept;
+    int getTimeSignatureDenominator() const noexcept;
+    std::string_view getKeyNote() const noexcept;
+    std::string_view getKeyMode() const noexcept;
     
     // Métodos para actualizar propiedades
     void setTempo(int bpm) noexcept;
     void setTimeSignature(int numerator, int denominator) noexcept;
-    void setKey(const std::string& note, const std::string& mode) noexcept;
+    void setKey(NameId note, NameId mode) noexcept;
 
 protected:
     bool tempo_set;
@@ -34,8 +47,8 @@ protected:
     int tempo_value;
     int time_signature_num;
     int time_signature_den;
-    std::string key_note;
-    std::string key_mode;
+    NameId key_note;
+    NameId key_mode;
 };
 
 class Tempo : public Configuration {
@@ -64,38 +77,54 @@ private:
 
 class Key : public Configuration {
 public:
-    Key(const std::string& note, const std::string& mode) noexcept;
+    Key(NameId note, NameId mode) noexcept;
     void destroy() noexcept override;
     std::string to_string() const noexcept override;
-    std::string getNote() const noexcept;
-    std::string getMode() const noexcept;
+    std::string_view getNote() const noexcept;
+    std::string_view getMode() const noexcept;
 
 private:
-    std::string note;
-    std::string mode;
+    NameId note;
+    NameId mode;
 };
 
-class MusicProgram : public Expression {
+// Vista compacta de una nota del programa (sin memoria dinámica)
+class Note {
 public:
-    MusicProgram(Configuration* config) noexcept;
-    void destroy() noexcept override;
-    std::string to_string() const noexcept override;
-    bool validate() const noexcept;
-    Configuration* getConfiguration() const noexcept;
+    Note(std::uint8_t pitch_class, std::int8_t alteration, std::uint8_t octave, std::uint16_t duration_ticks) noexcept;
+    std::string to_string() const noexcept;
+
+    std::uint8_t getPitchClass() const noexcept;
+    std::int8_t getAlteration() const noexcept;
+    std::uint8_t getOctave() const noexcept;
+    std::uint16_t getDuration() const noexcept;
 
 private:
-    Configuration* configuration;
+    std::uint8_t pitch_class;   // grado diatónico 0-6 (Do/C ... Si/B)
+    std::int8_t alteration;     // -1 bemol, 0 natural, +1 sostenido
+    std::uint8_t octave;
+    std::uint16_t duration;     // ticks MIDI (Negra = 480)
 };
 
-class Note : public Expression {
+class MusicProgram : public Expression {
 public:
-    Note(const std::string& name, const std::string& alteration, int octave, const std::string& duration) noexcept;
+    static constexpr std::size_t default_note_capacity = 256;
+
+    MusicProgram(Configuration* config, std::size_t expected_notes = default_note_capacity) noexcept;
     void destroy() noexcept override;
     std::string to_string() const noexcept override;
+    bool validate() const noexcept;
+    Configuration* getConfiguration() const noexcept;
+
+    // Búfer de notas de solo anexado: las acciones de la gramática agregan
+    // directamente a sus columnas, sin crear objetos ni cadenas por nota
+    void appendNote(std::uint8_t pitch_class, std::int8_t alteration, int octave,
+                    std::uint16_t duration_ticks, std::uint32_t source_offset) noexcept;
+    std::size_t getNoteCount() const noexcept;
+    Note getNote(std::size_t index) const noexcept;
+    const NoteStream& getNotes() const noexcept;
 
 private:
-    std::string name;
-    std::string alteration;
-    int octave;
-    std::string duration;
+    Configuration* configuration;
+    NoteStream notes;
 }; 
\ No newline at end of file
@@ -0,0 +1,374 @@
+/*
+    Lexer escrito a mano, alternativa a scanner.flex (make LEXER=hand).
+
+    Expone la misma interfaz que el scanner reentrante de flex (yylex,
+    yylex_init_extra, yyset_in, yy_scan_buffer, ...) y produce exactamente la
+    misma secuencia de tokens, con las mismas reglas de desempate de flex: gana
+    la coincidencia más larga y, a igual longitud, la regla que aparece antes
+    en scanner.flex. En particular [#b♭] es una clase de bytes, así que "C♭4"
+    se divide en TOKEN_NOTA_DO, TOKEN_BEMOL y TOKEN_NUMERO igual que con flex.
+
+    Los tramos de espacios, los comentarios y los identificadores se recorren
+    de a 16 bytes con SSE2 cuando está disponible.
+*/
+
+#include "music_parser.hpp"
+#include "parser.tab.h"
+
+#include <cstring>
+#include <string>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+struct yy_buffer_state {
+    char* base;
+    std::size_t size;
+};
+
+namespace {
+
+// Relleno en cero después de la entrada leída por flujo (como los centinelas de flex)
+constexpr std::size_t stream_padding = 16;
+
+enum CharClass : unsigned char {
+    SPACE = 1 << 0,        // [ \t\n]
+    DIGIT = 1 << 1,        // [0-9]
+    IDENT_START = 1 << 2,  // [a-zA-Z_]
+    IDENT = 1 << 3,        // [a-zA-Z0-9_]
+    ALTER = 1 << 4,        // [#b♭] (bytes '#', 'b', 0xE2, 0x99, 0xAD)
+};
+
+struct CharTable {
+    unsigned char classes[256];
+
+    constexpr CharTable() : classes{} {
+        classes[static_cast<unsigned char>(' ')] |= SPACE;
+        classes[static_cast<unsigned char>('\t')] |= SPACE;
+        classes[static_cast<unsigned char>('\n')] |= SPACE;
+        for (int c = '0'; c <= '9'; c++) classes[c] |= DIGIT | IDENT;
+        for (int c = 'a'; c <= 'z'; c++) classes[c] |= IDENT_START | IDENT;
+        for (int c = 'A'; c <= 'Z'; c++) classes[c] |= IDENT_START | IDENT;
+        classes[static_cast<unsigned char>('_')] |= IDENT_START | IDENT;
+        classes[static_cast<unsigned char>('#')] |= ALTER;
+        classes[static_cast<unsigned char>('b')] |= ALTER;
+        classes[0xE2] |= ALTER;
+        classes[0x99] |= ALTER;
+        classes[0xAD] |= ALTER;
+    }
+};
+
+constexpr CharTable char_table;
+
+inline bool has_class(char c, unsigned char mask) noexcept {
+    return char_table.classes[static_cast<unsigned char>(c)] & mask;
+}
+
+// Estado de una instancia del lexer (lo que flex guarda en yyscan_t)
+struct HandLexer {
+    MusicParser* extra = nullptr;
+    FILE* input = nullptr;
+    std::string storage;          // Entrada leída por flujo, con relleno en cero
+    yy_buffer_state buffer{nullptr, 0};
+    char* begin = nullptr;
+    char* cursor = nullptr;
+    char* end = nullptr;
+    char* text = nullptr;         // Texto del último token (terminado en '\0')
+    char* text_end = nullptr;
+    char hold_char = '\0';        // Byte reemplazado por el '\0' del texto
+    bool loaded = false;
+};
+
+HandLexer* get_lexer(yyscan_t scanner) noexcept {
+    return static_cast<HandLexer*>(scanner);
+}
+
+void load_stream(HandLexer& lexer) {
+    char chunk[64 * 1024];
+    std::size_t count;
+    while (lexer.input && (count = fread(chunk, 1, sizeof(chunk), lexer.input)) > 0) {
+        lexer.storage.append(chunk, count);
+    }
+
+    std::size_t size = lexer.storage.size();
+    lexer.storage.append(stream_padding, '\0');
+    lexer.begin = &lexer.storage[0];
+    lexer.cursor = lexer.begin;
+    lexer.end = lexer.begin + size;
+}
+
+// Primer byte que no es [ \t\n]
+const char* skip_spaces(const char* p, const char* end) noexcept {
+#if defined(__SSE2__)
+    const __m128i space = _mm_set1_epi8(' ');
+    const __m128i tab = _mm_set1_epi8('\t');
+    const __m128i newline = _mm_set1_epi8('\n');
+    while (p + 16 <= end) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        __m128i spaces = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, space), _mm_cmpeq_epi8(chunk, tab)),
+                                      _mm_cmpeq_epi8(chunk, newline));
+        unsigned others = ~static_cast<unsigned>(_mm_movemask_epi8(spaces)) & 0xFFFF;
+        if (others) return p + __builtin_ctz(others);
+        p += 16;
+    }
+#endif
+    while (p < end && has_class(*p, SPACE)) p++;
+    return p;
+}
+
+// Primer '\n' a partir de p (o end): fin de un comentario
+const char* find_newline(const char* p, const char* end) noexcept {
+#if defined(__SSE2__)
+    const __m128i newline = _mm_set1_epi8('\n');
+    while (p + 16 <= end) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        unsigned found = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, newline)));
+        if (found) return p + __builtin_ctz(found);
+        p += 16;
+    }
+#endif
+    while (p < end && *p != '\n') p++;
+    return p;
+}
+
+// Fin del tramo [a-zA-Z0-9_] que empieza en p
+const char* skip_identifier(const char* p, const char* end) noexcept {
+#if defined(__SSE2__)
+    // Comparaciones con signo: los bytes >= 0x80 son negativos y quedan fuera de todo rango
+    auto in_range = [](__m128i chunk, char low, char high) {
+        return _mm_and_si128(_mm_cmpgt_epi8(chunk, _mm_set1_epi8(low - 1)),
+                             _mm_cmpgt_epi8(_mm_set1_epi8(high + 1), chunk));
+    };
+    const __m128i case_bit = _mm_set1_epi8(0x20);
+    const __m128i underscore = _mm_set1_epi8('_');
+    while (p + 16 <= end) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        __m128i letters = in_range(_mm_or_si128(chunk, case_bit), 'a', 'z');
+        __m128i ident = _mm_or_si128(_mm_or_si128(letters, in_range(chunk, '0', '9')),
+                                     _mm_cmpeq_epi8(chunk, underscore));
+        unsigned others = ~static_cast<unsigned>(_mm_movemask_epi8(ident)) & 0xFFFF;
+        if (others) return p + __builtin_ctz(others);
+        p += 16;
+    }
+#endif
+    while (p < end && has_class(*p, IDENT)) p++;
+    return p;
+}
+
+// Longitud de la palabra si p empieza con ella (se detiene en el primer byte
+// distinto, así que nunca lee más allá de los centinelas)
+std::size_t match_word(const char* p, const char* word) noexcept {
+    std::size_t i = 0;
+    for (; word[i] != '\0'; i++) {
+        if (p[i] != word[i]) return 0;
+    }
+    return i;
+}
+
+struct Candidate {
+    std::size_t length = 0;
+    int token = 0;
+};
+
+// Regla de longitud length y token dado, en orden de aparición en scanner.flex:
+// solo reemplaza a la actual si es estrictamente más larga
+void consider(Candidate& best, std::size_t length, int token) noexcept {
+    if (length > best.length) {
+        best.length = length;
+        best.token = token;
+    }
+}
+
+// Longitud de TOKEN_NOTA_COMPLETA con un nombre de name_length bytes: nombre [#b♭]? [0-9]
+std::size_t full_note_length(const char* p, std::size_t name_length) noexcept {
+    if (name_length == 0) return 0;
+    const char* after = p + name_length;
+    if (has_class(after[0], DIGIT)) return name_length + 1;
+    if (has_class(after[0], ALTER) && has_class(after[1], DIGIT)) return name_length + 2;
+    return 0;
+}
+
+// Token que empieza con una letra o '_': palabras clave, notas, bemol,
+// nota completa o identificador. Se despacha por el primer byte y, dentro de
+// cada caso, las reglas se consideran en el orden de scanner.flex.
+Candidate scan_word(const char* p, const char* end) noexcept {
+    Candidate best;
+    std::size_t latin_length = 0;    // Nombre latino (Do..Si) al inicio, si lo hay
+    std::size_t english_length = 0;  // Letra inglesa (C..B) al inicio, si la hay
+
+    auto note = [&](const char* latin, bool english, int token) {
+        std::size_t length = match_word(p, latin);
+        consider(best, length, token);
+        latin_length = length ? length : latin_length;
+        if (english) {
+            consider(best, 1, token);
+            english_length = 1;
+        }
+    };
+
+    switch (*p) {
+        case 'T':
+            consider(best, match_word(p, "Tonalidad"), TOKEN_TONALIDAD);
+            consider(best, match_word(p, "Tempo"), TOKEN_TEMPO);
+            break;
+        case 'C':
+            consider(best, match_word(p, "Compas"), TOKEN_COMPAS);
+            consider(best, match_word(p, "Corchea"), TOKEN_CORCHEA);
+            note("", true, TOKEN_NOTA_DO);
+            break;
+        case 'B':
+            consider(best, match_word(p, "Blanca"), TOKEN_BLANCA);
+            note("", true, TOKEN_NOTA_SI);
+            break;
+        case 'N':
+            consider(best, match_word(p, "Negra"), TOKEN_NEGRA);
+            break;
+        case 'S':
+            consider(best, match_word(p, "Semicorchea"), TOKEN_SEMICORCHEA);
+            note("Sol", false, TOKEN_NOTA_SOL);
+            note("Si", false, TOKEN_NOTA_SI);
+            break;
+        case 'M':
+            consider(best, 1, TOKEN_MAYOR);
+            note("Mi", false, TOKEN_NOTA_MI);
+            break;
+        case 'm':
+            consider(best, 1, TOKEN_MENOR);
+            break;
+        case 'D':
+            note("Do", false, TOKEN_NOTA_DO);
+            note("", true, TOKEN_NOTA_RE);
+            break;
+        case 'R':
+            note("Re", false, TOKEN_NOTA_RE);
+            break;
+        case 'E':
+            note("", true, TOKEN_NOTA_MI);
+            break;
+        case 'F':
+            note("Fa", true, TOKEN_NOTA_FA);
+            break;
+        case 'G':
+            note("", true, TOKEN_NOTA_SOL);
+            break;
+        case 'L':
+            note("La", false, TOKEN_NOTA_LA);
+            break;
+        case 'A':
+            note("", true, TOKEN_NOTA_LA);
+            break;
+        case 'b':
+            consider(best, 1, TOKEN_BEMOL);
+            break;
+        default:
+            break;
+    }
+
+    consider(best, full_note_length(p, english_length), TOKEN_NOTA_COMPLETA);
+    consider(best, full_note_length(p, latin_length), TOKEN_NOTA_COMPLETA);
+
+    consider(best, skip_identifier(p, end) - p, TOKEN_IDENTIFIER);
+    return best;
+}
+
+}  // namespace
+
+int yylex_init_extra(MusicParser* user_defined, yyscan_t* scanner) {
+    if (!scanner) return 1;
+    HandLexer* lexer = new HandLexer;
+    lexer->extra = user_defined;
+    *scanner = lexer;
+    return 0;
+}
+
+int yylex_destroy(yyscan_t scanner) {
+    delete get_lexer(scanner);
+    return 0;
+}
+
+void yyset_in(FILE* input, yyscan_t scanner) {
+    get_lexer(scanner)->input = input;
+}
+
+char* yyget_text(yyscan_t scanner) {
+    return get_lexer(scanner)->text;
+}
+
+YY_BUFFER_STATE yy_scan_buffer(char* base, std::size_t size, yyscan_t scanner) {
+    // Mismo contrato que flex: los dos últimos bytes deben ser '\0'
+    if (size < 2 || base[size - 2] != '\0' || base[size - 1] != '\0') {
+        return nullptr;
+    }
+
+    HandLexer* lexer = get_lexer(scanner);
+    lexer->buffer = {base, size};
+    lexer->begin = base;
+    lexer->cursor = base;
+    lexer->end = base + size - 2;
+    lexer->loaded = true;
+    return &lexer->buffer;
+}
+
+int yylex(YYSTYPE* lvalp, yyscan_t scanner) {
+    (void)lvalp;
+    HandLexer& lexer = *get_lexer(scanner);
+    if (!lexer.loaded) {
+        load_stream(lexer);
+        lexer.loaded = true;
+    }
+
+    // Restaurar el byte que ocupaba el '\0' del token anterior
+    if (lexer.text_end) {
+        *lexer.text_end = lexer.hold_char;
+        lexer.text_end = nullptr;
+    }
+
+    char* p = lexer.cursor;
+    while (p < lexer.end) {
+        Candidate token;
+        const char c = *p;
+
+        if (has_class(c, SPACE)) {
+            p = const_cast<char*>(skip_spaces(p, lexer.end));
+            continue;
+        } else if (c == '/') {
+            if (p + 1 < lexer.end && p[1] == '/') {
+                token = {static_cast<std::size_t>(find_newline(p + 2, lexer.end) - p), TOKEN_COMENTARIO};
+            } else {
+                token = {1, TOKEN_BARRA};
+            }
+        } else if (has_class(c, DIGIT) || (c == '-' && p + 1 < lexer.end && has_class(p[1], DIGIT))) {
+            const char* q = p + 1;
+            while (q < lexer.end && has_class(*q, DIGIT)) q++;
+            token = {static_cast<std::size_t>(q - p), TOKEN_NUMERO};
+        } else if (has_class(c, IDENT_START)) {
+            token = scan_word(p, lexer.end);
+        } else if (c == '#') {
+            token = {1, TOKEN_SOSTENIDO};
+        } else if (match_word(p, "♭") && p + 3 <= lexer.end) {
+            token = {3, TOKEN_BEMOL};
+        } else {
+            // Cualquier otro byte se ignora (regla "." de scanner.flex)
+            p++;
+            continue;
+        }
+
+        lexer.text = p;
+        lexer.text_end = p + token.length;
+        lexer.hold_char = *lexer.text_end;
+        *lexer.text_end = '\0';
+        lexer.cursor = lexer.text_end;
+
+        if (token.token == TOKEN_IDENTIFIER) {
+            lexer.extra->token_name = intern_name(std::string_view(p, token.length));
+        }
+        lexer.extra->token_offset = static_cast<unsigned int>(p - lexer.begin);
+        lexer.extra->input_offset = static_cast<unsigned int>(lexer.cursor - lexer.begin);
+        return token.token;
+    }
+
+    lexer.cursor = p;
+    lexer.extra->input_offset = static_cast<unsigned int>(p - lexer.begin);
+    return 0;
+}
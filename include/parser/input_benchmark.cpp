@@ -0,0 +1,120 @@
+/*
+    Compilador Musical: Benchmark de lectura de la entrada
+
+    Genera una partitura de N MB en un archivo temporal (o usa la indicada) y
+    la analiza completa con:
+      - lectura por flujo (fopen + búfer de stdio, camino anterior)
+      - archivo proyectado en memoria (mmap + yy_scan_buffer)
+    Cada modo se repite varias veces y se informa el mejor tiempo en MB/s.
+
+    Uso: ./input_benchmark [megabytes] [repeticiones] [archivo.mus]
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include "music_parser.hpp"
+
+extern int yydebug;
+
+using Clock = std::chrono::steady_clock;
+
+static const char* pitches[] = {"Do", "Re", "Mi", "Fa", "Sol", "La", "Si"};
+static const char* alterations[] = {"", "#", "b"};
+static const char* durations[] = {"Blanca", "Negra", "Corchea", "Semicorchea"};
+
+static bool write_score(const std::string& path, long megabytes) {
+    FILE* file = fopen(path.c_str(), "w");
+    if (!file) return false;
+
+    fputs("Tempo 120\nCompas 4/4\nTonalidad Do M\n", file);
+    const long target = megabytes * 1024 * 1024;
+    long written = 0;
+    for (long i = 0; written < target; ++i) {
+        int length = fprintf(file, "%s%s%ld %s\n", pitches[i % 7], alterations[i % 3], i % 9, durations[i % 4]);
+        if (i % 64 == 0) {
+            length += fprintf(file, "// compás %ld\n", i / 64);
+        }
+        written += length;
+    }
+
+    fclose(file);
+    return true;
+}
+
+static void run_mode(MusicParser& parser, const std::string& path, MusicParser::InputMode mode,
+                     const char* label, double megabytes, int repetitions) {
+    double best_ms = 0;
+    std::size_t notes = 0;
+    bool success = true;
+
+    for (int r = 0; r < repetitions; ++r) {
+        auto start = Clock::now();
+        MusicProgram* program = parser.parseFile(path.c_str(), mode);
+        auto end = Clock::now();
+
+        double ms = std::chrono::duration<double, std::milli>(end - start).count();
+        best_ms = r == 0 ? ms : std::min(best_ms, ms);
+
+        success = success && program;
+        if (program) {
+            notes = program->getNoteCount();
+            program->destroy();
+            delete program;
+        }
+    }
+
+    std::cout << std::setw(22) << std::left << label
+              << " | " << std::setw(10) << std::right << std::fixed << std::setprecision(2) << best_ms << " ms"
+              << " | " << std::setw(8) << std::setprecision(1) << megabytes / (best_ms / 1000.0) << " MB/s"
+              << " | " << notes << " notas"
+              << " | " << (success ? "✓ ÉXITO" : "✗ ERROR") << std::endl;
+}
+
+int main(int argc, char** argv) {
+    yydebug = 0;
+
+    long megabytes = argc > 1 ? atol(argv[1]) : 64;
+    int repetitions = argc > 2 ? atoi(argv[2]) : 3;
+    if (megabytes <= 0 || repetitions <= 0) {
+        std::cerr << "Uso: " << argv[0] << " [megabytes] [repeticiones] [archivo.mus]" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::string path = argc > 3 ? argv[3] : "/tmp/input_benchmark_" + std::to_string(getpid()) + ".mus";
+    bool generated = argc <= 3;
+    if (generated && !write_score(path, megabytes)) {
+        std::cerr << "No se pudo crear " << path << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    FILE* file = fopen(path.c_str(), "r");
+    if (!file) {
+        std::cerr << "No se pudo abrir " << path << std::endl;
+        return EXIT_FAILURE;
+    }
+    fseek(file, 0, SEEK_END);
+    double size_mb = ftell(file) / (1024.0 * 1024.0);
+    fclose(file);
+
+    std::cout << "====== Benchmark de lectura de la entrada (" << std::fixed << std::setprecision(1)
+              << size_mb << " MB, mejor de " << repetitions << ") ======" << std::endl;
+
+    MusicParser parser;
+    // Pasada de calentamiento para que ambos modos lean desde la caché de páginas
+    run_mode(parser, path, MusicParser::InputMode::Stream, "calentamiento", size_mb, 1);
+    run_mode(parser, path, MusicParser::InputMode::Stream, "fopen (stdio)", size_mb, repetitions);
+    run_mode(parser, path, MusicParser::InputMode::Mapped, "mmap + yy_scan_buffer", size_mb, repetitions);
+
+    if (generated) {
+        unlink(path.c_str());
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,207 @@
+/*
+    Compilador Musical: Prueba diferencial del lexer escrito a mano
+
+    Compara la secuencia de tokens (token, desplazamiento y texto) de
+    scanner.flex (compilado con el prefijo difflex_) con la de hand_lexer.cpp,
+    leyendo tanto por flujo como con yy_scan_buffer, sobre:
+      - los archivos indicados (el corpus de test/parser)
+      - un corpus aleatorio generado con fragmentos de la gramática y bytes sueltos
+
+    Uso: ./lexer_diff [--fuzz N] [--seed S] [archivo.mus ...]
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "music_parser.hpp"
+#include "parser.tab.h"
+
+// Scanner de flex con prefijo propio (flex -P difflex_)
+int difflex_lex_init_extra(MusicParser* user_defined, yyscan_t* scanner);
+int difflex_lex_destroy(yyscan_t scanner);
+void difflex_set_in(FILE* input, yyscan_t scanner);
+char* difflex_get_text(yyscan_t scanner);
+int difflex_lex(YYSTYPE* lvalp, yyscan_t scanner);
+
+// Lexer escrito a mano
+int yylex(YYSTYPE* lvalp, yyscan_t scanner);
+
+struct Token {
+    int token;
+    unsigned int offset;
+    std::string text;
+
+    bool operator==(const Token& other) const {
+        return token == other.token && offset == other.offset && text == other.text;
+    }
+};
+
+static std::vector<Token> lex_flex(const std::string& input) {
+    std::vector<Token> tokens;
+    MusicParser parser;
+    yyscan_t scanner;
+    difflex_lex_init_extra(&parser, &scanner);
+
+    FILE* stream = fmemopen(const_cast<char*>(input.data()), input.size(), "r");
+    difflex_set_in(stream, scanner);
+
+    YYSTYPE value;
+    for (int token; (token = difflex_lex(&value, scanner)) != 0; ) {
+        tokens.push_back({token, parser.token_offset, difflex_get_text(scanner)});
+    }
+
+    difflex_lex_destroy(scanner);
+    fclose(stream);
+    return tokens;
+}
+
+static std::vector<Token> lex_hand(const std::string& input, bool mapped) {
+    std::vector<Token> tokens;
+    MusicParser parser;
+    yyscan_t scanner;
+    yylex_init_extra(&parser, &scanner);
+
+    std::vector<char> buffer(input.begin(), input.end());
+    buffer.push_back('\0');
+    buffer.push_back('\0');
+
+    FILE* stream = nullptr;
+    if (mapped) {
+        yy_scan_buffer(buffer.data(), buffer.size(), scanner);
+    } else {
+        stream = fmemopen(const_cast<char*>(input.data()), input.size(), "r");
+        yyset_in(stream, scanner);
+    }
+
+    YYSTYPE value;
+    for (int token; (token = yylex(&value, scanner)) != 0; ) {
+        tokens.push_back({token, parser.token_offset, yyget_text(scanner)});
+    }
+
+    yylex_destroy(scanner);
+    if (stream) fclose(stream);
+    return tokens;
+}
+
+static void print_token(const char* label, const std::vector<Token>& tokens, std::size_t index) {
+    if (index < tokens.size()) {
+        printf("   %-6s token %d en %u: \"%s\"\n", label, tokens[index].token, tokens[index].offset,
+               tokens[index].text.c_str());
+    } else {
+        printf("   %-6s (fin de la entrada)\n", label);
+    }
+}
+
+// Devuelve la cantidad de tokens comparados, o -1 si hubo diferencias
+static long compare(const std::string& name, const std::string& input) {
+    // fmemopen no acepta búferes vacíos; una entrada vacía no produce tokens
+    if (input.empty()) return 0;
+
+    std::vector<Token> expected = lex_flex(input);
+
+    for (bool mapped : {false, true}) {
+        std::vector<Token> actual = lex_hand(input, mapped);
+        if (actual == expected) continue;
+
+        std::size_t index = 0;
+        while (index < expected.size() && index < actual.size() && expected[index] == actual[index]) {
+            index++;
+        }
+        printf("❌ %s (%s): difiere en el token %zu\n", name.c_str(), mapped ? "yy_scan_buffer" : "flujo", index);
+        print_token("flex", expected, index);
+        print_token("mano", actual, index);
+        return -1;
+    }
+
+    return static_cast<long>(expected.size());
+}
+
+static std::string make_fuzz_input(std::mt19937& random) {
+    static const char* fragments[] = {
+        "Tonalidad", "Tempo", "Compas", "Blanca", "Negra", "Corchea", "Semicorchea", "M", "m",
+        "Do", "Re", "Mi", "Fa", "Sol", "La", "Si", "C", "D", "E", "F", "G", "A", "B",
+        "#", "b", "♭", "\xE2", "\x99", "\xAD", "4", "12", "-3", "-", "/", "//", "// comentario ♭\n",
+        " ", "\t", "\n", "\r", "_", "x", "Negras", "Do4", "Sol#4", "Ab3", "Mib5", "Mi♭4", "C♭4",
+        "                                     ", "\n\n\n\n\n\n\n\n\n\n\n\n\n\n\n\n\n\n",
+        "abcdefghijklmnopqrstuvwxyz_0123456789", "~", "\xC3\xA1",
+    };
+    constexpr std::size_t fragment_count = sizeof(fragments) / sizeof(fragments[0]);
+
+    std::string input;
+    std::size_t pieces = random() % 80;
+    for (std::size_t i = 0; i < pieces; i++) {
+        if (random() % 16 == 0) {
+            // Byte arbitrario distinto de '\0'
+            input += static_cast<char>(1 + random() % 255);
+        } else {
+            input += fragments[random() % fragment_count];
+        }
+    }
+    return input;
+}
+
+static bool read_file(const char* filename, std::string& content) {
+    FILE* file = fopen(filename, "rb");
+    if (!file) return false;
+
+    char chunk[4096];
+    std::size_t count;
+    while ((count = fread(chunk, 1, sizeof(chunk), file)) > 0) {
+        content.append(chunk, count);
+    }
+    fclose(file);
+    return true;
+}
+
+int main(int argc, char** argv) {
+    long fuzz_count = 10000;
+    unsigned long seed = 1;
+    std::vector<const char*> files;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--fuzz") == 0 && i + 1 < argc) {
+            fuzz_count = atol(argv[++i]);
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = strtoul(argv[++i], NULL, 10);
+        } else {
+            files.push_back(argv[i]);
+        }
+    }
+
+    long inputs = 0;
+    long tokens = 0;
+    bool success = true;
+
+    for (const char* filename : files) {
+        std::string content;
+        if (!read_file(filename, content)) {
+            printf("❌ No se pudo abrir el archivo %s\n", filename);
+            success = false;
+            continue;
+        }
+        long count = compare(filename, content);
+        success = success && count >= 0;
+        tokens += count > 0 ? count : 0;
+        inputs++;
+    }
+
+    std::mt19937 random{static_cast<std::mt19937::result_type>(seed)};
+    for (long i = 0; i < fuzz_count; i++) {
+        long count = compare("fuzz #" + std::to_string(i), make_fuzz_input(random));
+        success = success && count >= 0;
+        tokens += count > 0 ? count : 0;
+        inputs++;
+    }
+
+    if (!success) {
+        printf("❌ El lexer escrito a mano difiere de scanner.flex\n");
+        return 1;
+    }
+
+    printf("✅ %ld entradas, %ld tokens idénticos entre scanner.flex y el lexer escrito a mano\n", inputs, tokens);
+    return 0;
+}
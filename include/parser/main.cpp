@@ -1,80 +1,407 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include "expression.hpp"
+#include <glob.h>
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "ast_cache.hpp"
+#include "music_parser.hpp"
+#include "result_cache.hpp"
+#include "../Semantic_Analysis/pass_manager.hpp"
+#include "../Semantic_Analysis/stats.hpp"
+#include "../Semantic_Analysis/work_stealing_pool.hpp"
 
-extern FILE* yyin;
-extern int yyparse();
-extern int parser_result;
-extern MusicProgram* program_result;
 extern int yydebug;
 
+// Pases sobre un archivo, con un parser reutilizable. lex está deshabilitado
+// por defecto: vuelve a leer el archivo solo para medir el lexer por separado
+// (parse lo incluye, porque yyparse pide los tokens a medida que avanza).
+// Con use_ast_cache, parse lee el programa del .musc si corresponde al
+// contenido del archivo y, si no, lo analiza y escribe la caché.
+// Con una caché de resultados, run() busca el veredicto del contenido antes
+// de ejecutar ningún pase (antes de yyparse) y guarda el nuevo al terminar.
+struct FilePipeline {
+    MusicParser parser;
+    PassManager passes;
+    bool use_ast_cache = false;
+    const ResultCache* result_cache = NULL;   // Compartida entre hilos
+    const char* filename = NULL;      // NULL: entrada estándar
+    MusicProgram* program = NULL;     // Se libera al terminar run()
+    CachedProgram cached;             // Abierto si el programa vino del .musc
+    bool complete = false;
+    bool validated = false;
+    FileResult result;                // Veredicto del último run()
+    std::size_t result_hits = 0;      // Consultas a result_cache
+    std::size_t result_misses = 0;
+    std::size_t result_stores = 0;    // Veredictos guardados
+
+    FilePipeline() {
+        passes.add_pass("lex", [this]() {
+            if (filename == NULL) {
+                parser.reportError("El pase lex necesita un archivo (no se puede releer la entrada estándar)");
+                return false;
+            }
+            return parser.tokenizeFile(filename) >= 0;
+        }, false);
+        passes.add_pass("parse", [this]() {
+            if (filename == NULL) {
+                program = parser.parse(stdin);
+                return program != NULL;
+            }
+            if (!use_ast_cache) {
+                program = parser.parseFile(filename);
+                return program != NULL;
+            }
+            return parseWithCache();
+        });
+        passes.add_pass("validate", [this]() {
+            complete = program != NULL ? program->validate() : cached.isComplete();
+            validated = true;
+            return true;
+        });
+    }
+
+    FilePipeline(const FilePipeline&) = delete;
+    FilePipeline& operator=(const FilePipeline&) = delete;
+
+    // Ejecutar los pases habilitados sobre un archivo y dejar su veredicto en result
+    void run(const char* input) {
+        filename = input;
+        program = NULL;
+        cached.close();
+        complete = false;
+        validated = false;
+        result = FileResult();
+
+        std::uint64_t hash = 0;
+        std::uint64_t size = 0;
+        bool hashed = result_cache != NULL && filename != NULL && hashSourceFile(filename, hash, size);
+        if (hashed) {
+            if (result_cache->lookup(hash, size, result)) {
+                result_hits++;
+                return;
+            }
+            result_misses++;
+        }
+
+        bool parsed = passes.is_enabled("parse");
+        passes.run();
+
+        result.success = program != NULL || cached.isOpen();
+        result.complete = complete;
+        if (result.success) {
+            result.note_count = program != NULL ? program->getNoteCount() : cached.getNoteCount();
+        }
+        // Con un .musc válido el parser no se ejecuta: sus errores son de otro archivo
+        if (!cached.isOpen()) {
+            result.errors = parser.getErrors();
+        }
+        if (program != NULL) {
+            program->destroy();
+            delete program;
+            program = NULL;
+        }
+
+        // Solo se guardan veredictos completos: parse y, si tuvo éxito, validate
+        if (hashed && parsed && (!result.success || validated) && result_cache->store(hash, size, result)) {
+            result_stores++;
+        }
+    }
+
+    bool parseWithCache() {
+        std::uint64_t hash = 0;
+        std::uint64_t size = 0;
+        bool hashed = hashSourceFile(filename, hash, size);
+        std::string cache_path = cachePathFor(filename);
+        if (hashed && cached.open(cache_path.c_str(), hash, size)) {
+            count(Counter::AstCacheHit);
+            return true;
+        }
+
+        count(Counter::AstCacheMiss);
+        program = parser.parseFile(filename);
+        if (program == NULL) {
+            return false;
+        }
+        // Sin permiso de escritura simplemente no queda caché
+        if (hashed) {
+            CachedProgram::write(cache_path.c_str(), *program, hash, size);
+        }
+        return true;
+    }
+};
+
 void print_help() {
-    printf("Uso: parser [archivo]\n");
-    printf("Evalúa un archivo de notación musical.\n");
+    printf("Uso: parser [--jobs N] [--ast-cache] [--result-cache DIR] [--result-cache-entries N]\n");
+    printf("              [--time-passes] [--stats] [--disable-pass PASE] [--enable-pass PASE]\n");
+    printf("              [archivo|directorio|patrón ...]\n");
+    printf("Evalúa uno o varios archivos de notación musical.\n");
     printf("Si no se proporciona un archivo, lee desde la entrada estándar.\n");
+    printf("Con varios archivos, un directorio (*.mus) o --jobs, se analizan todos\n");
+    printf("en un solo proceso con N hilos (por defecto, todos los núcleos).\n");
+    printf("Pases: lex (deshabilitado por defecto), parse, validate. --time-passes\n");
+    printf("imprime el tiempo de cada uno (en modo por lotes, sumado entre hilos).\n");
+    printf("--stats imprime los nodos, notas y memoria contados (make STATS=0 los quita).\n");
+    printf("--ast-cache guarda el programa analizado junto a cada archivo (x.mus -> x.musc)\n");
+    printf("y lo reutiliza mientras el contenido del .mus no cambie.\n");
+    printf("--result-cache DIR guarda el veredicto del parser y de validate (el driver no\n");
+    printf("ejecuta el análisis semántico) y los errores de cada contenido en DIR\n");
+    printf("(clave: hash del contenido + versión del parser) y lo devuelve sin analizar;\n");
+    printf("se conservan unas N entradas usadas más recientemente (por defecto, 100000):\n");
+    printf("el desalojo recorre DIR cada N/64 veredictos guardados.\n");
+}
+
+const char* get_basename(const char* filename) {
+    const char* basename = filename ? strrchr(filename, '/') : NULL;
+    return basename ? basename + 1 : filename;
+}
+
+// Expande un argumento a la lista de archivos: directorios (*.mus ordenados),
+// patrones glob sin expandir por el shell o un archivo tal cual
+void collect_inputs(const char* argument, std::vector<std::string>& inputs) {
+    std::error_code error;
+    if (std::filesystem::is_directory(argument, error)) {
+        std::vector<std::string> files;
+        for (const auto& entry : std::filesystem::directory_iterator(argument, error)) {
+            if (entry.is_regular_file(error) && entry.path().extension() == ".mus") {
+                files.push_back(entry.path().string());
+            }
+        }
+        std::sort(files.begin(), files.end());
+        inputs.insert(inputs.end(), files.begin(), files.end());
+        return;
+    }
+
+    if (strpbrk(argument, "*?[") != NULL) {
+        glob_t matches;
+        if (glob(argument, 0, NULL, &matches) == 0) {
+            for (size_t i = 0; i < matches.gl_pathc; i++) {
+                inputs.push_back(matches.gl_pathv[i]);
+            }
+            globfree(&matches);
+            return;
+        }
+        globfree(&matches);
+    }
+
+    inputs.push_back(argument);
+}
+
+// Cachés que usa el driver (--ast-cache, --result-cache)
+struct CacheOptions {
+    bool ast_cache = false;
+    ResultCache* results = NULL;
+};
+
+void configure_pipeline(FilePipeline& pipeline, const PassOptions& options, const CacheOptions& caches) {
+    std::string unknown;
+    pipeline.passes.configure(options, unknown);
+    pipeline.use_ast_cache = caches.ast_cache;
+    pipeline.result_cache = caches.results;
+}
+
+// Analiza un único archivo (o stdin) con la salida detallada de siempre
+int run_single(const char* filename, const PassOptions& options, const CacheOptions& caches) {
+    FilePipeline pipeline;
+    configure_pipeline(pipeline, options, caches);
+    pipeline.run(filename);
+
+    const FileResult& result = pipeline.result;
+    for (const std::string& error : result.errors) {
+        printf("Error de parseo: %s\n", error.c_str());
+    }
+
+    const char* basename = get_basename(filename);
+    int status = 0;
+    if (!result.success) {
+        // Mostrar error con formato simple
+        printf("❌ Error: El archivo %s contiene errores de sintaxis o configuración.\n",
+               basename ? basename : "entrada");
+        status = 1;
+    } else {
+        // Salida simplificada para éxito
+        printf("✅ Archivo %s procesado correctamente.\n", basename ? basename : "entrada");
+
+        // Solo mostrar si hubo éxito en la validación
+        if (result.complete) {
+            printf("✓ Configuración completa.\n");
+        }
+        printf("✓ %zu notas leídas.\n", result.note_count);
+    }
+
+    // El directorio solo se recorre cada evictionInterval() escrituras
+    if (caches.results != NULL) {
+        caches.results->evictAfterStores(pipeline.result_stores);
+    }
+
+    if (options.time_passes) {
+        pipeline.passes.print_report(std::cout);
+    }
+    if (options.stats) {
+        print_stats(std::cout, stats_parser | stats_result_cache | stats_memory);
+        pipeline.passes.print_memory_report(std::cout);
+    }
+    return status;
+}
+
+// Analiza todos los archivos en un solo proceso; imprime en el orden de entrada
+int run_batch(const std::vector<std::string>& inputs, unsigned jobs, const PassOptions& options, const CacheOptions& caches) {
+    auto start = std::chrono::steady_clock::now();
+
+    WorkStealingPool pool{jobs};
+    std::vector<FileResult> results(inputs.size());
+
+    // Una instancia de parser (y de sus pases) por hilo, reutilizada entre archivos
+    std::vector<std::unique_ptr<FilePipeline>> pipelines;
+    for (unsigned i = 0; i < pool.get_worker_count(); i++) {
+        pipelines.push_back(std::make_unique<FilePipeline>());
+        configure_pipeline(*pipelines.back(), options, caches);
+    }
+
+    pool.run(inputs.size(), [&](std::size_t index, unsigned worker) {
+        FilePipeline& pipeline = *pipelines[worker];
+        pipeline.run(inputs[index].c_str());
+        results[index] = std::move(pipeline.result);
+    });
+
+    std::size_t valid = 0;
+    std::size_t total_notes = 0;
+    for (std::size_t i = 0; i < inputs.size(); i++) {
+        const FileResult& result = results[i];
+        if (result.success) {
+            valid++;
+            total_notes += result.note_count;
+            printf("✅ %s: %zu notas%s\n", inputs[i].c_str(), result.note_count,
+                   result.complete ? "" : " (configuración incompleta)");
+        } else {
+            printf("❌ %s: %s\n", inputs[i].c_str(),
+                   result.errors.empty() ? "errores de sintaxis o configuración" : result.errors.front().c_str());
+            for (std::size_t e = 1; e < result.errors.size(); e++) {
+                printf("   %s\n", result.errors[e].c_str());
+            }
+        }
+    }
+
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    printf("\nResumen: %zu archivos, %zu válidos, %zu con errores, %zu notas (%u hilos, %.2f ms)\n",
+           inputs.size(), valid, inputs.size() - valid, total_notes, pool.get_worker_count(), ms);
+
+    PassManager& total = pipelines.front()->passes;
+    std::size_t hits = pipelines.front()->result_hits;
+    std::size_t misses = pipelines.front()->result_misses;
+    std::size_t stores = pipelines.front()->result_stores;
+    for (std::size_t i = 1; i < pipelines.size(); i++) {
+        total.merge_timings(pipelines[i]->passes);
+        hits += pipelines[i]->result_hits;
+        misses += pipelines[i]->result_misses;
+        stores += pipelines[i]->result_stores;
+    }
+    if (caches.results != NULL) {
+        std::size_t evicted = caches.results->evictAfterStores(stores);
+        printf("Caché de resultados: %zu aciertos, %zu fallos, %zu entradas desalojadas (%s)\n",
+               hits, misses, evicted, caches.results->getDirectory().c_str());
+    }
+    if (options.time_passes) {
+        total.print_report(std::cout);
+    }
+    if (options.stats) {
+        print_stats(std::cout, stats_parser | stats_result_cache | stats_memory);
+        total.print_memory_report(std::cout);
+    }
+
+    return valid == inputs.size() ? 0 : 1;
 }
 
 int main(int argc, char** argv) {
     // Desactivar completamente la depuración
     yydebug = 0;
-    
+
     // Procesar argumentos
-    char* filename = NULL;
+    std::vector<std::string> inputs;
+    unsigned jobs = 0;
+    bool batch = false;
+    CacheOptions caches;
+    const char* result_cache_directory = NULL;
+    std::size_t result_cache_entries = ResultCache::default_max_entries;
+    PassOptions options;
     for (int i = 1; i < argc; i++) {
+        std::string error;
         if (strcmp(argv[i], "--help") == 0 || strcmp(argv[i], "-h") == 0) {
             print_help();
             return 0;
-        } else if (filename == NULL) {
-            // Primer argumento no reconocido se toma como nombre de archivo
-            filename = argv[i];
+        } else if (strcmp(argv[i], "--jobs") == 0 || strcmp(argv[i], "-j") == 0) {
+            if (i + 1 >= argc || atoi(argv[i + 1]) <= 0) {
+                printf("Error: %s requiere un número de hilos positivo\n", argv[i]);
+                return 1;
+            }
+            jobs = atoi(argv[++i]);
+            batch = true;
+        } else if (strcmp(argv[i], "--ast-cache") == 0) {
+            caches.ast_cache = true;
+        } else if (strcmp(argv[i], "--result-cache") == 0) {
+            if (i + 1 >= argc) {
+                printf("Error: %s requiere un directorio\n", argv[i]);
+                return 1;
+            }
+            result_cache_directory = argv[++i];
+        } else if (strcmp(argv[i], "--result-cache-entries") == 0) {
+            if (i + 1 >= argc || atol(argv[i + 1]) <= 0) {
+                printf("Error: %s requiere un número de entradas positivo\n", argv[i]);
+                return 1;
+            }
+            result_cache_entries = atol(argv[++i]);
+        } else if (parse_pass_option(argc, argv, i, options, error)) {
+            if (!error.empty()) {
+                printf("Error: %s\n", error.c_str());
+                return 1;
+            }
+        } else {
+            // Los argumentos no reconocidos se toman como archivos de entrada
+            std::size_t before = inputs.size();
+            collect_inputs(argv[i], inputs);
+            batch = batch || inputs.size() != before + 1 || std::filesystem::is_directory(argv[i]);
         }
     }
 
-    // Abrir archivo si se proporcionó
-    if (filename != NULL) {
-        FILE* file = fopen(filename, "r");
-        if (!file) {
-            printf("Error: No se pudo abrir el archivo %s\n", filename);
+    // Comprobar los nombres de los pases antes de analizar nada
+    {
+        FilePipeline pipeline;
+        std::string unknown;
+        if (!pipeline.passes.configure(options, unknown)) {
+            printf("Error: pase desconocido %s (pases: %s)\n", unknown.c_str(), pipeline.passes.get_pass_names().c_str());
             return 1;
         }
-        yyin = file;
-    } else {
-        // Si no hay argumento, lee desde stdin
-        yyin = stdin;
     }
 
-    // Parsear el archivo
-    int result = yyparse();
-    
-    // Cerrar el archivo si se abrió uno
-    if (filename != NULL && yyin != NULL) {
-        fclose(yyin);
+    std::unique_ptr<ResultCache> result_cache;
+    if (result_cache_directory != NULL) {
+        result_cache = std::make_unique<ResultCache>(result_cache_directory, result_cache_entries);
+        if (!result_cache->prepare()) {
+            printf("Error: no se puede usar el directorio de caché %s\n", result_cache_directory);
+            return 1;
+        }
+        caches.results = result_cache.get();
     }
 
-    if (result != 0 || parser_result != 0) {
-        // Mostrar error con formato simple
-        const char* basename = filename ? strrchr(filename, '/') : NULL;
-        basename = basename ? basename + 1 : filename;
-        printf("❌ Error: El archivo %s contiene errores de sintaxis o configuración.\n", 
-               basename ? basename : "entrada");
-        return 1;
+    if (inputs.empty()) {
+        if (batch) {
+            printf("Error: no se encontraron archivos de entrada\n");
+            return 1;
+        }
+        // Si no hay argumento, lee desde stdin
+        return run_single(NULL, options, caches);
     }
 
-    if (program_result) {
-        // Salida simplificada para éxito
-        const char* basename = filename ? strrchr(filename, '/') : NULL;
-        basename = basename ? basename + 1 : filename;
-        printf("✅ Archivo %s procesado correctamente.\n", basename ? basename : "entrada");
-        
-        // Solo mostrar si hubo éxito en la validación
-        if (program_result->validate()) {
-            printf("✓ Configuración completa.\n");
-        }
-        
-        program_result->destroy();
-        delete program_result;
+    if (!batch && inputs.size() == 1) {
+        return run_single(inputs.front().c_str(), options, caches);
     }
 
-    return 0;
-} 
\ No newline at end of file
+    return run_batch(inputs, jobs, options, caches);
+}
@@ -0,0 +1,228 @@
+#include "music_parser.hpp"
+#include "parser.tab.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+int yylex(YYSTYPE* lvalp, yyscan_t scanner);
+
+// Proyecta los size bytes de fd seguidos de los dos centinelas de flex, o
+// devuelve nullptr. El llamador libera size + 2 bytes con munmap.
+static char* map_with_sentinels(int fd, std::size_t size) noexcept {
+    // Reservar tamaño + 2 bytes anónimos (en cero) y proyectar el archivo
+    // encima: los centinelas de flex quedan siempre después del último byte,
+    // aunque el tamaño sea múltiplo de la página. MAP_PRIVATE porque flex
+    // escribe sobre el búfer; solo se copian las páginas que toca.
+    std::size_t length = size + 2;
+    void* region = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (region == MAP_FAILED) {
+        return nullptr;
+    }
+    if (mmap(region, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED, fd, 0) == MAP_FAILED) {
+        munmap(region, length);
+        return nullptr;
+    }
+    madvise(region, size, MADV_SEQUENTIAL);
+    return static_cast<char*>(region);
+}
+
+MusicParser::MusicParser() noexcept
+    : parser_result(0), program_result(nullptr),
+      current_config(nullptr), current_program(nullptr),
+      note_capacity_hint(MusicProgram::default_note_capacity),
+      temp_note(StringInterner::invalid_id), temp_mode(StringInterner::invalid_id), temp_pitch(0), temp_alteration(0),
+      temp_octave(0), temp_duration(0), temp_offset(0), temp_num(0),
+      token_name(StringInterner::invalid_id), token_offset(0), input_offset(0) {}
+
+MusicParser::~MusicParser() noexcept {
+    discardProgram();
+}
+
+void MusicParser::reset(std::size_t expected_notes) noexcept {
+    discardProgram();
+    errors.clear();
+
+    parser_result = 0;
+    program_result = nullptr;
+    note_capacity_hint = expected_notes;
+    temp_note = StringInterner::invalid_id;
+    temp_mode = StringInterner::invalid_id;
+    temp_pitch = 0;
+    temp_alteration = 0;
+    temp_octave = 0;
+    temp_duration = 0;
+    temp_offset = 0;
+    temp_num = 0;
+    token_name = StringInterner::invalid_id;
+    token_offset = 0;
+    input_offset = 0;
+}
+
+void MusicParser::discardProgram() noexcept {
+    // El programa es dueño de la configuración
+    if (current_program) {
+        current_program->destroy();
+        delete current_program;
+    } else if (current_config) {
+        current_config->destroy();
+        delete current_config;
+    }
+    current_program = nullptr;
+    current_config = nullptr;
+    program_result = nullptr;
+}
+
+MusicProgram* MusicParser::parse(FILE* input, std::size_t expected_notes) noexcept {
+    reset(expected_notes);
+
+    yyscan_t scanner;
+    if (yylex_init_extra(this, &scanner) != 0) {
+        reportError("No se pudo inicializar el scanner");
+        return nullptr;
+    }
+    yyset_in(input, scanner);
+
+    return run(scanner);
+}
+
+MusicProgram* MusicParser::parseBuffer(char* buffer, std::size_t size_with_sentinels, std::size_t expected_notes) noexcept {
+    reset(expected_notes);
+
+    yyscan_t scanner;
+    if (yylex_init_extra(this, &scanner) != 0) {
+        reportError("No se pudo inicializar el scanner");
+        return nullptr;
+    }
+
+    // flex recorre el búfer directamente; yylex_destroy libera el estado pero no el búfer
+    if (!yy_scan_buffer(buffer, size_with_sentinels, scanner)) {
+        yylex_destroy(scanner);
+        reportError("El búfer de entrada no termina en dos centinelas nulos");
+        return nullptr;
+    }
+
+    return run(scanner);
+}
+
+MusicProgram* MusicParser::run(yyscan_t scanner) noexcept {
+    int result = yyparse(scanner, this);
+    yylex_destroy(scanner);
+
+    if (result != 0 || parser_result != 0 || !program_result) {
+        discardProgram();
+        return nullptr;
+    }
+
+    // El llamador pasa a ser dueño del programa
+    MusicProgram* program = program_result;
+    current_program = nullptr;
+    current_config = nullptr;
+    program_result = nullptr;
+    return program;
+}
+
+MusicProgram* MusicParser::parseFile(const char* filename, InputMode mode) noexcept {
+    if (mode == InputMode::Mapped) {
+        int fd = open(filename, O_RDONLY);
+        if (fd < 0) {
+            reset(MusicProgram::default_note_capacity);
+            errors.push_back(std::string("No se pudo abrir el archivo ") + filename);
+            return nullptr;
+        }
+
+        struct stat info;
+        if (fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0) {
+            std::size_t size = info.st_size;
+            char* region = map_with_sentinels(fd, size);
+            if (region != nullptr) {
+                close(fd);
+                MusicProgram* program = parseBuffer(region, size + 2, size / bytes_per_note_estimate + 1);
+                munmap(region, size + 2);
+                return program;
+            }
+        }
+        close(fd);
+        // Tuberías, dispositivos y archivos vacíos se leen como flujo
+    }
+
+    FILE* file = fopen(filename, "r");
+    if (!file) {
+        reset(MusicProgram::default_note_capacity);
+        errors.push_back(std::string("No se pudo abrir el archivo ") + filename);
+        return nullptr;
+    }
+
+    // Reservar el búfer de notas una sola vez según el tamaño del archivo
+    std::size_t expected_notes = MusicProgram::default_note_capacity;
+    if (fseek(file, 0, SEEK_END) == 0) {
+        long size = ftell(file);
+        if (size > 0) {
+            expected_notes = size / bytes_per_note_estimate + 1;
+        }
+        rewind(file);
+    }
+
+    MusicProgram* program = parse(file, expected_notes);
+    fclose(file);
+    return program;
+}
+
+long MusicParser::tokenizeFile(const char* filename) noexcept {
+    reset(MusicProgram::default_note_capacity);
+
+    yyscan_t scanner;
+    if (yylex_init_extra(this, &scanner) != 0) {
+        reportError("No se pudo inicializar el scanner");
+        return -1;
+    }
+
+    int fd = open(filename, O_RDONLY);
+    struct stat info;
+    if (fd >= 0 && fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0) {
+        std::size_t size = info.st_size;
+        char* region = map_with_sentinels(fd, size);
+        if (region != nullptr) {
+            close(fd);
+            yy_scan_buffer(region, size + 2, scanner);
+            long count = tokenize(scanner);
+            munmap(region, size + 2);
+            return count;
+        }
+    }
+    if (fd >= 0) {
+        close(fd);
+    }
+
+    // Tuberías, dispositivos y archivos vacíos se leen como flujo
+    FILE* file = fopen(filename, "r");
+    if (!file) {
+        yylex_destroy(scanner);
+        errors.push_back(std::string("No se pudo abrir el archivo ") + filename);
+        return -1;
+    }
+    yyset_in(file, scanner);
+    long count = tokenize(scanner);
+    fclose(file);
+    return count;
+}
+
+long MusicParser::tokenize(yyscan_t scanner) noexcept {
+    // El lexer no construye valores semánticos: solo se cuentan los tokens
+    YYSTYPE value = nullptr;
+    long count = 0;
+    while (yylex(&value, scanner) != 0) {
+        count++;
+    }
+    yylex_destroy(scanner);
+    return count;
+}
+
+const std::vector<std::string>& MusicParser::getErrors() const noexcept {
+    return errors;
+}
+
+void MusicParser::reportError(const char* message) noexcept {
+    errors.emplace_back(message);
+}
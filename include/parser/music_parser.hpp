@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "expression.hpp"
+#include "../Semantic_Analysis/string_interner.hpp"
+
+// Manejador del scanner reentrante de flex (mismo guard que usa lex.yy.c)
+#ifndef YY_TYPEDEF_YY_SCANNER_T
+#define YY_TYPEDEF_YY_SCANNER_T
+typedef void* yyscan_t;
+#endif
+
+#ifndef YY_TYPEDEF_YY_BUFFER_STATE
+#define YY_TYPEDEF_YY_BUFFER_STATE
+typedef struct yy_buffer_state* YY_BUFFER_STATE;
+#endif
+
+// Parser reentrante de archivos .mus.
+//
+// Todo el estado del análisis vive en la instancia (no hay variables
+// globales), así que cada hilo puede usar su propio MusicParser para analizar
+// archivos en paralelo. Una instancia se puede reutilizar para varios archivos.
+class MusicParser {
+public:
+    // Bytes aproximados por nota ("Do4 Negra\n") para reservar el búfer de notas
+    static constexpr long bytes_per_note_estimate = 8;
+
+    // Forma de leer un archivo: proyectado en memoria (mmap + yy_scan_buffer,
+    // sin copiar a un búfer de stdio) o con lectura secuencial por FILE*
+    enum class InputMode { Mapped, Stream };
+
+    MusicParser() noexcept;
+    ~MusicParser() noexcept;
+
+    MusicParser(const MusicParser&) = delete;
+    MusicParser& operator=(const MusicParser&) = delete;
+
+    // Analizar una entrada abierta. Devuelve el programa (propiedad del llamador,
+    // se libera con destroy() + delete) o nullptr si hubo errores.
+    MusicProgram* parse(FILE* input, std::size_t expected_notes = MusicProgram::default_note_capacity) noexcept;
+
+    // Analizar un búfer en memoria. Los dos últimos bytes de buffer deben ser
+    // '\0' (centinelas de flex) y no forman parte de la entrada; flex escribe
+    // temporalmente sobre el búfer mientras lo recorre.
+    MusicProgram* parseBuffer(char* buffer, std::size_t size_with_sentinels,
+                              std::size_t expected_notes = MusicProgram::default_note_capacity) noexcept;
+
+    // Abrir y analizar un archivo, reservando el búfer de notas según su tamaño.
+    // Si el archivo no se puede proyectar (tubería, dispositivo, vacío) se lee
+    // como flujo.
+    MusicProgram* parseFile(const char* filename, InputMode mode = InputMode::Mapped) noexcept;
+
+    // Pasar solo el lexer sobre un archivo, leído igual que en parseFile, sin
+    // construir el programa (para medir el lexer aparte del parser). Devuelve
+    // la cantidad de tokens o -1 si no se pudo leer el archivo.
+    long tokenizeFile(const char* filename) noexcept;
+
+    // Mensajes de error del último análisis
+    const std::vector<std::string>& getErrors() const noexcept;
+
+    // Registrar un error (lo llama yyerror)
+    void reportError(const char* message) noexcept;
+
+    // Estado del análisis en curso. Lo usan las acciones de parser.bison y
+    // scanner.flex; no forma parte de la interfaz para los llamadores.
+    int parser_result;
+    MusicProgram* program_result;
+    Configuration* current_config;
+    MusicProgram* current_program;
+    std::size_t note_capacity_hint;
+
+    NameId temp_note;             // Nota de la tonalidad
+    NameId temp_mode;             // Modo de la tonalidad
+    std::uint8_t temp_pitch;      // Grado diatónico de la nota actual
+    std::int8_t temp_alteration;
+    int temp_octave;
+    std::uint16_t temp_duration;
+    std::uint32_t temp_offset;
+    int temp_num;                 // Numerador del compás
+
+    NameId token_name;            // Nombre internado del último TOKEN_IDENTIFIER
+    unsigned int token_offset;    // Desplazamiento en bytes del último token
+    unsigned int input_offset;    // Bytes consumidos por el scanner
+
+private:
+    void reset(std::size_t expected_notes) noexcept;
+
+    // yyparse sobre un scanner ya configurado; lo destruye al terminar
+    MusicProgram* run(yyscan_t scanner) noexcept;
+
+    // yylex hasta el final de la entrada; destruye el scanner al terminar
+    long tokenize(yyscan_t scanner) noexcept;
+
+    void discardProgram() noexcept;
+
+    std::vector<std::string> errors;
+};
+
+// Funciones generadas por flex (scanner reentrante)
+int yylex_init_extra(MusicParser* user_defined, yyscan_t* scanner);
+int yylex_destroy(yyscan_t scanner);
+void yyset_in(FILE* input, yyscan_t scanner);
+char* yyget_text(yyscan_t scanner);
+YY_BUFFER_STATE yy_scan_buffer(char* base, std::size_t size, yyscan_t scanner);
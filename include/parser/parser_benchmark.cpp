@@ -0,0 +1,119 @@
+/*
+    Compilador Musical: Benchmark de escalamiento del parser reentrante
+
+    Genera una partitura en memoria y la analiza como K archivos independientes
+    (fmemopen) con 1, 2, 4, ... N hilos. Cada hilo usa su propia instancia de
+    MusicParser y toma la siguiente partitura de un contador compartido.
+
+    Uso: ./parser_benchmark [partituras] [notas_por_partitura] [hilos_max]
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "music_parser.hpp"
+
+extern int yydebug;
+
+using Clock = std::chrono::steady_clock;
+
+static const char* pitches[] = {"Do", "Re", "Mi", "Fa", "Sol", "La", "Si"};
+static const char* alterations[] = {"", "#", "b"};
+static const char* durations[] = {"Blanca", "Negra", "Corchea", "Semicorchea"};
+
+static std::string make_score(long note_count) {
+    std::string score = "Tempo 120\nCompas 4/4\nTonalidad Do M\n";
+    for (long i = 0; i < note_count; ++i) {
+        score += pitches[i % 7];
+        score += alterations[i % 3];
+        score += std::to_string(i % 9);
+        score += ' ';
+        score += durations[i % 4];
+        score += '\n';
+    }
+    return score;
+}
+
+// Analiza todas las partituras con thread_count hilos; devuelve las notas leídas
+static long parse_all(const std::string& score, long score_count, unsigned thread_count, long note_count) {
+    std::atomic<long> next_score{0};
+    std::atomic<long> total_notes{0};
+
+    auto worker = [&]() {
+        MusicParser parser;
+        long notes = 0;
+        for (long i = next_score.fetch_add(1); i < score_count; i = next_score.fetch_add(1)) {
+            FILE* input = fmemopen(const_cast<char*>(score.data()), score.size(), "r");
+            if (!input) continue;
+
+            MusicProgram* program = parser.parse(input, note_count + 1);
+            fclose(input);
+            if (program) {
+                notes += program->getNoteCount();
+                program->destroy();
+                delete program;
+            }
+        }
+        total_notes += notes;
+    };
+
+    std::vector<std::thread> threads;
+    for (unsigned i = 1; i < thread_count; ++i) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    return total_notes;
+}
+
+int main(int argc, char** argv) {
+    yydebug = 0;
+
+    long score_count = argc > 1 ? atol(argv[1]) : 256;
+    long note_count = argc > 2 ? atol(argv[2]) : 10000;
+    unsigned max_threads = argc > 3 ? static_cast<unsigned>(atol(argv[3])) : std::thread::hardware_concurrency();
+    if (score_count <= 0 || note_count <= 0) {
+        std::cerr << "Uso: " << argv[0] << " [partituras] [notas_por_partitura] [hilos_max]" << std::endl;
+        return EXIT_FAILURE;
+    }
+    max_threads = std::max(max_threads, 1u);
+
+    std::cout << "====== Benchmark del parser reentrante (" << score_count << " partituras x "
+              << note_count << " notas) ======" << std::endl;
+
+    const std::string score = make_score(note_count);
+    const long expected_notes = score_count * note_count;
+    double baseline_ms = 0;
+
+    for (unsigned thread_count = 1; ; thread_count = std::min(thread_count * 2, max_threads)) {
+        auto start = Clock::now();
+        long notes = parse_all(score, score_count, thread_count, note_count);
+        auto end = Clock::now();
+
+        double ms = std::chrono::duration<double, std::milli>(end - start).count();
+        if (thread_count == 1) baseline_ms = ms;
+
+        std::cout << std::setw(3) << std::right << thread_count << " hilo(s)"
+                  << " | " << std::setw(10) << std::fixed << std::setprecision(2) << ms << " ms"
+                  << " | " << std::setw(8) << std::setprecision(1)
+                  << (score.size() * score_count) / (ms * 1000.0) << " MB/s"
+                  << " | x" << std::setprecision(2) << baseline_ms / ms
+                  << " | " << (notes == expected_notes ? "✓ ÉXITO" : "✗ ERROR") << std::endl;
+
+        if (thread_count == max_threads) break;
+    }
+
+    return EXIT_SUCCESS;
+}
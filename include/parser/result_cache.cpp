@@ -0,0 +1,249 @@
+#include "result_cache.hpp"
+
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <utility>
+
+#include "ast_cache.hpp"
+#include "../Semantic_Analysis/stats.hpp"
+
+// Las entradas más grandes que esto se consideran dañadas
+static constexpr std::size_t max_entry_size = 1 << 20;
+
+// Un temporal de store() más viejo que esto quedó de un proceso interrumpido
+// entre mkstemp y rename: evict() lo borra
+static constexpr std::chrono::seconds temporary_grace{60};
+
+enum ResultFlags : std::uint32_t {
+    result_success = 1,
+    result_complete = 2
+};
+
+const char* ResultCache::versionStamp() noexcept {
+    return compilerVersionStamp();
+}
+
+ResultCache::ResultCache(std::string directory, std::size_t max_entries)
+    : directory(std::move(directory)), max_entries(max_entries),
+      version_hash(contentHash(versionStamp(), std::strlen(versionStamp()))) {}
+
+bool ResultCache::prepare() const noexcept {
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    return std::filesystem::is_directory(directory, error);
+}
+
+const std::string& ResultCache::getDirectory() const noexcept {
+    return directory;
+}
+
+std::string ResultCache::entryPath(std::uint64_t source_hash, std::uint64_t source_size) const {
+    // La clave combina el contenido con la versión: otra versión, otra entrada
+    const std::uint64_t parts[3] = {source_hash, source_size, version_hash};
+    std::uint64_t key = contentHash(parts, sizeof(parts));
+
+    char name[32];
+    snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(key));
+    return directory + "/" + std::string(name, 2) + "/" + name + ".res";
+}
+
+bool ResultCache::lookup(std::uint64_t source_hash, std::uint64_t source_size, FileResult& result) const noexcept {
+    std::string path = entryPath(source_hash, source_size);
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        count(Counter::ResultCacheMiss);
+        return false;
+    }
+
+    struct stat info;
+    std::vector<char> data;
+    if (fstat(fd, &info) == 0 && info.st_size >= static_cast<off_t>(sizeof(Header))
+        && static_cast<std::size_t>(info.st_size) <= max_entry_size) {
+        data.resize(info.st_size);
+        if (read(fd, data.data(), data.size()) != static_cast<ssize_t>(data.size())) {
+            data.clear();
+        }
+    }
+
+    // Verificar el contenido completo antes de tocar result; una entrada de
+    // otra versión o dañada cuenta como fallo y se sobrescribe al guardar
+    Header header{};
+    bool valid = !data.empty();
+    if (valid) {
+        std::memcpy(&header, data.data(), sizeof(header));
+        valid = header.magic == magic && header.format_version == format_version
+            && header.version_hash == version_hash
+            && header.source_hash == source_hash && header.source_size == source_size;
+    }
+
+    std::vector<std::string> errors;
+    std::size_t position = sizeof(Header);
+    for (std::uint32_t i = 0; valid && i < header.error_count; i++) {
+        std::uint32_t length = 0;
+        valid = position + sizeof(length) <= data.size();
+        if (valid) {
+            std::memcpy(&length, data.data() + position, sizeof(length));
+            position += sizeof(length);
+            valid = length <= data.size() - position;
+        }
+        if (valid) {
+            errors.emplace_back(data.data() + position, length);
+            position += length;
+        }
+    }
+    valid = valid && position == data.size();
+
+    if (!valid) {
+        close(fd);
+        count(Counter::ResultCacheMiss);
+        return false;
+    }
+
+    // Marcar la entrada como usada recientemente (la fecha ordena el desalojo)
+    futimens(fd, nullptr);
+    close(fd);
+
+    result.success = header.flags & result_success;
+    result.complete = header.flags & result_complete;
+    result.note_count = header.note_count;
+    result.errors = std::move(errors);
+    count(Counter::ResultCacheHit);
+    return true;
+}
+
+bool ResultCache::store(std::uint64_t source_hash, std::uint64_t source_size, const FileResult& result) const noexcept {
+    Header header{};
+    header.magic = magic;
+    header.format_version = format_version;
+    header.version_hash = version_hash;
+    header.source_hash = source_hash;
+    header.source_size = source_size;
+    header.note_count = result.note_count;
+    header.flags = (result.success ? result_success : 0) | (result.complete ? result_complete : 0);
+    header.error_count = result.errors.size();
+
+    std::string data(reinterpret_cast<const char*>(&header), sizeof(header));
+    for (const std::string& error : result.errors) {
+        std::uint32_t length = error.size();
+        data.append(reinterpret_cast<const char*>(&length), sizeof(length));
+        data.append(error);
+    }
+    if (data.size() > max_entry_size) {
+        return false;
+    }
+
+    std::string path = entryPath(source_hash, source_size);
+    std::string parent = path.substr(0, path.rfind('/'));
+    mkdir(parent.c_str(), 0755);
+
+    // Temporal único aunque otro hilo o proceso guarde el mismo contenido
+    std::string temporary = path + ".XXXXXX";
+    int fd = mkstemp(temporary.data());
+    if (fd < 0) {
+        return false;
+    }
+    fchmod(fd, 0644);   // mkstemp crea el archivo con 0600
+
+    bool written = write(fd, data.data(), data.size()) == static_cast<ssize_t>(data.size());
+    written = close(fd) == 0 && written;
+    if (!written || rename(temporary.c_str(), path.c_str()) != 0) {
+        unlink(temporary.c_str());
+        return false;
+    }
+    count(Counter::ResultCacheStore);
+    return true;
+}
+
+std::size_t ResultCache::evict() const noexcept {
+    struct Entry {
+        std::filesystem::file_time_type used;
+        std::filesystem::path path;
+    };
+
+    std::error_code error;
+    std::vector<Entry> entries;
+    std::vector<std::filesystem::path> stale;
+    const auto stale_before = std::filesystem::file_time_type::clock::now() - temporary_grace;
+    for (auto it = std::filesystem::recursive_directory_iterator(directory, error);
+         !error && it != std::filesystem::recursive_directory_iterator(); it.increment(error)) {
+        if (!it->is_regular_file(error)) {
+            error.clear();
+            continue;
+        }
+        std::filesystem::file_time_type used = it->last_write_time(error);
+        if (!error && it->path().extension() == ".res") {
+            entries.push_back(Entry{used, it->path()});
+        }
+        // <clave>.res.XXXXXX: temporal de store(); los recientes pueden estar escribiéndose
+        else if (!error && it->path().stem().extension() == ".res" && used < stale_before) {
+            stale.push_back(it->path());
+        }
+        error.clear();
+    }
+
+    for (const std::filesystem::path& path : stale) {
+        std::filesystem::remove(path, error);
+    }
+
+    if (entries.size() <= max_entries) {
+        return 0;
+    }
+
+    // Basta con separar las excess más antiguas, sin ordenar el resto
+    std::size_t excess = entries.size() - max_entries;
+    std::nth_element(entries.begin(), entries.begin() + excess, entries.end(),
+                     [](const Entry& a, const Entry& b) { return a.used < b.used; });
+
+    std::size_t removed = 0;
+    for (std::size_t i = 0; i < excess; i++) {
+        removed += std::filesystem::remove(entries[i].path, error);
+    }
+    count(Counter::ResultCacheEvicted, removed);
+    return removed;
+}
+
+std::size_t ResultCache::evictAfterStores(std::size_t stored) const noexcept {
+    if (stored == 0) {
+        return 0;
+    }
+
+    // El contador es compartido por todos los procesos que usan el directorio:
+    // leer y escribir con el archivo bloqueado
+    std::string path = directory + "/stores";
+    int fd = open(path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (fd < 0) {
+        return 0;
+    }
+    if (flock(fd, LOCK_EX) != 0) {
+        close(fd);
+        return 0;
+    }
+
+    std::uint64_t pending = 0;
+    if (pread(fd, &pending, sizeof(pending), 0) != static_cast<ssize_t>(sizeof(pending))) {
+        pending = 0;   // Recién creado o dañado: se empieza de cero
+    }
+    pending += stored;
+    bool due = pending >= evictionInterval();
+    if (due) {
+        pending = 0;
+    }
+    ssize_t written = pwrite(fd, &pending, sizeof(pending), 0);
+    (void)written;   // Si no se pudo escribir, a lo sumo se desaloja antes
+    close(fd);
+
+    return due ? evict() : 0;
+}
+
+std::size_t ResultCache::evictionInterval() const noexcept {
+    return std::max<std::size_t>(1, max_entries / 64);
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Veredicto de un archivo: lo que el driver imprime al terminar. Es el del
+// parser y del pase validate; el driver no ejecuta el análisis semántico
+// (Semantic_Analysis no recibe el programa del parser), así que no hay
+// veredicto semántico que guardar.
+struct FileResult {
+    bool success = false;             // Análisis sin errores
+    bool complete = false;            // Configuración completa (validate)
+    std::size_t note_count = 0;
+    std::vector<std::string> errors;  // Diagnósticos del parser, en orden
+};
+
+// Caché de resultados direccionada por contenido.
+//
+// Cada entrada guarda el veredicto de un archivo (FileResult) bajo una clave
+// derivada del hash del contenido, su tamaño y la marca de versión del
+// compilador, así que dos archivos idénticos comparten la entrada y una
+// versión nueva del parser no reutiliza veredictos viejos. Las entradas viven
+// en DIR/xx/<clave>.res (xx: dos primeros dígitos, para no acumular decenas
+// de miles de archivos en un solo directorio) y se escriben con un temporal +
+// rename, así que varios hilos o procesos pueden compartir el directorio.
+//
+// Desalojo: cada acierto actualiza la fecha de modificación de la entrada y
+// evict() borra las menos usadas recientemente hasta dejar max_entries.
+// evict() recorre todo el directorio, así que el driver no lo llama tras cada
+// archivo: evictAfterStores() suma las escrituras en un contador compartido
+// (DIR/stores) y solo desaloja cada evictionInterval() escrituras, de modo que
+// la caché puede pasarse de max_entries en menos de un intervalo.
+class ResultCache {
+public:
+    static constexpr std::uint32_t magic = 0x5253554D;   // "MUSR"
+    static constexpr std::uint32_t format_version = 1;
+    static constexpr std::size_t default_max_entries = 100000;
+
+    // Marca de versión del compilador (compilerVersionStamp, la misma del .musc)
+    static const char* versionStamp() noexcept;
+
+    explicit ResultCache(std::string directory, std::size_t max_entries = default_max_entries);
+
+    // Crear el directorio si no existe. false si no se puede usar.
+    bool prepare() const noexcept;
+
+    // Buscar el veredicto del contenido con ese hash y tamaño
+    bool lookup(std::uint64_t source_hash, std::uint64_t source_size, FileResult& result) const noexcept;
+
+    // Guardar un veredicto; false si no se pudo escribir (la caché es opcional)
+    bool store(std::uint64_t source_hash, std::uint64_t source_size, const FileResult& result) const noexcept;
+
+    // Borrar las entradas menos usadas recientemente hasta dejar max_entries,
+    // y los temporales de store() abandonados (*.res.*, de más de un minuto).
+    // Devuelve la cantidad de entradas borradas (sin contar los temporales).
+    std::size_t evict() const noexcept;
+
+    // Sumar stored escrituras al contador del directorio y, si se completó
+    // un intervalo, ponerlo a cero y llamar a evict(). Devuelve las borradas.
+    std::size_t evictAfterStores(std::size_t stored) const noexcept;
+
+    // Escrituras entre dos desalojos: max_entries / 64, al menos 1
+    std::size_t evictionInterval() const noexcept;
+
+    const std::string& getDirectory() const noexcept;
+
+private:
+    struct Header {
+        std::uint32_t magic;
+        std::uint32_t format_version;
+        std::uint64_t version_hash;
+        std::uint64_t source_hash;
+        std::uint64_t source_size;
+        std::uint64_t note_count;
+        std::uint32_t flags;          // success | complete
+        std::uint32_t error_count;    // Seguido de (uint32 longitud + bytes) por error
+    };
+
+    std::string entryPath(std::uint64_t source_hash, std::uint64_t source_size) const;
+
+    std::string directory;
+    std::size_t max_entries;
+    std::uint64_t version_hash;
+};
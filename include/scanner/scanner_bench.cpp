@@ -0,0 +1,163 @@
+/*
+    Compilador Musical: Benchmark de rendimiento del lexer
+
+    Genera una entrada .mus sintética en memoria y la recorre con el lexer del
+    parser (scanner.flex o el lexer escrito a mano, según LEXER) sin imprimir
+    los tokens. Tras unas pasadas de calentamiento repite la medición y
+    reporta tokens/s, MB/s y ns/token (mediana), junto con mínimo, media y
+    desviación estándar de los tiempos.
+
+    Uso: ./scanner_bench [--size MB] [--latin P] [--alter P] [--comments P]
+                         [--reps N] [--warmup N] [--seed S]
+      --latin     proporción de notas con nombre latino (Do..Si) frente a inglés (C..B)
+      --alter     proporción de notas con alteración (#, b, ♭)
+      --comments  proporción de líneas de comentario
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "music_parser.hpp"
+#include "parser.tab.h"
+
+int yylex(YYSTYPE* lvalp, yyscan_t scanner);
+
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+    double megabytes = 16;
+    double latin_ratio = 0.5;
+    double alteration_ratio = 0.3;
+    double comment_ratio = 0.1;
+    int repetitions = 10;
+    int warmup = 2;
+    unsigned long seed = 1;
+};
+
+static void usage(char* argv[]) {
+    printf("Uso: %s [--size MB] [--latin P] [--alter P] [--comments P] [--reps N] [--warmup N] [--seed S]\n", argv[0]);
+    exit(1);
+}
+
+static std::string make_input(const Options& options) {
+    static const char* latin_names[] = {"Do", "Re", "Mi", "Fa", "Sol", "La", "Si"};
+    static const char* english_names[] = {"C", "D", "E", "F", "G", "A", "B"};
+    static const char* alterations[] = {"#", "b", "♭"};
+    static const char* durations[] = {"Blanca", "Negra", "Corchea", "Semicorchea"};
+
+    std::mt19937 random{static_cast<std::mt19937::result_type>(options.seed)};
+    std::uniform_real_distribution<double> chance{0.0, 1.0};
+
+    const std::size_t target = static_cast<std::size_t>(options.megabytes * 1024 * 1024);
+    std::string input = "Tempo 120\nCompas 4/4\nTonalidad Do M\n";
+    input.reserve(target + 64);
+
+    while (input.size() < target) {
+        if (chance(random) < options.comment_ratio) {
+            input += "// compás ";
+            input += std::to_string(random() % 1000);
+            input += " con un comentario de ejemplo\n";
+            continue;
+        }
+
+        input += chance(random) < options.latin_ratio ? latin_names[random() % 7] : english_names[random() % 7];
+        if (chance(random) < options.alteration_ratio) {
+            input += alterations[random() % 3];
+        }
+        input += static_cast<char>('0' + random() % 9);
+        input += ' ';
+        input += durations[random() % 4];
+        input += '\n';
+    }
+
+    return input;
+}
+
+// Recorre el búfer completo; devuelve la cantidad de tokens
+static long lex_all(std::vector<char>& buffer) {
+    MusicParser parser;
+    yyscan_t scanner;
+    if (yylex_init_extra(&parser, &scanner) != 0) return -1;
+    if (!yy_scan_buffer(buffer.data(), buffer.size(), scanner)) {
+        yylex_destroy(scanner);
+        return -1;
+    }
+
+    long tokens = 0;
+    YYSTYPE value;
+    while (yylex(&value, scanner) != 0) {
+        tokens++;
+    }
+
+    yylex_destroy(scanner);
+    return tokens;
+}
+
+int main(int argc, char* argv[]) {
+    Options options;
+    for (int i = 1; i < argc; i++) {
+        if (i + 1 >= argc) usage(argv);
+        if (strcmp(argv[i], "--size") == 0) options.megabytes = atof(argv[++i]);
+        else if (strcmp(argv[i], "--latin") == 0) options.latin_ratio = atof(argv[++i]);
+        else if (strcmp(argv[i], "--alter") == 0) options.alteration_ratio = atof(argv[++i]);
+        else if (strcmp(argv[i], "--comments") == 0) options.comment_ratio = atof(argv[++i]);
+        else if (strcmp(argv[i], "--reps") == 0) options.repetitions = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--warmup") == 0) options.warmup = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--seed") == 0) options.seed = strtoul(argv[++i], NULL, 10);
+        else usage(argv);
+    }
+    if (options.megabytes <= 0 || options.repetitions <= 0 || options.warmup < 0) usage(argv);
+
+    const std::string input = make_input(options);
+    const double size_mb = input.size() / (1024.0 * 1024.0);
+    printf("====== Benchmark del lexer (%.1f MB, latín %.0f%%, alteraciones %.0f%%, comentarios %.0f%%) ======\n",
+           size_mb, options.latin_ratio * 100, options.alteration_ratio * 100, options.comment_ratio * 100);
+
+    // El lexer escribe temporalmente sobre el búfer: se restaura antes de cada pasada
+    std::vector<char> buffer(input.size() + 2, '\0');
+    std::vector<double> times;
+    long tokens = 0;
+
+    for (int run = 0; run < options.warmup + options.repetitions; run++) {
+        memcpy(buffer.data(), input.data(), input.size());
+
+        auto start = Clock::now();
+        long count = lex_all(buffer);
+        auto end = Clock::now();
+
+        if (count < 0 || (tokens != 0 && count != tokens)) {
+            printf("✗ ERROR: el lexer no produjo una cantidad estable de tokens\n");
+            return 1;
+        }
+        tokens = count;
+        if (run >= options.warmup) {
+            times.push_back(std::chrono::duration<double>(end - start).count());
+        }
+    }
+
+    std::sort(times.begin(), times.end());
+    const double median = times[times.size() / 2];
+    double mean = 0;
+    for (double time : times) mean += time;
+    mean /= times.size();
+    double variance = 0;
+    for (double time : times) variance += (time - mean) * (time - mean);
+    const double stddev = std::sqrt(variance / times.size());
+
+    printf("%-12s %ld\n", "tokens", tokens);
+    printf("%-12s %.2f ms (mín %.2f, media %.2f, desv %.2f, %d repeticiones)\n", "tiempo",
+           median * 1e3, times.front() * 1e3, mean * 1e3, stddev * 1e3, options.repetitions);
+    printf("%-12s %.2f M tokens/s\n", "tokens/s", tokens / median / 1e6);
+    printf("%-12s %.1f MB/s\n", "bytes/s", size_mb / median);
+    printf("%-12s %.2f ns\n", "ns/token", median * 1e9 / tokens);
+
+    return 0;
+}